@@ -26,6 +26,24 @@ struct entry {
     }
 };
 
+/** Executable or shared library mapped into the process. */
+struct loaded_module {
+    /** Default constructor that clears all fields. */
+    loaded_module () : base(0), begin(0), end(0) {
+        name[0] = 0;
+    }
+
+    char name[64];           ///< file name without directory
+    unsigned long long base; ///< address that offsets into the module's symbols are relative to
+    unsigned long long begin; ///< first mapped address
+    unsigned long long end;  ///< one past the last mapped address
+};
+
+/** Lists the modules currently loaded into the process.
+ \param out - receives up to max_count modules
+ \return number of modules written to out */
+size_t loaded_modules (loaded_module* out, size_t max_count);
+
 /** Stack-trace base class, for retrieving the current call-stack. */
 class call_stack {
 public:
@@ -10,7 +10,15 @@
 #include <cxxabi.h>
 #include <dlfcn.h>
 #include <stdlib.h>
+#include <string.h>
 #include "call_stack.hpp"
+#if defined(__APPLE__)
+#include <mach-o/dyld.h>
+#include <mach-o/loader.h>
+#else
+#include <link.h>
+#include <unistd.h>
+#endif
 
 #define MAX_DEPTH 32
 
@@ -57,6 +65,109 @@ call_stack::~call_stack () throw() {
     // automatic cleanup
 }
 
+static const char * base_name (const char * path) {
+    const char * slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+#if defined(__APPLE__)
+size_t loaded_modules (loaded_module* out, size_t max_count) {
+    size_t count = 0;
+    uint32_t image_count = _dyld_image_count();
+    for (uint32_t i = 0; i < image_count && count < max_count; i++) {
+        const struct mach_header * header = _dyld_get_image_header(i);
+        const char * path = _dyld_get_image_name(i);
+        if (!header || !path)
+            continue;
+
+        unsigned long long slide = static_cast<unsigned long long>(_dyld_get_image_vmaddr_slide(i));
+        unsigned long long low = ~0ULL, high = 0;
+        bool is64 = header->magic == MH_MAGIC_64;
+        const char * command = reinterpret_cast<const char *>(header) + (is64 ? sizeof(struct mach_header_64) : sizeof(struct mach_header));
+        for (uint32_t c = 0; c < header->ncmds; c++) {
+            const struct load_command * lc = reinterpret_cast<const struct load_command *>(command);
+            unsigned long long vmaddr = 0, vmsize = 0;
+            const char * segname = NULL;
+            if (lc->cmd == LC_SEGMENT_64) {
+                const struct segment_command_64 * seg = reinterpret_cast<const struct segment_command_64 *>(lc);
+                vmaddr = seg->vmaddr;
+                vmsize = seg->vmsize;
+                segname = seg->segname;
+            } else if (lc->cmd == LC_SEGMENT) {
+                const struct segment_command * seg = reinterpret_cast<const struct segment_command *>(lc);
+                vmaddr = seg->vmaddr;
+                vmsize = seg->vmsize;
+                segname = seg->segname;
+            }
+            if (segname && strcmp(segname, "__PAGEZERO") != 0 && vmsize > 0) {
+                if (vmaddr < low)
+                    low = vmaddr;
+                if (vmaddr + vmsize > high)
+                    high = vmaddr + vmsize;
+            }
+            command += lc->cmdsize;
+        }
+        if (high == 0)
+            continue;
+
+        loaded_module & m = out[count++];
+        snprintf(m.name, sizeof(m.name), "%s", base_name(path));
+        m.base = reinterpret_cast<unsigned long long>(header);
+        m.begin = low + slide;
+        m.end = high + slide;
+    }
+    return count;
+}
+#else
+struct module_list {
+    loaded_module * out;
+    size_t max_count;
+    size_t count;
+};
+
+static int add_module (struct dl_phdr_info * info, size_t /*size*/, void * data) {
+    module_list * list = static_cast<module_list *>(data);
+    if (list->count >= list->max_count)
+        return 1;
+
+    unsigned long long low = ~0ULL, high = 0;
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr) & phdr = info->dlpi_phdr[i];
+        if (phdr.p_type != PT_LOAD)
+            continue;
+        if (phdr.p_vaddr < low)
+            low = phdr.p_vaddr;
+        if (phdr.p_vaddr + phdr.p_memsz > high)
+            high = phdr.p_vaddr + phdr.p_memsz;
+    }
+    if (high == 0)
+        return 0;
+
+    // the main executable has no name here
+    const char * path = info->dlpi_name;
+    char exe[513] = "";
+    if (!path || !path[0]) {
+        ssize_t length = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+        if (length > 0)
+            exe[length] = 0;
+        path = exe;
+    }
+
+    loaded_module & m = list->out[list->count++];
+    snprintf(m.name, sizeof(m.name), "%s", base_name(path));
+    m.base = info->dlpi_addr;
+    m.begin = info->dlpi_addr + low;
+    m.end = info->dlpi_addr + high;
+    return 0;
+}
+
+size_t loaded_modules (loaded_module* out, size_t max_count) {
+    module_list list = { out, max_count, 0 };
+    dl_iterate_phdr(add_module, &list);
+    return list.count;
+}
+#endif
+
 } // namespace stacktrace
 
 #endif // __GNUC__
@@ -6,6 +6,9 @@
 
 #include "call_stack.hpp"
 #include "StackWalker.h"
+#include <windows.h>
+#include <tlhelp32.h>
+#include <stdio.h>
 
 
 /** Adapter class to interfaces with the StackWalker project.
@@ -67,6 +70,27 @@ call_stack::~call_stack () throw() {
     // automatic cleanup
 }
 
+size_t loaded_modules (loaded_module* out, size_t max_count) {
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE, GetCurrentProcessId());
+    if (snapshot == INVALID_HANDLE_VALUE)
+        return 0;
+
+    size_t count = 0;
+    MODULEENTRY32W entry;
+    entry.dwSize = sizeof(entry);
+    for (BOOL found = Module32FirstW(snapshot, &entry); found && count < max_count; found = Module32NextW(snapshot, &entry)) {
+        loaded_module & m = out[count++];
+        if (WideCharToMultiByte(CP_UTF8, 0, entry.szModule, -1, m.name, sizeof(m.name), NULL, NULL) == 0)
+            m.name[0] = 0;
+        // offsets are relative virtual addresses
+        m.base = reinterpret_cast<unsigned long long>(entry.modBaseAddr);
+        m.begin = m.base;
+        m.end = m.base + entry.modBaseSize;
+    }
+    CloseHandle(snapshot);
+    return count;
+}
+
 } // namespace stacktrace
 
 #endif // _WIN32
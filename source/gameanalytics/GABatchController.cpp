@@ -0,0 +1,92 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GABatchController.h"
+#include <algorithm>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        const int GABatchController::MinBatchSize = 10;
+        const int GABatchController::MaxBatchSize = 500;
+        const int GABatchController::InitialBatchSize = 100;
+        const int GABatchController::BatchSizeIncrease = 25;
+        const size_t GABatchController::TargetPayloadBytes = 64 * 1024;
+        const double GABatchController::TargetRoundTripSeconds = 2.0;
+        const double GABatchController::MinIntervalSeconds = 1.0;
+        const double GABatchController::DefaultIntervalSeconds = 8.0;
+
+        // weight of a new sample in the moving averages
+        static const double SampleWeight = 0.25;
+
+        GABatchController::GABatchController():
+            _batchSize(InitialBatchSize),
+            _bytesPerEvent(0),
+            _roundTripSeconds(0),
+            _failureRate(0)
+        {
+        }
+
+        int GABatchController::batchSize() const
+        {
+            double size = _batchSize;
+            if(_bytesPerEvent > 0)
+            {
+                size = std::min(size, TargetPayloadBytes / _bytesPerEvent);
+            }
+            return std::max(MinBatchSize, std::min(MaxBatchSize, static_cast<int>(size)));
+        }
+
+        double GABatchController::sendInterval(size_t backlog) const
+        {
+            // more than a batch is waiting, drain it
+            if(backlog >= static_cast<size_t>(batchSize()))
+            {
+                return MinIntervalSeconds;
+            }
+
+            // small batches are cheap on a fast link
+            if(backlog > 0 && _roundTripSeconds > 0 && _roundTripSeconds <= TargetRoundTripSeconds / 4)
+            {
+                return DefaultIntervalSeconds / 2;
+            }
+
+            return DefaultIntervalSeconds;
+        }
+
+        void GABatchController::onBatchSent(size_t eventCount, size_t payloadBytes, double roundTripSeconds, bool delivered)
+        {
+            if(!delivered)
+            {
+                _failureRate += SampleWeight * (1 - _failureRate);
+                _batchSize = std::max<double>(MinBatchSize, _batchSize / 2);
+                return;
+            }
+
+            _failureRate -= SampleWeight * _failureRate;
+
+            if(eventCount > 0 && payloadBytes > 0)
+            {
+                double bytesPerEvent = static_cast<double>(payloadBytes) / eventCount;
+                _bytesPerEvent = _bytesPerEvent > 0 ? _bytesPerEvent + SampleWeight * (bytesPerEvent - _bytesPerEvent) : bytesPerEvent;
+            }
+            if(roundTripSeconds > 0)
+            {
+                _roundTripSeconds = _roundTripSeconds > 0 ? _roundTripSeconds + SampleWeight * (roundTripSeconds - _roundTripSeconds) : roundTripSeconds;
+            }
+
+            if(roundTripSeconds > TargetRoundTripSeconds)
+            {
+                _batchSize = std::max<double>(MinBatchSize, _batchSize / 2);
+            }
+            else if(eventCount >= static_cast<size_t>(batchSize()))
+            {
+                // only grow when the batch was actually limited by its size
+                _batchSize = std::min<double>(MaxBatchSize, _batchSize + BatchSizeIncrease);
+            }
+        }
+    }
+}
@@ -0,0 +1,53 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        // Picks the size of the next event batch and the delay until the next
+        // send. The batch grows additively while posts come back fast and is
+        // halved on failures or slow round trips (AIMD). It is also capped so
+        // the compressed payload stays near TargetPayloadBytes. Retries after
+        // failures are spaced out by GACircuitBreaker.
+        class GABatchController
+        {
+        public:
+            static const int MinBatchSize;
+            static const int MaxBatchSize;
+            static const int InitialBatchSize;
+            static const int BatchSizeIncrease;
+            static const size_t TargetPayloadBytes;
+            static const double TargetRoundTripSeconds;
+            static const double MinIntervalSeconds;
+            static const double DefaultIntervalSeconds;
+
+            GABatchController();
+
+            // number of events to claim for the next batch
+            int batchSize() const;
+            // seconds until the next send given the number of events waiting
+            double sendInterval(size_t backlog) const;
+
+            // payloadBytes is the size of the body that was posted, delivered is
+            // false when the collector could not be reached or failed
+            void onBatchSent(size_t eventCount, size_t payloadBytes, double roundTripSeconds, bool delivered);
+
+            double failureRate() const { return _failureRate; }
+            double roundTripSeconds() const { return _roundTripSeconds; }
+
+        private:
+            double _batchSize;
+            // moving averages, zero until the first batch was delivered
+            double _bytesPerEvent;
+            double _roundTripSeconds;
+            double _failureRate;
+        };
+    }
+}
@@ -0,0 +1,444 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GACharacterClass.h"
+
+#if !NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GA_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#define GA_SIMD_AVX2 1
+#include <immintrin.h>
+#include <intrin.h>
+#define GA_TARGET_AVX2
+#elif (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || defined(__clang__)
+#define GA_SIMD_AVX2 1
+#include <immintrin.h>
+#define GA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define GA_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        namespace
+        {
+            constexpr bool isUpper(unsigned c) { return c >= 'A' && c <= 'Z'; }
+            constexpr bool isLower(unsigned c) { return c >= 'a' && c <= 'z'; }
+            constexpr bool isDigit(unsigned c) { return c >= '0' && c <= '9'; }
+            constexpr bool isAlpha(unsigned c) { return isUpper(c) || isLower(c); }
+            // \s as std::regex (ECMAScript, classic locale) defines it
+            constexpr bool isSpace(unsigned c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+            constexpr bool isEventPart(unsigned c)
+            {
+                return isAlpha(c) || isDigit(c) || isSpace(c) || c == '-' || c == '_' || c == '.' || c == '(' || c == ')' || c == '!' || c == '?';
+            }
+
+            constexpr uint8_t classify(unsigned c)
+            {
+                return static_cast<uint8_t>(
+                    (isEventPart(c) ? EventPartCharacter : 0) |
+                    (((c >= 'A' && c <= 'z') || isDigit(c)) ? KeyCharacter : 0) |
+                    (isUpper(c) ? UppercaseCharacter : 0) |
+                    (isAlpha(c) ? AlphaCharacter : 0) |
+                    ((isAlpha(c) || isDigit(c) || c == '_') ? FieldKeyCharacter : 0));
+            }
+
+            const int MaxClassBits = 8;
+            const int MaxClassRanges = 16;
+
+            // A character class expressed as byte ranges (for SSE2/NEON) and
+            // as a nibble lookup table (for AVX2). Only single-bit classes
+            // get tables; anything else is scanned with the scalar loop.
+            struct ClassTables
+            {
+                int rangeCount;
+                // each range bound repeated 16 times so it loads straight into a register
+                uint8_t rangeLow[MaxClassRanges][16];
+                uint8_t rangeSize[MaxClassRanges][16];
+                // bit (1 << high nibble) is set if (high nibble, low nibble) is in the class
+                uint8_t nibbleLow[16];
+            };
+
+            struct Scan
+            {
+                size_t minSegmentLength;
+                size_t maxSegmentLength;
+                size_t maxSegments;
+                size_t segments;
+                size_t segmentLength;
+            };
+
+            inline unsigned countTrailingZeros(uint32_t v)
+            {
+#if defined(_MSC_VER)
+                unsigned long index;
+                _BitScanForward(&index, v);
+                return static_cast<unsigned>(index);
+#else
+                return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+            }
+
+            // returns false as soon as the input can no longer match
+            inline bool scanByte(Scan& scan, unsigned char c, int characterClass)
+            {
+                if(c == ':')
+                {
+                    if(scan.segmentLength < scan.minSegmentLength || ++scan.segments > scan.maxSegments)
+                    {
+                        return false;
+                    }
+                    scan.segmentLength = 0;
+                    return true;
+                }
+                return ++scan.segmentLength <= scan.maxSegmentLength && (characterClass == 0 || GACharacterClass::isInClass(c, characterClass));
+            }
+
+            bool scanScalar(const unsigned char* p, int characterClass, Scan& scan)
+            {
+                // work on a local copy; writes through scan could alias p
+                Scan local = scan;
+                for(; *p; ++p)
+                {
+                    if(!scanByte(local, *p, characterClass))
+                    {
+                        return false;
+                    }
+                }
+                return local.segmentLength >= local.minSegmentLength;
+            }
+
+            // Scans one block given the masks of terminator, ':' and in-class
+            // bytes. Returns false on mismatch; sets done when the terminator
+            // was inside the block.
+            inline bool scanBlock(Scan& scan, unsigned width, uint32_t zero, uint32_t colon, uint32_t valid, bool& done)
+            {
+                uint32_t full = width >= 32 ? 0xFFFFFFFFu : ((1u << width) - 1);
+                uint32_t live = zero ? ((zero & (0u - zero)) - 1) : full;
+
+                if(~(valid | colon) & live)
+                {
+                    return false;
+                }
+
+                colon &= live;
+                unsigned position = 0;
+                while(colon)
+                {
+                    unsigned index = countTrailingZeros(colon);
+                    scan.segmentLength += index - position;
+                    if(scan.segmentLength < scan.minSegmentLength || scan.segmentLength > scan.maxSegmentLength || ++scan.segments > scan.maxSegments)
+                    {
+                        return false;
+                    }
+                    scan.segmentLength = 0;
+                    position = index + 1;
+                    colon &= colon - 1;
+                }
+
+                unsigned end = zero ? countTrailingZeros(zero) : width;
+                scan.segmentLength += end - position;
+                done = zero != 0;
+                return scan.segmentLength <= scan.maxSegmentLength;
+            }
+
+            // Blocks are loaded from aligned addresses so reading past the
+            // terminator never crosses into an unmapped page. The bytes in
+            // front of the string in the first block are shifted out.
+            template <typename Kernel>
+            bool scanVector(const unsigned char* p, const ClassTables* tables, Scan& scan)
+            {
+                unsigned offset = static_cast<unsigned>(reinterpret_cast<uintptr_t>(p) % Kernel::Width);
+                p -= offset;
+
+                bool done = false;
+                for(; !done; p += Kernel::Width)
+                {
+                    uint32_t zero;
+                    uint32_t colon;
+                    uint32_t valid;
+                    Kernel::classify(p, tables, zero, colon, valid);
+                    if(!scanBlock(scan, Kernel::Width - offset, zero >> offset, colon >> offset, valid >> offset, done))
+                    {
+                        return false;
+                    }
+                    offset = 0;
+                }
+                return scan.segmentLength >= scan.minSegmentLength;
+            }
+
+#if GA_SIMD_SSE2
+            struct KernelSSE2
+            {
+                static const unsigned Width = 16;
+
+                static void classify(const unsigned char* p, const ClassTables* tables, uint32_t& zero, uint32_t& colon, uint32_t& valid)
+                {
+                    __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+                    __m128i zeroes = _mm_setzero_si128();
+                    zero = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zeroes)));
+                    colon = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(':'))));
+                    if(!tables)
+                    {
+                        valid = 0xFFFF;
+                        return;
+                    }
+
+                    // c is in [low, low + size] if saturate(c - low - size) == 0 with c - low wrapping
+                    __m128i in = zeroes;
+                    const int rangeCount = tables->rangeCount;
+                    for(int i = 0; i < rangeCount; ++i)
+                    {
+                        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables->rangeLow[i]));
+                        __m128i size = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables->rangeSize[i]));
+                        __m128i over = _mm_subs_epu8(_mm_sub_epi8(v, low), size);
+                        in = _mm_or_si128(in, _mm_cmpeq_epi8(over, zeroes));
+                    }
+                    valid = static_cast<uint32_t>(_mm_movemask_epi8(in));
+                }
+            };
+#endif
+
+#if GA_SIMD_AVX2
+            struct KernelAVX2
+            {
+                static const unsigned Width = 32;
+
+                GA_TARGET_AVX2 static void classify(const unsigned char* p, const ClassTables* tables, uint32_t& zero, uint32_t& colon, uint32_t& valid)
+                {
+                    __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(p));
+                    __m256i zeroes = _mm256_setzero_si256();
+                    zero = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zeroes)));
+                    colon = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':'))));
+                    if(!tables)
+                    {
+                        valid = 0xFFFFFFFFu;
+                        return;
+                    }
+
+                    // high nibbles 8-15 map to 0 so non-ASCII bytes are never in a class
+                    const __m256i highBits = _mm256_setr_epi8(
+                        1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+                        1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+                    __m128i low128 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables->nibbleLow));
+                    __m256i lowTable = _mm256_inserti128_si256(_mm256_castsi128_si256(low128), low128, 1);
+                    __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+                    __m256i lowBits = _mm256_shuffle_epi8(lowTable, _mm256_and_si256(v, nibbleMask));
+                    __m256i high = _mm256_shuffle_epi8(highBits, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibbleMask));
+                    __m256i out = _mm256_cmpeq_epi8(_mm256_and_si256(lowBits, high), zeroes);
+                    valid = ~static_cast<uint32_t>(_mm256_movemask_epi8(out));
+                }
+            };
+
+            bool cpuSupportsAVX2()
+            {
+#if defined(_MSC_VER)
+                int info[4];
+                __cpuid(info, 0);
+                if(info[0] < 7)
+                {
+                    return false;
+                }
+                __cpuid(info, 1);
+                bool osxsave = (info[2] & (1 << 27)) != 0;
+                bool avx = (info[2] & (1 << 28)) != 0;
+                if(!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+                {
+                    return false;
+                }
+                __cpuidex(info, 7, 0);
+                return (info[1] & (1 << 5)) != 0;
+#else
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2") != 0;
+#endif
+            }
+#endif
+
+#if GA_SIMD_NEON
+            struct KernelNEON
+            {
+                static const unsigned Width = 16;
+
+                static uint32_t movemask(uint8x16_t v)
+                {
+                    const uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+                    uint8x16_t masked = vandq_u8(v, vld1q_u8(weights));
+                    uint8x8_t sum = vpadd_u8(vget_low_u8(masked), vget_high_u8(masked));
+                    sum = vpadd_u8(sum, sum);
+                    sum = vpadd_u8(sum, sum);
+                    return static_cast<uint32_t>(vget_lane_u8(sum, 0)) | (static_cast<uint32_t>(vget_lane_u8(sum, 1)) << 8);
+                }
+
+                static void classify(const unsigned char* p, const ClassTables* tables, uint32_t& zero, uint32_t& colon, uint32_t& valid)
+                {
+                    uint8x16_t v = vld1q_u8(p);
+                    zero = movemask(vceqq_u8(v, vdupq_n_u8(0)));
+                    colon = movemask(vceqq_u8(v, vdupq_n_u8(':')));
+                    if(!tables)
+                    {
+                        valid = 0xFFFF;
+                        return;
+                    }
+
+                    uint8x16_t in = vdupq_n_u8(0);
+                    const int rangeCount = tables->rangeCount;
+                    for(int i = 0; i < rangeCount; ++i)
+                    {
+                        uint8x16_t shifted = vsubq_u8(v, vld1q_u8(tables->rangeLow[i]));
+                        in = vorrq_u8(in, vcleq_u8(shifted, vld1q_u8(tables->rangeSize[i])));
+                    }
+                    valid = movemask(in);
+                }
+            };
+#endif
+
+            typedef bool (*ScanFunction)(const unsigned char* p, const ClassTables* tables, Scan& scan);
+
+            ScanFunction scanFunction = nullptr;
+            const char* scanFunctionName = "scalar";
+            ClassTables classTables[MaxClassBits];
+            bool classTablesValid[MaxClassBits];
+
+            void buildClassTables(int bit, const uint8_t* table)
+            {
+                ClassTables& t = classTables[bit];
+                t.rangeCount = 0;
+                classTablesValid[bit] = true;
+                for(int c = 0; c < 16; ++c)
+                {
+                    t.nibbleLow[c] = 0;
+                }
+
+                int c = 0;
+                while(c < 256)
+                {
+                    if(!(table[c] & (1 << bit)))
+                    {
+                        ++c;
+                        continue;
+                    }
+                    if(c >= 128 || t.rangeCount == MaxClassRanges)
+                    {
+                        classTablesValid[bit] = false;
+                        return;
+                    }
+                    int start = c;
+                    while(c < 128 && (table[c] & (1 << bit)))
+                    {
+                        t.nibbleLow[c & 0x0F] |= static_cast<uint8_t>(1 << (c >> 4));
+                        ++c;
+                    }
+                    for(int i = 0; i < 16; ++i)
+                    {
+                        t.rangeLow[t.rangeCount][i] = static_cast<uint8_t>(start);
+                        t.rangeSize[t.rangeCount][i] = static_cast<uint8_t>(c - 1 - start);
+                    }
+                    ++t.rangeCount;
+                }
+            }
+        }
+
+#define GA_CLASSIFY_4(n) classify(n), classify(n + 1), classify(n + 2), classify(n + 3)
+#define GA_CLASSIFY_16(n) GA_CLASSIFY_4(n), GA_CLASSIFY_4(n + 4), GA_CLASSIFY_4(n + 8), GA_CLASSIFY_4(n + 12)
+#define GA_CLASSIFY_64(n) GA_CLASSIFY_16(n), GA_CLASSIFY_16(n + 16), GA_CLASSIFY_16(n + 32), GA_CLASSIFY_16(n + 48)
+
+        const uint8_t GACharacterClass::table[256] =
+        {
+            GA_CLASSIFY_64(0), GA_CLASSIFY_64(64), GA_CLASSIFY_64(128), GA_CLASSIFY_64(192)
+        };
+
+#undef GA_CLASSIFY_64
+#undef GA_CLASSIFY_16
+#undef GA_CLASSIFY_4
+
+        // Picked during static initialization so the hot path needs no
+        // synchronisation. Scans issued before this runs use the scalar loop.
+        const bool GACharacterClass::dispatchInitialized = GACharacterClass::initDispatch();
+
+        bool GACharacterClass::initDispatch()
+        {
+            for(int bit = 0; bit < MaxClassBits; ++bit)
+            {
+                buildClassTables(bit, table);
+            }
+
+#if GA_SIMD_AVX2
+            if(cpuSupportsAVX2())
+            {
+                scanFunction = &scanVector<KernelAVX2>;
+                scanFunctionName = "avx2";
+                return true;
+            }
+#endif
+#if GA_SIMD_SSE2
+            scanFunction = &scanVector<KernelSSE2>;
+            scanFunctionName = "sse2";
+#elif GA_SIMD_NEON
+            scanFunction = &scanVector<KernelNEON>;
+            scanFunctionName = "neon";
+#endif
+            return true;
+        }
+
+        const char* GACharacterClass::implementationName()
+        {
+            return scanFunctionName;
+        }
+
+        bool GACharacterClass::scan(const char* s, int characterClass, size_t minSegmentLength, size_t maxSegmentLength, size_t maxSegments)
+        {
+            if(!s)
+            {
+                return false;
+            }
+
+            Scan state = { minSegmentLength, maxSegmentLength, maxSegments, 1, 0 };
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+
+            if(scanFunction)
+            {
+                // vector kernels handle "any character" and single-bit classes
+                if(characterClass == 0)
+                {
+                    return scanFunction(p, nullptr, state);
+                }
+                if((characterClass & (characterClass - 1)) == 0)
+                {
+                    int bit = countTrailingZeros(static_cast<uint32_t>(characterClass));
+                    if(bit < MaxClassBits && classTablesValid[bit])
+                    {
+                        return scanFunction(p, &classTables[bit], state);
+                    }
+                }
+            }
+            return scanScalar(p, characterClass, state);
+        }
+
+        bool GACharacterClass::matchesClass(const char* s, int characterClass, size_t minLength, size_t maxLength)
+        {
+            // ':' is in none of the classes, so a single segment is the whole string
+            return scan(s, characterClass, minLength, maxLength, 1);
+        }
+
+        bool GACharacterClass::matchesSegments(const char* s, int characterClass, size_t maxSegmentLength, size_t maxSegments)
+        {
+            return scan(s, characterClass, 1, maxSegmentLength, maxSegments);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        // Character classes used by the validators. Each class is one bit in
+        // the lookup table so a byte can be checked against a class with a
+        // single load and mask instead of compiling a regular expression.
+        enum EGACharacterClass
+        {
+            // [A-Za-z0-9\s\-_\.\(\)\!\?]
+            EventPartCharacter = 1 << 0,
+            // [A-z0-9] (note: A-z also includes [\]^_`)
+            KeyCharacter = 1 << 1,
+            // [A-Z]
+            UppercaseCharacter = 1 << 2,
+            // [A-Za-z]
+            AlphaCharacter = 1 << 3,
+            // [a-zA-Z0-9_]
+            FieldKeyCharacter = 1 << 4
+        };
+
+        class GACharacterClass
+        {
+        public:
+            static bool isInClass(unsigned char c, int characterClass)
+            {
+                return (table[c] & characterClass) != 0;
+            }
+
+            // true if the string length is in [minLength, maxLength] and every
+            // character belongs to characterClass
+            static bool matchesClass(const char* s, int characterClass, size_t minLength, size_t maxLength);
+
+            // true if the string is 1 to maxSegments segments separated by ':',
+            // each segment 1 to maxSegmentLength characters long. If
+            // characterClass is 0 any character except ':' is accepted.
+            static bool matchesSegments(const char* s, int characterClass, size_t maxSegmentLength, size_t maxSegments);
+
+            // "avx2", "sse2", "neon" or "scalar", picked once at runtime.
+            // Define NO_SIMD to always use the scalar loop.
+            static const char* implementationName();
+
+        private:
+            static const uint8_t table[256];
+
+            static const bool dispatchInitialized;
+            static bool initDispatch();
+            static bool scan(const char* s, int characterClass, size_t minSegmentLength, size_t maxSegmentLength, size_t maxSegments);
+        };
+    }
+}
@@ -0,0 +1,109 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GACircuitBreaker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        const int GACircuitBreaker::FailureThreshold = 5;
+        const int GACircuitBreaker::ProbeBatchSize = 5;
+        const double GACircuitBreaker::BaseBackoffSeconds = 2.0;
+        const double GACircuitBreaker::MaxBackoffSeconds = 300.0;
+        const double GACircuitBreaker::MinOpenSeconds = 5.0;
+
+        GACircuitBreaker::GACircuitBreaker():
+            GACircuitBreaker(std::random_device()())
+        {
+        }
+
+        GACircuitBreaker::GACircuitBreaker(uint32_t seed):
+            _state(CircuitClosed),
+            _consecutiveFailures(0),
+            _timesOpened(0),
+            _retryAt(0),
+            _probeInFlight(false),
+            _random(seed)
+        {
+        }
+
+        bool GACircuitBreaker::allowSend(double now)
+        {
+            if(now < _retryAt)
+            {
+                return false;
+            }
+
+            switch(_state)
+            {
+                case CircuitOpen:
+                    _state = CircuitHalfOpen;
+                    _probeInFlight = true;
+                    return true;
+                case CircuitHalfOpen:
+                    if(_probeInFlight)
+                    {
+                        return false;
+                    }
+                    _probeInFlight = true;
+                    return true;
+                default:
+                    return true;
+            }
+        }
+
+        double GACircuitBreaker::retryDelay(double now) const
+        {
+            return std::max(0.0, _retryAt - now);
+        }
+
+        int GACircuitBreaker::maxBatchSize(int batchSize) const
+        {
+            return _state == CircuitClosed ? batchSize : std::min(batchSize, ProbeBatchSize);
+        }
+
+        void GACircuitBreaker::onSuccess()
+        {
+            _state = CircuitClosed;
+            _consecutiveFailures = 0;
+            _retryAt = 0;
+            _probeInFlight = false;
+        }
+
+        void GACircuitBreaker::onFailure(double now)
+        {
+            _consecutiveFailures++;
+            _probeInFlight = false;
+
+            if(_state == CircuitClosed && _consecutiveFailures < FailureThreshold)
+            {
+                _retryAt = now + backoff();
+                return;
+            }
+
+            if(_state == CircuitClosed)
+            {
+                _timesOpened++;
+            }
+            _state = CircuitOpen;
+            _retryAt = now + std::max(MinOpenSeconds, backoff());
+        }
+
+        void GACircuitBreaker::cancelProbe()
+        {
+            _probeInFlight = false;
+        }
+
+        double GACircuitBreaker::backoff()
+        {
+            double cap = std::min(MaxBackoffSeconds, BaseBackoffSeconds * std::pow(2.0, std::min(_consecutiveFailures - 1, 16)));
+            std::uniform_real_distribution<double> distribution(0, cap);
+            return distribution(_random);
+        }
+    }
+}
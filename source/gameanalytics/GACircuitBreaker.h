@@ -0,0 +1,61 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics.h"
+#include <random>
+#include <cstdint>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        // Spaces out retries while the collector fails. Every failure waits a
+        // random time up to an exponentially growing cap (full jitter), so
+        // clients that lost the collector together do not come back together.
+        // After FailureThreshold failures in a row the circuit opens and
+        // nothing is sent until the wait is over, then a single small probe
+        // batch decides whether to close it again.
+        class GACircuitBreaker
+        {
+        public:
+            static const int FailureThreshold;
+            static const int ProbeBatchSize;
+            static const double BaseBackoffSeconds;
+            static const double MaxBackoffSeconds;
+            static const double MinOpenSeconds;
+
+            GACircuitBreaker();
+            explicit GACircuitBreaker(uint32_t seed);
+
+            // times are seconds from any monotonic clock
+            bool allowSend(double now);
+            // seconds until allowSend can return true, 0 if it already does
+            double retryDelay(double now) const;
+            // largest batch allowed now, the half-open probe is kept small
+            int maxBatchSize(int batchSize) const;
+
+            void onSuccess();
+            void onFailure(double now);
+            // the probe allowed by allowSend found nothing to send
+            void cancelProbe();
+
+            EGACircuitState state() const { return _state; }
+            int consecutiveFailures() const { return _consecutiveFailures; }
+            uint32_t timesOpened() const { return _timesOpened; }
+
+        private:
+            double backoff();
+
+            EGACircuitState _state;
+            int _consecutiveFailures;
+            uint32_t _timesOpened;
+            double _retryAt;
+            bool _probeInFlight;
+            std::mt19937 _random;
+        };
+    }
+}
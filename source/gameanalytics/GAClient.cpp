@@ -0,0 +1,107 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAClient.h"
+#include "GAState.h"
+#include "GAStore.h"
+#include "GAEvents.h"
+#include "GAEventSampler.h"
+#include "GAEventAggregator.h"
+#include <set>
+
+namespace gameanalytics
+{
+    namespace client
+    {
+        thread_local GAClientContext* GAClientContext::_current = NULL;
+
+        // game keys in use by an instance, the default instance never gives its key back
+        static std::mutex gameKeysMtx;
+        static std::set<std::string> gameKeys;
+
+        GAClientContext::GAClientContext():
+            _state(new state::GAState()),
+            _store(new store::GAStore()),
+            _events(new events::GAEvents()),
+            _sampler(new events::GAEventSampler()),
+            _aggregator(new events::GAEventAggregator())
+        {
+        }
+
+        GAClientContext::~GAClientContext()
+        {
+            // the state joins its init thread, which may still use the other parts
+            delete _state;
+            delete _aggregator;
+            delete _sampler;
+            delete _events;
+            delete _store;
+
+            if(!_gameKey.empty())
+            {
+                std::lock_guard<std::mutex> lock(gameKeysMtx);
+                gameKeys.erase(_gameKey);
+            }
+        }
+
+        GAClientContext* GAClientContext::current()
+        {
+            return _current;
+        }
+
+        std::function<void()> GAClientContext::bind(const std::function<void()>& block)
+        {
+            if(!_current)
+            {
+                return block;
+            }
+
+            // keeps the client alive until the block has run
+            std::shared_ptr<GAClientContext> client = _current->shared_from_this();
+            return [client, block]()
+            {
+                GAClientScope scope(client.get());
+                block();
+            };
+        }
+
+        bool GAClientContext::claimGameKey(const char* gameKey)
+        {
+            std::lock_guard<std::mutex> lock(gameKeysMtx);
+            if(!gameKeys.insert(gameKey).second)
+            {
+                return false;
+            }
+            if(_current)
+            {
+                _current->_gameKey = gameKey;
+            }
+            return true;
+        }
+
+        void GAClientContext::setTransport(const std::shared_ptr<ITransport>& transport)
+        {
+            std::lock_guard<std::mutex> lock(_transportMtx);
+            _transport = transport;
+        }
+
+        std::shared_ptr<ITransport> GAClientContext::getTransport()
+        {
+            std::lock_guard<std::mutex> lock(_transportMtx);
+            return _transport;
+        }
+
+        GAClientScope::GAClientScope(GAClientContext* client):
+            _previous(GAClientContext::_current)
+        {
+            GAClientContext::_current = client;
+        }
+
+        GAClientScope::~GAClientScope()
+        {
+            GAClientContext::_current = _previous;
+        }
+    }
+}
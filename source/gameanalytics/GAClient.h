@@ -0,0 +1,94 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        class GAState;
+    }
+
+    namespace store
+    {
+        class GAStore;
+    }
+
+    namespace events
+    {
+        class GAEvents;
+        class GAEventSampler;
+        class GAEventAggregator;
+    }
+
+    namespace client
+    {
+        // The per game parts of a GameAnalyticsClient: state, store, event queue,
+        // sampling rules, aggregation windows and transport. While a GAClientScope
+        // is active on a thread the singletons hand out these instances instead of
+        // their own. The GA thread, logging, device info and curl connections are
+        // shared by all clients.
+        class GAClientContext : public std::enable_shared_from_this<GAClientContext>
+        {
+        public:
+            GAClientContext();
+            ~GAClientContext();
+
+            // null on threads working for the default instance
+            static GAClientContext* current();
+            // the block runs with the calling thread's client, returned as is for the default instance
+            static std::function<void()> bind(const std::function<void()>& block);
+            // a game key can only be used by one instance at a time, they would share the store file
+            static bool claimGameKey(const char* gameKey);
+
+            state::GAState* getState() const { return _state; }
+            store::GAStore* getStore() const { return _store; }
+            events::GAEvents* getEvents() const { return _events; }
+            events::GAEventSampler* getSampler() const { return _sampler; }
+            events::GAEventAggregator* getAggregator() const { return _aggregator; }
+
+            void setTransport(const std::shared_ptr<ITransport>& transport);
+            std::shared_ptr<ITransport> getTransport();
+
+        private:
+            GAClientContext(const GAClientContext&) = delete;
+            GAClientContext& operator=(const GAClientContext&) = delete;
+
+            state::GAState* _state;
+            store::GAStore* _store;
+            events::GAEvents* _events;
+            events::GAEventSampler* _sampler;
+            events::GAEventAggregator* _aggregator;
+
+            std::shared_ptr<ITransport> _transport;
+            std::mutex _transportMtx;
+            std::string _gameKey;
+
+            static thread_local GAClientContext* _current;
+            friend class GAClientScope;
+        };
+
+        // makes client the current one on the calling thread while in scope
+        class GAClientScope
+        {
+        public:
+            explicit GAClientScope(GAClientContext* client);
+            ~GAClientScope();
+
+        private:
+            GAClientScope(const GAClientScope&) = delete;
+            GAClientScope& operator=(const GAClientScope&) = delete;
+
+            GAClientContext* _previous;
+        };
+    }
+}
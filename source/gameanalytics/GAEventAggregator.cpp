@@ -0,0 +1,222 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAEventAggregator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        // 16 histogram buckets, the summary stays well below the custom field limit
+        const size_t GAEventAggregator::MaxHistogramBounds = 15;
+        const int64_t GAEventAggregator::MaxWindowSeconds = 3600;
+        const size_t GAEventAggregator::MaxPendingWindows = 1024;
+
+        bool GAEventAggregator::_destroyed = false;
+        GAEventAggregator* GAEventAggregator::_instance = 0;
+        std::once_flag GAEventAggregator::_initInstanceFlag;
+
+        GAEventAggregator::GAEventAggregator()
+        {
+        }
+
+        GAEventAggregator::~GAEventAggregator()
+        {
+        }
+
+        void GAEventAggregator::cleanUp()
+        {
+            delete _instance;
+            _instance = 0;
+            _destroyed = true;
+        }
+
+        GAEventAggregator* GAEventAggregator::getInstance()
+        {
+            client::GAClientContext* client = client::GAClientContext::current();
+            if(client)
+            {
+                return client->getAggregator();
+            }
+            std::call_once(_initInstanceFlag, &GAEventAggregator::initInstance);
+            return _instance;
+        }
+
+        bool GAEventAggregator::configure(const char* eventId, int64_t windowSeconds, const std::vector<double>& bounds)
+        {
+            GAEventAggregator* i = getInstance();
+            if(!i || !eventId)
+            {
+                return false;
+            }
+
+            if(windowSeconds < 1 || windowSeconds > MaxWindowSeconds || bounds.size() > MaxHistogramBounds)
+            {
+                return false;
+            }
+            for(size_t b = 0; b < bounds.size(); ++b)
+            {
+                if(!std::isfinite(bounds[b]) || (b > 0 && bounds[b] <= bounds[b - 1]))
+                {
+                    return false;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            Configuration& configuration = i->_configurations[eventId];
+            configuration.windowSeconds = windowSeconds;
+            configuration.bounds = bounds;
+            return true;
+        }
+
+        void GAEventAggregator::remove(const char* eventId, std::vector<GAAggregatedDesignEvent>& out)
+        {
+            GAEventAggregator* i = getInstance();
+            if(!i || !eventId)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            i->_configurations.erase(eventId);
+
+            for(std::vector<GAAggregatedDesignEvent>::iterator itr = i->_closed.begin(); itr != i->_closed.end();)
+            {
+                if(itr->eventId == eventId)
+                {
+                    out.push_back(*itr);
+                    itr = i->_closed.erase(itr);
+                }
+                else
+                {
+                    ++itr;
+                }
+            }
+            for(std::map<std::string, GAAggregatedDesignEvent>::iterator itr = i->_pending.begin(); itr != i->_pending.end();)
+            {
+                if(itr->second.eventId == eventId)
+                {
+                    out.push_back(itr->second);
+                    itr = i->_pending.erase(itr);
+                }
+                else
+                {
+                    ++itr;
+                }
+            }
+        }
+
+        bool GAEventAggregator::isAggregated(const char* eventId)
+        {
+            GAEventAggregator* i = getInstance();
+            if(!i || !eventId)
+            {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            return i->_configurations.find(eventId) != i->_configurations.end();
+        }
+
+        bool GAEventAggregator::add(const char* eventId, const char* dimension01, const char* dimension02, const char* dimension03, double value, int64_t now)
+        {
+            GAEventAggregator* i = getInstance();
+            if(!i || !eventId || !std::isfinite(value))
+            {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            if(i->_configurations.empty())
+            {
+                return false;
+            }
+            std::map<std::string, Configuration>::const_iterator configuration = i->_configurations.find(eventId);
+            if(configuration == i->_configurations.end())
+            {
+                return false;
+            }
+
+            dimension01 = dimension01 ? dimension01 : "";
+            dimension02 = dimension02 ? dimension02 : "";
+            dimension03 = dimension03 ? dimension03 : "";
+            std::string key(eventId);
+            key.push_back('\0');
+            key.append(dimension01);
+            key.push_back('\0');
+            key.append(dimension02);
+            key.push_back('\0');
+            key.append(dimension03);
+
+            std::map<std::string, GAAggregatedDesignEvent>::iterator itr = i->_pending.find(key);
+            if(itr != i->_pending.end() && now >= itr->second.windowStart + itr->second.windowSeconds)
+            {
+                i->_closed.push_back(itr->second);
+                i->_pending.erase(itr);
+                itr = i->_pending.end();
+            }
+
+            if(itr == i->_pending.end())
+            {
+                if(i->_pending.size() + i->_closed.size() >= MaxPendingWindows)
+                {
+                    return false;
+                }
+
+                GAAggregatedDesignEvent aggregate;
+                aggregate.eventId = eventId;
+                aggregate.dimension01 = dimension01;
+                aggregate.dimension02 = dimension02;
+                aggregate.dimension03 = dimension03;
+                aggregate.windowStart = now;
+                aggregate.windowSeconds = configuration->second.windowSeconds;
+                aggregate.count = 0;
+                aggregate.sum = 0;
+                aggregate.min = value;
+                aggregate.max = value;
+                aggregate.bounds = configuration->second.bounds;
+                aggregate.histogram.assign(aggregate.bounds.size() + 1, 0);
+                itr = i->_pending.insert(std::make_pair(key, aggregate)).first;
+            }
+
+            GAAggregatedDesignEvent& aggregate = itr->second;
+            aggregate.count++;
+            aggregate.sum += value;
+            aggregate.min = std::min(aggregate.min, value);
+            aggregate.max = std::max(aggregate.max, value);
+            size_t bucket = std::lower_bound(aggregate.bounds.begin(), aggregate.bounds.end(), value) - aggregate.bounds.begin();
+            aggregate.histogram[bucket]++;
+            return true;
+        }
+
+        void GAEventAggregator::takeClosedWindows(int64_t now, bool all, std::vector<GAAggregatedDesignEvent>& out)
+        {
+            GAEventAggregator* i = getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            out.insert(out.end(), i->_closed.begin(), i->_closed.end());
+            i->_closed.clear();
+
+            for(std::map<std::string, GAAggregatedDesignEvent>::iterator itr = i->_pending.begin(); itr != i->_pending.end();)
+            {
+                if(all || now >= itr->second.windowStart + itr->second.windowSeconds)
+                {
+                    out.push_back(itr->second);
+                    itr = i->_pending.erase(itr);
+                }
+                else
+                {
+                    ++itr;
+                }
+            }
+        }
+    }
+}
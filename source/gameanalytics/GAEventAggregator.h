@@ -0,0 +1,99 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics.h"
+#include "GAClient.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <mutex>
+#include <cstdlib>
+#include <cstdint>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        // Summary of the design events with one event id and one set of
+        // custom dimensions over a single aggregation window
+        struct GAAggregatedDesignEvent
+        {
+            std::string eventId;
+            std::string dimension01;
+            std::string dimension02;
+            std::string dimension03;
+            int64_t windowStart;
+            int64_t windowSeconds;
+            uint32_t count;
+            double sum;
+            double min;
+            double max;
+            // histogram[i] counts values <= bounds[i], the last bucket counts the rest
+            std::vector<double> bounds;
+            std::vector<uint32_t> histogram;
+        };
+
+        class GAEventAggregator
+        {
+        public:
+            static const size_t MaxHistogramBounds;
+            static const int64_t MaxWindowSeconds;
+
+            // Aggregate design events with this event id. Returns false and
+            // leaves the current configuration untouched if the window or the
+            // bounds are invalid. Bounds must be ascending.
+            static bool configure(const char* eventId, int64_t windowSeconds, const std::vector<double>& bounds);
+            // Stop aggregating the event id, pending windows are moved to out
+            static void remove(const char* eventId, std::vector<GAAggregatedDesignEvent>& out);
+            static bool isAggregated(const char* eventId);
+
+            // Returns false if the event id is not aggregated or the key limit
+            // is reached, the caller then sends the event as usual
+            static bool add(const char* eventId, const char* dimension01, const char* dimension02, const char* dimension03, double value, int64_t now);
+
+            // Moves windows that closed before now to out, or every pending window if all is set
+            static void takeClosedWindows(int64_t now, bool all, std::vector<GAAggregatedDesignEvent>& out);
+
+        private:
+            GAEventAggregator();
+            ~GAEventAggregator();
+            GAEventAggregator(const GAEventAggregator&) = delete;
+            GAEventAggregator& operator=(const GAEventAggregator&) = delete;
+            friend class client::GAClientContext;
+
+            struct Configuration
+            {
+                int64_t windowSeconds;
+                std::vector<double> bounds;
+            };
+
+            static const size_t MaxPendingWindows;
+
+            std::mutex _mtx;
+            std::map<std::string, Configuration> _configurations;
+            // keyed by event id and dimensions separated by '\0'
+            std::map<std::string, GAAggregatedDesignEvent> _pending;
+            // windows that closed while adding, waiting for takeClosedWindows
+            std::vector<GAAggregatedDesignEvent> _closed;
+
+            static bool _destroyed;
+            static GAEventAggregator* _instance;
+            static std::once_flag _initInstanceFlag;
+            static void cleanUp();
+            static GAEventAggregator* getInstance();
+
+            static void initInstance()
+            {
+                if(!_destroyed && !_instance)
+                {
+                    _instance = new GAEventAggregator();
+                    std::atexit(&cleanUp);
+                }
+            }
+        };
+    }
+}
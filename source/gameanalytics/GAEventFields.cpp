@@ -0,0 +1,176 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GameAnalytics.h"
+#include "GACharacterClass.h"
+#include "GALogger.h"
+#include <string.h>
+#include <cmath>
+
+namespace gameanalytics
+{
+    const size_t EventFields::MaxCount;
+    const size_t EventFields::MaxKeyLength;
+    const size_t EventFields::MaxStringLength;
+    const size_t EventFields::InlineCount;
+    const size_t EventFields::InlineTextSize;
+
+    EventFields::EventFields():
+        _count(0),
+        _textSize(0)
+    {
+    }
+
+    EventFields& EventFields::add(const char* key, double value)
+    {
+        if(!validateKey(key))
+        {
+            return *this;
+        }
+
+        // NaN and infinity have no JSON representation
+        if(!std::isfinite(value))
+        {
+            logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s has been omitted because its value is not a finite number", key);
+            return *this;
+        }
+
+        addField(key, nullptr, 0, value, false);
+        return *this;
+    }
+
+    EventFields& EventFields::add(const char* key, const char* value)
+    {
+        if(!validateKey(key))
+        {
+            return *this;
+        }
+
+        if(!value)
+        {
+            logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s, value=null has been omitted because its key or value is null", key);
+            return *this;
+        }
+
+        size_t valueLength = strlen(value);
+        if(valueLength == 0 || valueLength > MaxStringLength)
+        {
+            logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s, value=%s has been omitted because its value is an empty string or exceeds the max number of characters (%d)", key, value, (int)MaxStringLength);
+            return *this;
+        }
+
+        addField(key, value, valueLength, 0, true);
+        return *this;
+    }
+
+    EventFields& EventFields::add(const char* key, const std::string& value)
+    {
+        return add(key, value.c_str());
+    }
+
+    size_t EventFields::size() const
+    {
+        return _count;
+    }
+
+    bool EventFields::empty() const
+    {
+        return _count == 0;
+    }
+
+    const char* EventFields::keyAt(size_t index) const
+    {
+        return text() + field(index).keyOffset;
+    }
+
+    bool EventFields::isStringAt(size_t index) const
+    {
+        return field(index).isString;
+    }
+
+    double EventFields::numberAt(size_t index) const
+    {
+        return field(index).number;
+    }
+
+    const char* EventFields::stringAt(size_t index) const
+    {
+        const Field& f = field(index);
+        return f.isString ? text() + f.stringOffset : "";
+    }
+
+    bool EventFields::validateKey(const char* key) const
+    {
+        if(!key || !utilities::GACharacterClass::matchesClass(key, utilities::FieldKeyCharacter, 1, MaxKeyLength))
+        {
+            logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s has been omitted because its key contains illegal character, is empty or exceeds the max number of characters (%d)", key ? key : "", (int)MaxKeyLength);
+            return false;
+        }
+        if(_count >= MaxCount)
+        {
+            logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s has been omitted because it exceeds the max number of custom fields (%d)", key, (int)MaxCount);
+            return false;
+        }
+        return true;
+    }
+
+    void EventFields::addField(const char* key, const char* value, size_t valueLength, double number, bool isString)
+    {
+        Field f;
+        f.keyOffset = appendText(key, strlen(key));
+        f.stringOffset = isString ? appendText(value, valueLength) : 0;
+        f.number = number;
+        f.isString = isString;
+
+        if(_count < InlineCount)
+        {
+            _inlineFields[_count] = f;
+        }
+        else
+        {
+            if(_count == InlineCount)
+            {
+                _fields.reserve(MaxCount);
+                _fields.assign(_inlineFields, _inlineFields + InlineCount);
+            }
+            _fields.push_back(f);
+        }
+        ++_count;
+    }
+
+    uint32_t EventFields::appendText(const char* s, size_t length)
+    {
+        uint32_t offset = static_cast<uint32_t>(_textSize);
+        size_t newSize = _textSize + length + 1;
+
+        if(newSize <= InlineTextSize)
+        {
+            memcpy(_inlineText + _textSize, s, length);
+            _inlineText[_textSize + length] = '\0';
+        }
+        else
+        {
+            // moving to the heap, sizes only grow so this happens once
+            if(_textSize <= InlineTextSize)
+            {
+                _text.assign(_inlineText, _inlineText + _textSize);
+            }
+            _text.insert(_text.end(), s, s + length);
+            _text.push_back('\0');
+        }
+        _textSize = newSize;
+        return offset;
+    }
+
+    const EventFields::Field& EventFields::field(size_t index) const
+    {
+        return _count > InlineCount ? _fields[index] : _inlineFields[index];
+    }
+
+    const char* EventFields::text() const
+    {
+        return _textSize > InlineTextSize ? _text.data() : _inlineText;
+    }
+}
@@ -0,0 +1,234 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAEventIdTable.h"
+#include "GAEvents.h"
+#include "GAValidator.h"
+#include "GAUtilities.h"
+#include <string.h>
+#include <stdio.h>
+#include <algorithm>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        // a few thousand ids per game is typical; ids beyond this are validated per call
+        const size_t GAEventIdTable::MaxEntries = 16384;
+        const size_t GAEventIdTable::ArenaBlockSize = 16384;
+
+        // 5 parts of 64 characters separated by ':'
+        static const size_t MaxDesignEventIdLength = 5 * 64 + 4;
+        static const size_t MaxProgressionLength = 64;
+
+        bool GAEventIdTable::_destroyed = false;
+        GAEventIdTable* GAEventIdTable::_instance = 0;
+        std::once_flag GAEventIdTable::_initInstanceFlag;
+
+        GAEventIdTable::GAEventIdTable():
+            _arenaBlockUsed(0)
+        {
+        }
+
+        GAEventIdTable::~GAEventIdTable()
+        {
+        }
+
+        void GAEventIdTable::cleanUp()
+        {
+            delete _instance;
+            _instance = 0;
+            _destroyed = true;
+        }
+
+        GAEventIdTable* GAEventIdTable::getInstance()
+        {
+            std::call_once(_initInstanceFlag, &GAEventIdTable::initInstance);
+            return _instance;
+        }
+
+        size_t GAEventIdTable::KeyHash::operator()(const Key& key) const
+        {
+            return static_cast<size_t>(utilities::GAUtilities::fnv1a(utilities::GAUtilities::Fnv1aOffsetBasis ^ static_cast<uint64_t>(key.kind), key.data, key.length));
+        }
+
+        bool GAEventIdTable::KeyEqual::operator()(const Key& first, const Key& second) const
+        {
+            return first.kind == second.kind && first.length == second.length && memcmp(first.data, second.data, first.length) == 0;
+        }
+
+        const char* GAEventIdTable::copyToArena(const char* s, size_t length)
+        {
+            size_t size = length + 1;
+            if(_arenaBlocks.empty() || _arenaBlockUsed + size > ArenaBlockSize)
+            {
+                _arenaBlocks.push_back(std::unique_ptr<char[]>(new char[std::max(size, ArenaBlockSize)]));
+                _arenaBlockUsed = 0;
+            }
+
+            char* out = _arenaBlocks.back().get() + _arenaBlockUsed;
+            memcpy(out, s, length);
+            out[length] = '\0';
+            _arenaBlockUsed += size;
+            return out;
+        }
+
+        uint32_t GAEventIdTable::addEntry(const Key& key, const GAEventIdEntry& entry)
+        {
+            _entries.push_back(entry);
+            uint32_t handle = static_cast<uint32_t>(_entries.size());
+            _index.insert(std::make_pair(key, handle));
+            return handle;
+        }
+
+        uint32_t GAEventIdTable::internDesignEventId(const char* eventId)
+        {
+            GAEventIdTable* i = getInstance();
+            if(!i || !eventId)
+            {
+                return 0;
+            }
+
+            size_t length = strlen(eventId);
+            if(length > MaxDesignEventIdLength)
+            {
+                return 0;
+            }
+
+            Key key = { DesignEventId, eventId, length };
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            std::unordered_map<Key, uint32_t, KeyHash, KeyEqual>::const_iterator itr = i->_index.find(key);
+            if(itr != i->_index.end())
+            {
+                return itr->second;
+            }
+            if(i->_entries.size() >= MaxEntries)
+            {
+                return 0;
+            }
+
+            GAEventIdEntry entry = {};
+            entry.kind = DesignEventId;
+            entry.valid = validators::GAValidator::validateEventIdLength(eventId) && validators::GAValidator::validateEventIdCharacters(eventId);
+            entry.eventId = i->copyToArena(eventId, length);
+            entry.eventIdLength = length;
+            // the stored key shares the id's copy
+            key.data = entry.eventId;
+            return i->addEntry(key, entry);
+        }
+
+        uint32_t GAEventIdTable::internProgression(const char* progression01, const char* progression02, const char* progression03)
+        {
+            GAEventIdTable* i = getInstance();
+            if(!i)
+            {
+                return 0;
+            }
+
+            progression01 = progression01 ? progression01 : "";
+            progression02 = progression02 ? progression02 : "";
+            progression03 = progression03 ? progression03 : "";
+            size_t length01 = strlen(progression01);
+            size_t length02 = strlen(progression02);
+            size_t length03 = strlen(progression03);
+            if(length01 > MaxProgressionLength || length02 > MaxProgressionLength || length03 > MaxProgressionLength)
+            {
+                return 0;
+            }
+
+            // parts separated by '\0' so "a:b" + "" and "a" + "b" get different keys
+            char keyData[3 * (MaxProgressionLength + 1)];
+            memcpy(keyData, progression01, length01 + 1);
+            memcpy(keyData + length01 + 1, progression02, length02 + 1);
+            memcpy(keyData + length01 + length02 + 2, progression03, length03);
+            Key key = { ProgressionEventId, keyData, length01 + length02 + length03 + 2 };
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            std::unordered_map<Key, uint32_t, KeyHash, KeyEqual>::const_iterator itr = i->_index.find(key);
+            if(itr != i->_index.end())
+            {
+                return itr->second;
+            }
+            if(i->_entries.size() >= MaxEntries)
+            {
+                return 0;
+            }
+
+            // same rules as GAValidator::validateProgressionEvent, minus the status
+            bool valid = length01 > 0 && validators::GAValidator::validateEventPartCharacters(progression01);
+            valid = valid && (length02 == 0 || validators::GAValidator::validateEventPartCharacters(progression02));
+            valid = valid && (length03 == 0 || (length02 > 0 && validators::GAValidator::validateEventPartCharacters(progression03)));
+
+            char identifier[3 * (MaxProgressionLength + 1)] = "";
+            progressionIdentifier(progression01, progression02, progression03, identifier, sizeof(identifier));
+
+            GAEventIdEntry entry = {};
+            entry.kind = ProgressionEventId;
+            entry.valid = valid;
+            entry.eventIdLength = strlen(identifier);
+            entry.eventId = i->copyToArena(identifier, entry.eventIdLength);
+            // the arena copy of the key ends with '\0', so it holds the three parts as strings
+            key.data = i->copyToArena(keyData, key.length);
+            entry.progression01 = key.data;
+            entry.progression02 = key.data + length01 + 1;
+            entry.progression03 = key.data + length01 + length02 + 2;
+
+            const EGAProgressionStatus statuses[] = { Start, Complete, Fail };
+            for(size_t s = 0; s < 3; ++s)
+            {
+                char statusString[10] = "";
+                GAEvents::progressionStatusString(statuses[s], statusString);
+                char eventId[sizeof(statusString) + sizeof(identifier)] = "";
+                int eventIdLength = snprintf(eventId, sizeof(eventId), "%s:%s", statusString, identifier);
+                entry.progressionEventIds[s] = i->copyToArena(eventId, static_cast<size_t>(eventIdLength));
+            }
+
+            return i->addEntry(key, entry);
+        }
+
+        bool GAEventIdTable::getEntry(uint32_t handle, GAEventIdEntry& out)
+        {
+            GAEventIdTable* i = getInstance();
+            if(!i || handle == 0)
+            {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            if(handle > i->_entries.size())
+            {
+                return false;
+            }
+            out = i->_entries[handle - 1];
+            return true;
+        }
+
+        void GAEventIdTable::progressionIdentifier(const char* progression01, const char* progression02, const char* progression03, char* out, size_t size)
+        {
+            if (strlen(progression02) == 0)
+            {
+                snprintf(out, size, "%s", progression01);
+            }
+            else if (strlen(progression03) == 0)
+            {
+                snprintf(out, size, "%s:%s", progression01, progression02);
+            }
+            else
+            {
+                snprintf(out, size, "%s:%s:%s", progression01, progression02, progression03);
+            }
+        }
+
+        const char* GAEventIdTable::progressionEventId(const GAEventIdEntry& entry, EGAProgressionStatus progressionStatus)
+        {
+            if(entry.kind != ProgressionEventId || progressionStatus < Start || progressionStatus > Fail)
+            {
+                return nullptr;
+            }
+            return entry.progressionEventIds[progressionStatus - Start];
+        }
+    }
+}
@@ -0,0 +1,108 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics.h"
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <cstdlib>
+#include <cstdint>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        enum EGAEventIdKind
+        {
+            DesignEventId = 1,
+            ProgressionEventId = 2
+        };
+
+        // Interned design event id or progression triple. All strings live in
+        // the table's arena and stay valid for the lifetime of the process.
+        struct GAEventIdEntry
+        {
+            EGAEventIdKind kind;
+            // cached result of the character and length validation
+            bool valid;
+            // design: the event id, progression: "01", "01:02" or "01:02:03"
+            const char* eventId;
+            size_t eventIdLength;
+            const char* progression01;
+            const char* progression02;
+            const char* progression03;
+            // "Start:<id>", "Complete:<id>" and "Fail:<id>"
+            const char* progressionEventIds[3];
+        };
+
+        class GAEventIdTable
+        {
+        public:
+            // Returns a handle (> 0) for the event id, adding it on first use.
+            // Returns 0 once the table is full; callers then take the slow path.
+            static uint32_t internDesignEventId(const char* eventId);
+            static uint32_t internProgression(const char* progression01, const char* progression02, const char* progression03);
+            static bool getEntry(uint32_t handle, GAEventIdEntry& out);
+
+            // formats "01", "01:02" or "01:02:03" like the progression event id does
+            static void progressionIdentifier(const char* progression01, const char* progression02, const char* progression03, char* out, size_t size);
+            static const char* progressionEventId(const GAEventIdEntry& entry, EGAProgressionStatus progressionStatus);
+
+        private:
+            GAEventIdTable();
+            ~GAEventIdTable();
+            GAEventIdTable(const GAEventIdTable&) = delete;
+            GAEventIdTable& operator=(const GAEventIdTable&) = delete;
+
+            struct Key
+            {
+                EGAEventIdKind kind;
+                const char* data;
+                size_t length;
+            };
+
+            struct KeyHash
+            {
+                size_t operator()(const Key& key) const;
+            };
+
+            struct KeyEqual
+            {
+                bool operator()(const Key& first, const Key& second) const;
+            };
+
+            const char* copyToArena(const char* s, size_t length);
+            // key.data must already be in the arena, it is not copied again
+            uint32_t addEntry(const Key& key, const GAEventIdEntry& entry);
+
+            static const size_t MaxEntries;
+            static const size_t ArenaBlockSize;
+
+            std::mutex _mtx;
+            std::vector<std::unique_ptr<char[]>> _arenaBlocks;
+            size_t _arenaBlockUsed;
+            std::vector<GAEventIdEntry> _entries;
+            std::unordered_map<Key, uint32_t, KeyHash, KeyEqual> _index;
+
+            static bool _destroyed;
+            static GAEventIdTable* _instance;
+            static std::once_flag _initInstanceFlag;
+            static void cleanUp();
+            static GAEventIdTable* getInstance();
+
+            static void initInstance()
+            {
+                if(!_destroyed && !_instance)
+                {
+                    _instance = new GAEventIdTable();
+                    std::atexit(&cleanUp);
+                }
+            }
+        };
+    }
+}
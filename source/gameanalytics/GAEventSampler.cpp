@@ -0,0 +1,222 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAEventSampler.h"
+#include "GALogger.h"
+#include "GAUtilities.h"
+#include "rapidjson/document.h"
+#include <string.h>
+#include <stdio.h>
+#include <cmath>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        const char* GAEventSampler::RemoteConfigsKey = "ga_event_sampling";
+
+        static const char* SampledCategories[] = { "design", "business", "progression", "resource", "error" };
+
+        bool GAEventSampler::_destroyed = false;
+        GAEventSampler* GAEventSampler::_instance = 0;
+        std::once_flag GAEventSampler::_initInstanceFlag;
+
+        GAEventSampler::GAEventSampler():
+            _active(false)
+        {
+        }
+
+        GAEventSampler::~GAEventSampler()
+        {
+        }
+
+        void GAEventSampler::cleanUp()
+        {
+            delete _instance;
+            _instance = 0;
+            _destroyed = true;
+        }
+
+        GAEventSampler* GAEventSampler::getInstance()
+        {
+            client::GAClientContext* client = client::GAClientContext::current();
+            if(client)
+            {
+                return client->getSampler();
+            }
+            std::call_once(_initInstanceFlag, &GAEventSampler::initInstance);
+            return _instance;
+        }
+
+        bool GAEventSampler::makeRule(const char* category, const char* prefix, double rate, EGASamplingKey key, Rule& out)
+        {
+            if(!category || !std::isfinite(rate) || rate < 0 || rate > 1 || (key != SampleByUser && key != SampleBySession))
+            {
+                return false;
+            }
+
+            bool knownCategory = false;
+            for(size_t i = 0; i < sizeof(SampledCategories) / sizeof(SampledCategories[0]); ++i)
+            {
+                knownCategory = knownCategory || strcmp(category, SampledCategories[i]) == 0;
+            }
+            if(!knownCategory)
+            {
+                return false;
+            }
+
+            snprintf(out.category, sizeof(out.category), "%s", category);
+            out.prefix = prefix ? prefix : "";
+            out.key = key;
+            out.threshold = static_cast<uint64_t>(rate * 4294967296.0);
+            out.seed = utilities::GAUtilities::fnv1a(utilities::GAUtilities::fnv1a(out.category), out.prefix.c_str());
+            return true;
+        }
+
+        void GAEventSampler::addRule(std::vector<Rule>& rules, const Rule& rule)
+        {
+            for(size_t i = 0; i < rules.size(); ++i)
+            {
+                if(strcmp(rules[i].category, rule.category) == 0 && rules[i].prefix == rule.prefix)
+                {
+                    rules[i] = rule;
+                    return;
+                }
+            }
+            rules.push_back(rule);
+        }
+
+        void GAEventSampler::updateActive()
+        {
+            _active.store(!_localRules.empty() || !_remoteRules.empty(), std::memory_order_release);
+        }
+
+        bool GAEventSampler::setRule(const char* category, const char* prefix, double rate, EGASamplingKey key)
+        {
+            GAEventSampler* i = getInstance();
+            if(!i)
+            {
+                return false;
+            }
+
+            Rule rule;
+            if(!makeRule(category, prefix, rate, key, rule))
+            {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            addRule(i->_localRules, rule);
+            i->updateActive();
+            return true;
+        }
+
+        void GAEventSampler::clearRules()
+        {
+            GAEventSampler* i = getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            i->_localRules.clear();
+            i->updateActive();
+        }
+
+        bool GAEventSampler::setRemoteRules(const char* rulesJson)
+        {
+            GAEventSampler* i = getInstance();
+            if(!i)
+            {
+                return false;
+            }
+
+            std::vector<Rule> rules;
+            bool result = true;
+            if(rulesJson && strlen(rulesJson) > 0)
+            {
+                rapidjson::Document json;
+                json.Parse(rulesJson);
+                if(json.HasParseError() || !json.IsArray())
+                {
+                    logging::GALogger::w("Event sampling: remote rules are not a JSON array, ignoring them");
+                    result = false;
+                }
+                else
+                {
+                    for (rapidjson::Value::ConstValueIterator itr = json.Begin(); itr != json.End(); ++itr)
+                    {
+                        const rapidjson::Value& r = *itr;
+                        const char* category = (r.IsObject() && r.HasMember("category") && r["category"].IsString()) ? r["category"].GetString() : nullptr;
+                        const char* prefix = (r.IsObject() && r.HasMember("prefix") && r["prefix"].IsString()) ? r["prefix"].GetString() : "";
+                        double rate = (r.IsObject() && r.HasMember("rate") && r["rate"].IsNumber()) ? r["rate"].GetDouble() : -1;
+                        const char* key = (r.IsObject() && r.HasMember("key") && r["key"].IsString()) ? r["key"].GetString() : "user";
+
+                        Rule rule;
+                        if(makeRule(category, prefix, rate, strcmp(key, "session") == 0 ? SampleBySession : SampleByUser, rule))
+                        {
+                            addRule(rules, rule);
+                        }
+                        else
+                        {
+                            logging::GALogger::w("Event sampling: ignoring invalid remote rule");
+                            result = false;
+                        }
+                    }
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            i->_remoteRules.swap(rules);
+            i->updateActive();
+            return result;
+        }
+
+        bool GAEventSampler::isActive()
+        {
+            GAEventSampler* i = getInstance();
+            return i && i->_active.load(std::memory_order_acquire);
+        }
+
+        bool GAEventSampler::keepEvent(const char* category, const char* eventId, const char* userId, const char* sessionId)
+        {
+            GAEventSampler* i = getInstance();
+            if(!i || !i->_active.load(std::memory_order_acquire))
+            {
+                return true;
+            }
+
+            eventId = eventId ? eventId : "";
+
+            std::lock_guard<std::mutex> lock(i->_mtx);
+            const std::vector<Rule>& rules = i->_remoteRules.empty() ? i->_localRules : i->_remoteRules;
+            const Rule* match = nullptr;
+            for(size_t r = 0; r < rules.size(); ++r)
+            {
+                const Rule& rule = rules[r];
+                if(strcmp(rule.category, category) == 0 && strncmp(eventId, rule.prefix.c_str(), rule.prefix.size()) == 0 && (!match || rule.prefix.size() > match->prefix.size()))
+                {
+                    match = &rule;
+                }
+            }
+
+            if(!match)
+            {
+                return true;
+            }
+
+            const char* id = match->key == SampleBySession ? sessionId : userId;
+            uint64_t hash = utilities::GAUtilities::fnv1a(match->seed, id ? id : "");
+            // FNV-1a alone is biased for ids that only differ in the last characters
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ULL;
+            hash ^= hash >> 33;
+            return (hash >> 32) < match->threshold;
+        }
+    }
+}
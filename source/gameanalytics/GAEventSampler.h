@@ -0,0 +1,82 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics.h"
+#include "GAClient.h"
+#include <vector>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <cstdlib>
+#include <cstdint>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        class GAEventSampler
+        {
+        public:
+            // Remote config key holding a JSON array of rules, e.g.
+            // [{"category":"design","prefix":"perf:","rate":0.05,"key":"user"}]
+            static const char* RemoteConfigsKey;
+
+            // Keep rate (0-1) of the events in the category whose event id starts
+            // with prefix. The rule with the longest matching prefix is used.
+            static bool setRule(const char* category, const char* prefix, double rate, EGASamplingKey key);
+            static void clearRules();
+            // Remote rules replace the local rules while present, null or empty clears them
+            static bool setRemoteRules(const char* rulesJson);
+
+            // Cheap check so callers only build event ids when there are rules
+            static bool isActive();
+            static bool keepEvent(const char* category, const char* eventId, const char* userId, const char* sessionId);
+
+        private:
+            GAEventSampler();
+            ~GAEventSampler();
+            GAEventSampler(const GAEventSampler&) = delete;
+            GAEventSampler& operator=(const GAEventSampler&) = delete;
+            friend class client::GAClientContext;
+
+            struct Rule
+            {
+                char category[16];
+                std::string prefix;
+                EGASamplingKey key;
+                // events are kept when the hash is below the threshold, 2^32 keeps all
+                uint64_t threshold;
+                // makes rules sample independent sets of users
+                uint64_t seed;
+            };
+
+            static bool makeRule(const char* category, const char* prefix, double rate, EGASamplingKey key, Rule& out);
+            static void addRule(std::vector<Rule>& rules, const Rule& rule);
+            void updateActive();
+
+            std::mutex _mtx;
+            std::atomic<bool> _active;
+            std::vector<Rule> _localRules;
+            std::vector<Rule> _remoteRules;
+
+            static bool _destroyed;
+            static GAEventSampler* _instance;
+            static std::once_flag _initInstanceFlag;
+            static void cleanUp();
+            static GAEventSampler* getInstance();
+
+            static void initInstance()
+            {
+                if(!_destroyed && !_instance)
+                {
+                    _instance = new GAEventSampler();
+                    std::atexit(&cleanUp);
+                }
+            }
+        };
+    }
+}
@@ -11,6 +11,10 @@
 #include "GAStore.h"
 #include "GAThreading.h"
 #include "GAValidator.h"
+#include "GAEventIdTable.h"
+#include "GAEventAggregator.h"
+#include "GAEventSampler.h"
+#include "GAMetrics.h"
 #include <string.h>
 #include <stdio.h>
 #include <cmath>
@@ -18,6 +22,10 @@
 #include "rapidjson/writer.h"
 #include "rapidjson/error/en.h"
 #include <inttypes.h>
+#include <chrono>
+#include <algorithm>
+#include <array>
+#include <string>
 
 namespace gameanalytics
 {
@@ -30,8 +38,14 @@ namespace gameanalytics
         const char* GAEvents::CategoryProgression = "progression";
         const char* GAEvents::CategoryResource = "resource";
         const char* GAEvents::CategoryError = "error";
-        const double GAEvents::ProcessEventsIntervalInSeconds = 8.0;
-        const int GAEvents::MaxEventCount = 500;
+        const double GAEvents::ProcessEventsIntervalInSeconds = GABatchController::DefaultIntervalSeconds;
+        const int GAEvents::DefaultMaxInFlightBatches = 4;
+        const int GAEvents::MaxInFlightBatchesLimit = 16;
+
+        static double monotonicSeconds()
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
 
         bool GAEvents::_destroyed = false;
         GAEvents* GAEvents::_instance = 0;
@@ -41,6 +55,9 @@ namespace gameanalytics
         {
             isRunning = false;
             keepRunning = false;
+            inFlightBatches = 0;
+            maxInFlightBatches = GAEvents::DefaultMaxInFlightBatches;
+            circuitState = CircuitClosed;
         }
 
         GAEvents::~GAEvents()
@@ -59,6 +76,11 @@ namespace gameanalytics
 
         GAEvents* GAEvents::getInstance()
         {
+            client::GAClientContext* client = client::GAClientContext::current();
+            if(client)
+            {
+                return client->getEvents();
+            }
             std::call_once(_initInstanceFlag, &GAEvents::initInstance);
             return _instance;
         }
@@ -110,12 +132,15 @@ namespace gameanalytics
             }
 
 
-            // Increment session number  and persist
+            // Increment session number and persist, players' numbers are kept by the caller
             state::GAState::incrementSessionNum();
-            char sessionNum[11] = "";
-            snprintf(sessionNum, sizeof(sessionNum), "%d", state::GAState::getSessionNum());
-            const char* parameters[2] = {"session_num", sessionNum};
-            store::GAStore::executeQuerySync("INSERT OR REPLACE INTO ga_state (key, value) VALUES(?, ?);", parameters, 2);
+            if(!state::GAState::hasActivePlayer())
+            {
+                char sessionNum[11] = "";
+                snprintf(sessionNum, sizeof(sessionNum), "%d", state::GAState::getSessionNum());
+                const char* parameters[2] = {"session_num", sessionNum};
+                store::GAStore::executeQuerySync("INSERT OR REPLACE INTO ga_state (key, value) VALUES(?, ?);", parameters, 2);
+            }
 
             // Add custom dimensions
             GAEvents::addDimensionsToEvent(eventDict);
@@ -124,10 +149,13 @@ namespace gameanalytics
             addEventToStore(eventDict);
 
             // Log
-            logging::GALogger::i("Add SESSION START event");
+            GA_LOG_INFO("Add SESSION START event");
 
-            // Send event right away
-            GAEvents::processEvents(categorySessionStart, false);
+            // Send event right away, player sessions go with the next batch
+            if(!state::GAState::hasActivePlayer())
+            {
+                GAEvents::processEvents(categorySessionStart, false);
+            }
         }
 
         void GAEvents::addSessionEndEvent()
@@ -143,6 +171,12 @@ namespace gameanalytics
                 return;
             }
 
+            // Summaries of open aggregation windows belong to this session
+            if(!state::GAState::hasActivePlayer())
+            {
+                GAEvents::flushAggregatedDesignEvents(true);
+            }
+
             int64_t session_start_ts = state->getSessionStart();
             int64_t client_ts_adjusted = state::GAState::getClientTsAdjusted();
             int64_t sessionLength = client_ts_adjusted - session_start_ts;
@@ -173,20 +207,33 @@ namespace gameanalytics
             addEventToStore(eventDict);
 
             // Log
-            logging::GALogger::i("Add SESSION END event.");
+            GA_LOG_INFO("Add SESSION END event.");
 
-            // Send all event right away
-            GAEvents::processEvents("", false);
+            // Send all event right away, player sessions go with the next batch
+            if(!state::GAState::hasActivePlayer())
+            {
+                GAEvents::processEvents("", false);
+            }
         }
 
         // BUSINESS EVENT
-        void GAEvents::addBusinessEvent(const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType, const rapidjson::Value& fields)
+        void GAEvents::addBusinessEvent(const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType, const EventFields& fields)
         {
             if(!state::GAState::isEventSubmissionEnabled())
             {
                 return;
             }
 
+            if(GAEventSampler::isActive())
+            {
+                char eventId[129] = "";
+                snprintf(eventId, sizeof(eventId), "%s:%s", itemType ? itemType : "", itemId ? itemId : "");
+                if(isSampledOut(GAEvents::CategoryBusiness, eventId))
+                {
+                    return;
+                }
+            }
+
             // Validate event params
             validators::ValidationResult validationResult;
             validators::GAValidator::validateBusinessEvent(currency, amount, cartType, itemType, itemId, validationResult);
@@ -208,10 +255,13 @@ namespace gameanalytics
 
             // Increment transaction number and persist
             state::GAState::incrementTransactionNum();
-            char transactionNum[11] = "";
-            snprintf(transactionNum, sizeof(transactionNum), "%d", state::GAState::getTransactionNum());
-            const char* params[2] = {"transaction_num", transactionNum};
-            store::GAStore::executeQuerySync("INSERT OR REPLACE INTO ga_state (key, value) VALUES(?, ?);", params, 2);
+            if(!state::GAState::hasActivePlayer())
+            {
+                char transactionNum[11] = "";
+                snprintf(transactionNum, sizeof(transactionNum), "%d", state::GAState::getTransactionNum());
+                const char* params[2] = {"transaction_num", transactionNum};
+                store::GAStore::executeQuerySync("INSERT OR REPLACE INTO ga_state (key, value) VALUES(?, ?);", params, 2);
+            }
 
             // Required
             {
@@ -241,31 +291,34 @@ namespace gameanalytics
             // Add custom dimensions
             GAEvents::addDimensionsToEvent(eventDict);
 
-            rapidjson::Document cleanedFields;
-            cleanedFields.SetObject();
-            state::GAState::validateAndCleanCustomFields(fields, cleanedFields);
-            GAEvents::addFieldsToEvent(eventDict, cleanedFields);
-
-            rapidjson::StringBuffer buffer;
-            {
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-                fields.Accept(writer);
-            }
+            GAEvents::addFieldsToEvent(eventDict, fields);
 
             // Log
-            logging::GALogger::i("Add BUSINESS event: {currency:%s, amount:%d, itemType:%s, itemId:%s, cartType:%s, fields:%s}", currency, amount, itemType, itemId, cartType, buffer.GetString());
+            GA_LOG_INFO("Add BUSINESS event: {currency:%s, amount:%d, itemType:%s, itemId:%s, cartType:%s, fields:%s}", currency, amount, itemType, itemId, cartType, GAEvents::customFieldsString(fields).c_str());
 
             // Send to store
             addEventToStore(eventDict);
         }
 
-        void GAEvents::addResourceEvent(EGAResourceFlowType flowType, const char* currency, double amount, const char* itemType, const char* itemId, const rapidjson::Value& fields)
+        void GAEvents::addResourceEvent(EGAResourceFlowType flowType, const char* currency, double amount, const char* itemType, const char* itemId, const EventFields& fields)
         {
             if(!state::GAState::isEventSubmissionEnabled())
             {
                 return;
             }
 
+            if(GAEventSampler::isActive())
+            {
+                char flowTypeString[10] = "";
+                resourceFlowTypeString(flowType, flowTypeString);
+                char eventId[257] = "";
+                snprintf(eventId, sizeof(eventId), "%s:%s:%s:%s", flowTypeString, currency ? currency : "", itemType ? itemType : "", itemId ? itemId : "");
+                if(isSampledOut(GAEvents::CategoryResource, eventId))
+                {
+                    return;
+                }
+            }
+
             // Validate event params
             validators::ValidationResult validationResult;
             validators::GAValidator::validateResourceEvent(flowType, currency, amount, itemType, itemId, validationResult);
@@ -309,81 +362,123 @@ namespace gameanalytics
             // Add custom dimensions
             GAEvents::addDimensionsToEvent(eventDict);
 
-            rapidjson::Document cleanedFields;
-            cleanedFields.SetObject();
-            state::GAState::validateAndCleanCustomFields(fields, cleanedFields);
-            GAEvents::addFieldsToEvent(eventDict, cleanedFields);
-
-            rapidjson::StringBuffer buffer;
-            {
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-                fields.Accept(writer);
-            }
+            GAEvents::addFieldsToEvent(eventDict, fields);
 
             // Log
-            logging::GALogger::i("Add RESOURCE event: {currency:%s, amount: %f, itemType:%s, itemId:%s, fields:%s}", currency, amount, itemType, itemId, buffer.GetString());
+            GA_LOG_INFO("Add RESOURCE event: {currency:%s, amount: %f, itemType:%s, itemId:%s, fields:%s}", currency, amount, itemType, itemId, GAEvents::customFieldsString(fields).c_str());
 
             // Send to store
             addEventToStore(eventDict);
         }
 
-        void GAEvents::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, bool sendScore, const rapidjson::Value& fields)
+        void GAEvents::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, bool sendScore, const EventFields& fields)
         {
             if(!state::GAState::isEventSubmissionEnabled())
             {
                 return;
             }
 
-            char statusString[10] = "";
-            progressionStatusString(progressionStatus, statusString);
+            GAEventIdEntry entry;
+            const char* eventId = nullptr;
+            uint32_t handle = GAEventIdTable::internProgression(progression01, progression02, progression03);
+            if(handle != 0 && GAEventIdTable::getEntry(handle, entry) && entry.valid)
+            {
+                eventId = GAEventIdTable::progressionEventId(entry, progressionStatus);
+            }
 
-            // Validate event params
-            validators::ValidationResult validationResult;
-            validators::GAValidator::validateProgressionEvent(progressionStatus, progression01, progression02, progression03, validationResult);
-            if (!validationResult.result)
+            if(GAEventSampler::isActive())
             {
-                http::GAHTTPApi* httpInstance = http::GAHTTPApi::getInstance();
-                if(!httpInstance)
+                char sampleId[257] = "";
+                if(!eventId)
+                {
+                    char statusString[10] = "";
+                    progressionStatusString(progressionStatus, statusString);
+                    char identifier[200] = "";
+                    GAEventIdTable::progressionIdentifier(progression01 ? progression01 : "", progression02 ? progression02 : "", progression03 ? progression03 : "", identifier, sizeof(identifier));
+                    snprintf(sampleId, sizeof(sampleId), "%s:%s", statusString, identifier);
+                }
+                if(isSampledOut(GAEvents::CategoryProgression, eventId ? eventId : sampleId))
                 {
                     return;
                 }
-                httpInstance->sendSdkErrorEvent(validationResult.category, validationResult.area, validationResult.action, validationResult.parameter, validationResult.reason, state::GAState::getGameKey(), state::GAState::getGameSecret());
-                return;
             }
 
-            // Create empty eventData
-            rapidjson::Document eventDict;
-            eventDict.SetObject();
-            rapidjson::Document::AllocatorType& allocator = eventDict.GetAllocator();
-
-            // Progression identifier
             char progressionIdentifier[257] = "";
-
-            if (strlen(progression02) == 0)
+            char s[513] = "";
+            if(!eventId)
             {
-                snprintf(progressionIdentifier, sizeof(progressionIdentifier), "%s", progression01);
-            }
-            else if (strlen(progression03) == 0)
-            {
-                snprintf(progressionIdentifier, sizeof(progressionIdentifier), "%s:%s", progression01, progression02);
+                // Not cached or invalid: validate event params so failures get logged and reported
+                validators::ValidationResult validationResult;
+                validators::GAValidator::validateProgressionEvent(progressionStatus, progression01, progression02, progression03, validationResult);
+                if (!validationResult.result)
+                {
+                    http::GAHTTPApi* httpInstance = http::GAHTTPApi::getInstance();
+                    if(!httpInstance)
+                    {
+                        return;
+                    }
+                    httpInstance->sendSdkErrorEvent(validationResult.category, validationResult.area, validationResult.action, validationResult.parameter, validationResult.reason, state::GAState::getGameKey(), state::GAState::getGameSecret());
+                    return;
+                }
+
+                // Valid but the table is full
+                char statusString[10] = "";
+                progressionStatusString(progressionStatus, statusString);
+                GAEventIdTable::progressionIdentifier(progression01, progression02, progression03, progressionIdentifier, sizeof(progressionIdentifier));
+                snprintf(s, sizeof(s), "%s:%s", statusString, progressionIdentifier);
+
+                entry = GAEventIdEntry();
+                entry.kind = ProgressionEventId;
+                entry.valid = true;
+                entry.eventId = progressionIdentifier;
+                entry.eventIdLength = strlen(progressionIdentifier);
+                entry.progression01 = progression01;
+                entry.progression02 = progression02;
+                entry.progression03 = progression03;
+                eventId = s;
             }
-            else
+
+            addProgressionEvent(progressionStatus, entry, eventId, score, sendScore, fields);
+        }
+
+        void GAEvents::addProgressionEvent(EGAProgressionStatus progressionStatus, uint32_t progressionHandle, int score, bool sendScore, const EventFields& fields)
+        {
+            GAEventIdEntry entry;
+            if(!GAEventIdTable::getEntry(progressionHandle, entry) || entry.kind != ProgressionEventId)
             {
-                snprintf(progressionIdentifier, sizeof(progressionIdentifier), "%s:%s:%s", progression01, progression02, progression03);
+                logging::GALogger::w("Could not add progression event: unknown progression handle %u", progressionHandle);
+                return;
             }
 
-            // Append event specifics
+            const char* eventId = GAEventIdTable::progressionEventId(entry, progressionStatus);
+            if(!entry.valid || !eventId)
             {
-                rapidjson::Value v(GAEvents::CategoryProgression, allocator);
-                eventDict.AddMember("category", v.Move(), allocator);
+                addProgressionEvent(progressionStatus, entry.progression01, entry.progression02, entry.progression03, score, sendScore, fields);
+                return;
             }
+
+            if(!state::GAState::isEventSubmissionEnabled() || isSampledOut(GAEvents::CategoryProgression, eventId))
             {
-                char s[513] = "";
-                snprintf(s, sizeof(s), "%s:%s", statusString, progressionIdentifier);
-                rapidjson::Value v(s, allocator);
-                eventDict.AddMember("event_id", v.Move(), allocator);
+                return;
             }
 
+            addProgressionEvent(progressionStatus, entry, eventId, score, sendScore, fields);
+        }
+
+        void GAEvents::addProgressionEvent(EGAProgressionStatus progressionStatus, const GAEventIdEntry& entry, const char* eventId, int score, bool sendScore, const EventFields& fields)
+        {
+            char statusString[10] = "";
+            progressionStatusString(progressionStatus, statusString);
+
+            // Create empty eventData
+            rapidjson::Document eventDict;
+            eventDict.SetObject();
+            rapidjson::Document::AllocatorType& allocator = eventDict.GetAllocator();
+
+            // Append event specifics, the interned strings outlive the event so they are not copied
+            eventDict.AddMember("category", rapidjson::StringRef(GAEvents::CategoryProgression), allocator);
+            eventDict.AddMember("event_id", rapidjson::StringRef(eventId), allocator);
+
             // Attempt
             int attempt_num = 0;
 
@@ -397,108 +492,130 @@ namespace gameanalytics
             if (progressionStatus == EGAProgressionStatus::Fail)
             {
                 // Increment attempt number
-                state::GAState::incrementProgressionTries(progressionIdentifier);
+                state::GAState::incrementProgressionTries(entry.eventId);
             }
 
             // increment and add attempt_num on complete and delete persisted
             if (progressionStatus == EGAProgressionStatus::Complete)
             {
                 // Increment attempt number
-                state::GAState::incrementProgressionTries(progressionIdentifier);
+                state::GAState::incrementProgressionTries(entry.eventId);
 
                 // Add to event
-                attempt_num = state::GAState::getProgressionTries(progressionIdentifier);
+                attempt_num = state::GAState::getProgressionTries(entry.eventId);
                 eventDict.AddMember("attempt_num", attempt_num, allocator);
 
                 // Clear
-                state::GAState::clearProgressionTries(progressionIdentifier);
+                state::GAState::clearProgressionTries(entry.eventId);
             }
 
             // Add custom dimensions
             GAEvents::addDimensionsToEvent(eventDict);
 
-            rapidjson::Document cleanedFields;
-            cleanedFields.SetObject();
-            state::GAState::validateAndCleanCustomFields(fields, cleanedFields);
-            GAEvents::addFieldsToEvent(eventDict, cleanedFields);
-
-            rapidjson::StringBuffer buffer;
-            {
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-                fields.Accept(writer);
-            }
+            GAEvents::addFieldsToEvent(eventDict, fields);
 
             // Log
-            logging::GALogger::i("Add PROGRESSION event: {status:%s, progression01:%s, progression02:%s, progression03:%s, score:%d, attempt:%d, fields:%s}", statusString, progression01, progression02, progression03, score, attempt_num, buffer.GetString());
+            GA_LOG_INFO("Add PROGRESSION event: {status:%s, progression01:%s, progression02:%s, progression03:%s, score:%d, attempt:%d, fields:%s}", statusString, entry.progression01, entry.progression02, entry.progression03, score, attempt_num, GAEvents::customFieldsString(fields).c_str());
 
 
             // Send to store
             addEventToStore(eventDict);
         }
 
-        void GAEvents::addDesignEvent(const char* eventId, double value, bool sendValue, const rapidjson::Value& fields)
+        void GAEvents::addDesignEvent(const char* eventId, double value, bool sendValue, const EventFields& fields)
         {
-            if(!state::GAState::isEventSubmissionEnabled())
+            if(!state::GAState::isEventSubmissionEnabled() || isSampledOut(GAEvents::CategoryDesign, eventId))
             {
                 return;
             }
 
-            // Validate
-            validators::ValidationResult validationResult;
-            validators::GAValidator::validateDesignEvent(eventId, validationResult);
-            if (!validationResult.result)
+            GAEventIdEntry entry;
+            uint32_t handle = GAEventIdTable::internDesignEventId(eventId);
+            if(handle == 0 || !GAEventIdTable::getEntry(handle, entry) || !entry.valid)
             {
-                http::GAHTTPApi* httpInstance = http::GAHTTPApi::getInstance();
-                if(!httpInstance)
+                // Not cached or invalid: validate so failures get logged and reported
+                validators::ValidationResult validationResult;
+                validators::GAValidator::validateDesignEvent(eventId, validationResult);
+                if (!validationResult.result)
                 {
+                    http::GAHTTPApi* httpInstance = http::GAHTTPApi::getInstance();
+                    if(!httpInstance)
+                    {
+                        return;
+                    }
+                    httpInstance->sendSdkErrorEvent(validationResult.category, validationResult.area, validationResult.action, validationResult.parameter, validationResult.reason, state::GAState::getGameKey(), state::GAState::getGameSecret());
                     return;
                 }
-                httpInstance->sendSdkErrorEvent(validationResult.category, validationResult.area, validationResult.action, validationResult.parameter, validationResult.reason, state::GAState::getGameKey(), state::GAState::getGameSecret());
+
+                entry = GAEventIdEntry();
+                entry.kind = DesignEventId;
+                entry.valid = true;
+                entry.eventId = eventId;
+                entry.eventIdLength = strlen(eventId);
+            }
+
+            addDesignEvent(entry, value, sendValue, fields);
+        }
+
+        void GAEvents::addDesignEvent(uint32_t eventIdHandle, double value, bool sendValue, const EventFields& fields)
+        {
+            GAEventIdEntry entry;
+            if(!GAEventIdTable::getEntry(eventIdHandle, entry) || entry.kind != DesignEventId)
+            {
+                logging::GALogger::w("Could not add design event: unknown event id handle %u", eventIdHandle);
                 return;
             }
 
-            // Create empty eventData
-            rapidjson::Document eventData;
-            eventData.SetObject();
-            rapidjson::Document::AllocatorType& allocator = eventData.GetAllocator();
+            if(!entry.valid)
+            {
+                addDesignEvent(entry.eventId, value, sendValue, fields);
+                return;
+            }
 
-            // Append event specifics
+            if(!state::GAState::isEventSubmissionEnabled() || isSampledOut(GAEvents::CategoryDesign, entry.eventId))
             {
-                rapidjson::Value v(GAEvents::CategoryDesign, allocator);
-                eventData.AddMember("category", v.Move(), allocator);
+                return;
             }
+
+            addDesignEvent(entry, value, sendValue, fields);
+        }
+
+        void GAEvents::addDesignEvent(const GAEventIdEntry& entry, double value, bool sendValue, const EventFields& fields)
+        {
+            // Aggregated events are summarised when their window closes, the
+            // summaries carry the local user so player events are sent as they are
+            if (sendValue && fields.empty() && !state::GAState::hasActivePlayer() && GAEventAggregator::add(entry.eventId, state::GAState::getCurrentCustomDimension01(), state::GAState::getCurrentCustomDimension02(), state::GAState::getCurrentCustomDimension03(), value, utilities::GAUtilities::timeIntervalSince1970()))
             {
-                rapidjson::Value v(eventId, allocator);
-                eventData.AddMember("event_id", v.Move(), allocator);
+                return;
             }
 
+            // Create empty eventData
+            rapidjson::Document eventData;
+            eventData.SetObject();
+            rapidjson::Document::AllocatorType& allocator = eventData.GetAllocator();
+
+            // Append event specifics, the interned strings outlive the event so they are not copied
+            eventData.AddMember("category", rapidjson::StringRef(GAEvents::CategoryDesign), allocator);
+            eventData.AddMember("event_id", rapidjson::StringRef(entry.eventId, static_cast<rapidjson::SizeType>(entry.eventIdLength)), allocator);
+
             if (sendValue)
             {
                 eventData.AddMember("value", value, allocator);
             }
 
-            rapidjson::Document cleanedFields;
-            cleanedFields.SetObject();
-            state::GAState::validateAndCleanCustomFields(fields, cleanedFields);
-            GAEvents::addFieldsToEvent(eventData, cleanedFields);
+            GAEvents::addFieldsToEvent(eventData, fields);
 
             // Add custom dimensions
             GAEvents::addDimensionsToEvent(eventData);
 
-            rapidjson::StringBuffer buffer;
-            {
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-                fields.Accept(writer);
-            }
-
             // Log
-            logging::GALogger::i("Add DESIGN event: {eventId:%s, value:%f, fields:%s}", eventId, value, buffer.GetString());
+            GA_LOG_INFO("Add DESIGN event: {eventId:%s, value:%f, fields:%s}", entry.eventId, value, GAEvents::customFieldsString(fields).c_str());
 
             // Send to store
             addEventToStore(eventData);
         }
 
-        void GAEvents::addErrorEvent(EGAErrorSeverity severity, const char* message, const rapidjson::Value& fields)
+        void GAEvents::addErrorEvent(EGAErrorSeverity severity, const char* message, const EventFields& fields)
         {
             if(!state::GAState::isEventSubmissionEnabled())
             {
@@ -508,6 +625,11 @@ namespace gameanalytics
             char severityString[10] = "";
             errorSeverityString(severity, severityString);
 
+            if(isSampledOut(GAEvents::CategoryError, severityString))
+            {
+                return;
+            }
+
             // Validate
             validators::ValidationResult validationResult;
             validators::GAValidator::validateErrorEvent(severity, message, validationResult);
@@ -541,22 +663,99 @@ namespace gameanalytics
                 eventData.AddMember("message", v.Move(), allocator);
             }
 
-            rapidjson::Document cleanedFields;
-            cleanedFields.SetObject();
-            state::GAState::validateAndCleanCustomFields(fields, cleanedFields);
-            GAEvents::addFieldsToEvent(eventData, cleanedFields);
+            GAEvents::addFieldsToEvent(eventData, fields);
 
             // Add custom dimensions
             GAEvents::addDimensionsToEvent(eventData);
 
-            rapidjson::StringBuffer buffer;
+            // Log
+            GA_LOG_INFO("Add ERROR event: {severity:%s, message:%s, fields:%s}", severityString, message, GAEvents::customFieldsString(fields).c_str());
+
+            // Send to store
+            addEventToStore(eventData);
+        }
+
+        bool GAEvents::isSampledOut(const char* category, const char* eventId)
+        {
+            if(!GAEventSampler::isActive())
             {
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-                fields.Accept(writer);
+                return false;
+            }
+            return !GAEventSampler::keepEvent(category, eventId, state::GAState::getIdentifier(), state::GAState::getSessionId());
+        }
+
+        void GAEvents::removeDesignEventAggregation(const char* eventId)
+        {
+            std::vector<GAAggregatedDesignEvent> aggregates;
+            GAEventAggregator::remove(eventId, aggregates);
+            for (size_t i = 0; i < aggregates.size(); ++i)
+            {
+                addAggregatedDesignEvent(aggregates[i]);
+            }
+        }
+
+        void GAEvents::flushAggregatedDesignEvents(bool all)
+        {
+            std::vector<GAAggregatedDesignEvent> aggregates;
+            GAEventAggregator::takeClosedWindows(utilities::GAUtilities::timeIntervalSince1970(), all, aggregates);
+            for (size_t i = 0; i < aggregates.size(); ++i)
+            {
+                addAggregatedDesignEvent(aggregates[i]);
+            }
+        }
+
+        void GAEvents::addAggregatedDesignEvent(const GAAggregatedDesignEvent& aggregate)
+        {
+            if(!state::GAState::isEventSubmissionEnabled())
+            {
+                return;
+            }
+
+            // Create empty eventData
+            rapidjson::Document eventData;
+            eventData.SetObject();
+            rapidjson::Document::AllocatorType& allocator = eventData.GetAllocator();
+
+            eventData.AddMember("category", rapidjson::StringRef(GAEvents::CategoryDesign), allocator);
+            {
+                rapidjson::Value v(aggregate.eventId.c_str(), allocator);
+                eventData.AddMember("event_id", v.Move(), allocator);
+            }
+            eventData.AddMember("value", aggregate.sum, allocator);
+
+            // count, min, max and the histogram go into custom fields
+            EventFields fields;
+            fields.add("agg_count", aggregate.count);
+            fields.add("agg_min", aggregate.min);
+            fields.add("agg_max", aggregate.max);
+            fields.add("agg_window", static_cast<double>(aggregate.windowSeconds));
+            for (size_t i = 0; i < aggregate.histogram.size(); ++i)
+            {
+                char key[16] = "";
+                snprintf(key, sizeof(key), "agg_bucket_%02d", static_cast<int>(i));
+                fields.add(key, aggregate.histogram[i]);
+            }
+            GAEvents::addFieldsToEvent(eventData, fields);
+
+            // Dimensions that were active while the values were added
+            if (!aggregate.dimension01.empty())
+            {
+                rapidjson::Value v(aggregate.dimension01.c_str(), allocator);
+                eventData.AddMember("custom_01", v.Move(), allocator);
+            }
+            if (!aggregate.dimension02.empty())
+            {
+                rapidjson::Value v(aggregate.dimension02.c_str(), allocator);
+                eventData.AddMember("custom_02", v.Move(), allocator);
+            }
+            if (!aggregate.dimension03.empty())
+            {
+                rapidjson::Value v(aggregate.dimension03.c_str(), allocator);
+                eventData.AddMember("custom_03", v.Move(), allocator);
             }
 
             // Log
-            logging::GALogger::i("Add ERROR event: {severity:%s, message:%s, fields:%s}", severityString, message, buffer.GetString());
+            GA_LOG_INFO("Add DESIGN event (aggregated): {eventId:%s, count:%u, sum:%f, min:%f, max:%f}", aggregate.eventId.c_str(), aggregate.count, aggregate.sum, aggregate.min, aggregate.max);
 
             // Send to store
             addEventToStore(eventData);
@@ -564,6 +763,7 @@ namespace gameanalytics
 
         void GAEvents::processEventQueue()
         {
+            flushAggregatedDesignEvents(false);
             processEvents("", true);
             GAEvents* i = GAEvents::getInstance();
             if(!i)
@@ -572,7 +772,16 @@ namespace gameanalytics
             }
             if (i->keepRunning)
             {
-                threading::GAThreading::scheduleTimer(GAEvents::ProcessEventsIntervalInSeconds, processEventQueue);
+                size_t backlog = 0;
+                size_t total = 0;
+                countEvents(backlog, total);
+                // the gauge is process wide, other clients have stores of their own
+                if(!client::GAClientContext::current())
+                {
+                    metrics::GAMetrics::setStoreSize(store::GAStore::getDbSizeBytes(), total);
+                }
+                double interval = std::max(i->batchController.sendInterval(backlog), i->circuitBreaker.retryDelay(monotonicSeconds()));
+                threading::GAThreading::scheduleTimer(interval, processEventQueue);
             }
             else
             {
@@ -587,83 +796,117 @@ namespace gameanalytics
                 return;
             }
 
-            // Request identifier
-            char requestIdentifier[65] = "";
-            utilities::GAUtilities::generateUUID(requestIdentifier);
-
-            char selectSql[129] = "";
-            char updateSql[257] = "";
-            char deleteSql[129] = "";
-            snprintf(deleteSql, sizeof(deleteSql), "DELETE FROM ga_events WHERE status = '%s'", requestIdentifier);
-            char putbackSql[129] = "";
-            snprintf(putbackSql, sizeof(putbackSql), "UPDATE ga_events SET status = 'new' WHERE status = '%s';", requestIdentifier);
+            GAEvents* i = GAEvents::getInstance();
+            if(!i)
+            {
+                return;
+            }
 
-            // Cleanup
-            if (performCleanup)
+            // Cleanup, this puts claimed events back so not while batches are in flight
+            if (performCleanup && i->inFlightBatches == 0)
             {
                 cleanupEvents();
-                fixMissingSessionEndEvents();
             }
 
-            // Prepare SQL
-            char andCategory[65] = "";
-            if (strlen(category) > 0)
+            // Each batch claims its own events, a full batch means more are waiting.
+            // While the collector fails the breaker holds batches back and only lets a small probe through.
+            while (i->inFlightBatches < i->maxInFlightBatches && i->circuitBreaker.allowSend(monotonicSeconds()))
             {
-                snprintf(andCategory, sizeof(andCategory), " AND category='%s' ", category);
+                i->circuitState = i->circuitBreaker.state();
+                int batchSize = i->circuitBreaker.maxBatchSize(i->batchController.batchSize());
+                size_t eventCount = sendEventBatch(category, batchSize);
+                if (eventCount == 0)
+                {
+                    i->circuitBreaker.cancelProbe();
+                    break;
+                }
+                if (eventCount < static_cast<size_t>(batchSize) || i->circuitBreaker.state() != CircuitClosed)
+                {
+                    break;
+                }
             }
-            snprintf(selectSql, sizeof(selectSql), "SELECT event FROM ga_events WHERE status = 'new' %s;", andCategory);
-            snprintf(updateSql, sizeof(updateSql), "UPDATE ga_events SET status = '%s' WHERE status = 'new' %s;", requestIdentifier, andCategory);
+        }
 
-            // Get events to process
-            rapidjson::Document events;
-            store::GAStore::executeQuerySync(selectSql, events);
+        EGACircuitState GAEvents::getCircuitState()
+        {
+            GAEvents* i = GAEvents::getInstance();
+            if(!i)
+            {
+                return CircuitClosed;
+            }
 
-            // Check for errors or empty
-            if (events.IsNull() || events.Size() == 0)
+            return static_cast<EGACircuitState>(i->circuitState.load());
+        }
+
+        void GAEvents::setMaxInFlightBatches(int maxInFlightBatches)
+        {
+            GAEvents* i = GAEvents::getInstance();
+            if(!i)
             {
-                logging::GALogger::i("Event queue: No events to send");
-                GAEvents::updateSessionTime();
                 return;
             }
 
-            // Check number of events and take some action if there are too many?
-            if (events.Size() > GAEvents::MaxEventCount)
+            i->maxInFlightBatches = std::max(1, std::min(maxInFlightBatches, GAEvents::MaxInFlightBatchesLimit));
+        }
+
+        size_t GAEvents::sendEventBatch(const char* category, int batchSize)
+        {
+            GAEvents* i = GAEvents::getInstance();
+            if(!i)
             {
-                // Make a limit request
-                snprintf(selectSql, sizeof(selectSql), "SELECT client_ts FROM ga_events WHERE status = 'new' %s ORDER BY client_ts ASC LIMIT 0,%d;", andCategory, GAEvents::MaxEventCount);
-                store::GAStore::executeQuerySync(selectSql, events);
-                if (events.IsNull())
-                {
-                    return;
-                }
+                return 0;
+            }
+            http::GAHTTPApi* http = http::GAHTTPApi::getInstance();
+            if(!http)
+            {
+                return 0;
+            }
 
-                // Get last timestamp
-                const rapidjson::Value& lastItem = events[events.Size() - 1];
-                const char* lastTimestamp = lastItem["client_ts"].GetString();
+            // Request identifier
+            char requestIdentifier[65] = "";
+            utilities::GAUtilities::generateUUID(requestIdentifier);
 
-                // Select again
-                snprintf(selectSql, sizeof(selectSql), "SELECT event FROM ga_events WHERE status = 'new' %s AND client_ts<='%s';", andCategory, lastTimestamp);
-                store::GAStore::executeQuerySync(selectSql, events);
-                if (events.IsNull())
-                {
-                    return;
-                }
+            char selectSql[129] = "";
+            char updateSql[385] = "";
 
-                // Update sql
-                snprintf(updateSql, sizeof(updateSql), "UPDATE ga_events SET status='%s' WHERE status='new' %s AND client_ts<='%s';", requestIdentifier, andCategory, lastTimestamp);
+            // Prepare SQL
+            char andCategory[65] = "";
+            if (strlen(category) > 0)
+            {
+                snprintf(andCategory, sizeof(andCategory), " AND category='%s' ", category);
             }
 
-            // Log
-            logging::GALogger::i("Event queue: Sending %d events.", events.Size());
+            // Claim the oldest events first so the batch has exactly the size that was asked for
+            snprintf(updateSql, sizeof(updateSql), "UPDATE ga_events SET status = '%s' WHERE rowid IN (SELECT rowid FROM ga_events WHERE status = 'new' %s ORDER BY client_ts ASC LIMIT %d);", requestIdentifier, andCategory, batchSize);
+            snprintf(selectSql, sizeof(selectSql), "SELECT event FROM ga_events WHERE status = '%s';", requestIdentifier);
 
             // Set status of events to 'sending' (also check for error)
             rapidjson::Document updateResult;
             store::GAStore::executeQuerySync(updateSql, updateResult);
             if (updateResult.IsNull())
             {
-                return;
+                return 0;
+            }
+
+            // Get events to process
+            rapidjson::Document events;
+            store::GAStore::executeQuerySync(selectSql, events);
+
+            // Check for errors or empty
+            if (events.IsNull() || events.Size() == 0)
+            {
+                GA_LOG_INFO("Event queue: No events to send");
+                GAEvents::updateSessionTime();
+                return 0;
             }
 
+            // Log
+            GA_LOG_INFO("Event queue: Sending %d events.", events.Size());
+
+            size_t eventCount = events.Size();
+            bool fullBatch = eventCount >= static_cast<size_t>(batchSize);
+            metrics::GAMetrics::record(metrics::BatchSize, static_cast<double>(eventCount));
+
             // Create payload data from events
             rapidjson::Document payloadArray;
             payloadArray.SetArray();
@@ -678,8 +921,8 @@ namespace gameanalytics
                     rapidjson::ParseResult ok = d.Parse(eventDict);
                     if(!ok)
                     {
-                        logging::GALogger::d("processEvents -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
-                        logging::GALogger::d("%s", eventDict);
+                        GA_LOG_DEBUG("processEvents -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
+                        GA_LOG_DEBUG("%s", eventDict);
                     }
                     else
                     {
@@ -690,21 +933,29 @@ namespace gameanalytics
                 }
             }
 
-            rapidjson::StringBuffer buffer;
+            // Nothing could be parsed, the claimed rows would never send
+            if (payloadArray.Empty())
             {
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-                payloadArray.Accept(writer);
+                logging::GALogger::w("Event queue: Dropping %d events that could not be parsed", (int)eventCount);
+                char deleteSql[129] = "";
+                snprintf(deleteSql, sizeof(deleteSql), "DELETE FROM ga_events WHERE status = '%s';", requestIdentifier);
+                store::GAStore::executeQuerySync(deleteSql);
+                return 0;
             }
 
             // send events
-            rapidjson::Value dataDict(rapidjson::kArrayType);
-            http::EGAHTTPApiResponse responseEnum;
-            http::GAHTTPApi* http = http::GAHTTPApi::getInstance();
-            if(!http)
+            i->inFlightBatches++;
+#if USE_UWP || NO_ASYNC
+            rapidjson::StringBuffer buffer;
             {
-                return;
+                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+                payloadArray.Accept(writer);
             }
+            std::chrono::steady_clock::time_point sendStart = std::chrono::steady_clock::now();
+#endif
 #if USE_UWP
+            rapidjson::Value dataDict(rapidjson::kArrayType);
+            http::EGAHTTPApiResponse responseEnum;
             std::pair<http::EGAHTTPApiResponse, std::string> pair;
 
             try
@@ -722,24 +973,106 @@ namespace gameanalytics
                 rapidjson::ParseResult ok = d.Parse(pair.second.c_str());
                 if(!ok)
                 {
-                    logging::GALogger::d("processEvents -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
-                    logging::GALogger::d("%s", pair.second.c_str());
+                    GA_LOG_DEBUG("processEvents -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
+                    GA_LOG_DEBUG("%s", pair.second.c_str());
                 }
                 else
                 {
                     dataDict.CopyFrom(d, d.GetAllocator());
                 }
             }
-#else
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - sendStart).count();
+            // the compressed size is not known here, the JSON size is an upper bound
+            onEventsSent(requestIdentifier, eventCount, buffer.GetSize(), seconds, responseEnum, dataDict);
+#elif NO_ASYNC
+            rapidjson::Value dataDict(rapidjson::kArrayType);
+            http::EGAHTTPApiResponse responseEnum;
             http->sendEventsInArray(responseEnum, dataDict, payloadArray);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - sendStart).count();
+            // the compressed size is not known here, the JSON size is an upper bound
+            onEventsSent(requestIdentifier, eventCount, buffer.GetSize(), seconds, responseEnum, dataDict);
+#else
+            std::array<char, 65> requestId = {'\0'};
+            snprintf(requestId.data(), requestId.size(), "%s", requestIdentifier);
+            http->sendEventsInArrayAsync(payloadArray, [requestId, eventCount, fullBatch](http::EGAHTTPApiResponse responseEnum, const char* body, size_t payloadBytes, double seconds)
+            {
+                // runs on the sender thread, the store is only used from the GA thread
+                std::string responseBody(body ? body : "");
+                threading::GAThreading::performTaskOnGAThread([requestId, eventCount, fullBatch, responseEnum, responseBody, payloadBytes, seconds]()
+                {
+                    rapidjson::Document dataDict;
+                    if(!responseBody.empty())
+                    {
+                        rapidjson::ParseResult ok = dataDict.Parse(responseBody.c_str());
+                        if(!ok)
+                        {
+                            GA_LOG_DEBUG("processEvents -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
+                            GA_LOG_DEBUG("%s", responseBody.c_str());
+                            dataDict.SetNull();
+                        }
+                    }
+                    onEventsSent(requestId.data(), eventCount, payloadBytes, seconds, responseEnum, dataDict);
+
+                    // keep draining a backlog instead of waiting for the next tick
+                    if (responseEnum == http::Ok && fullBatch)
+                    {
+                        processEvents("", false);
+                    }
+                });
+            });
 #endif
 
+            return eventCount;
+        }
+
+        void GAEvents::onEventsSent(const char* requestIdentifier, size_t eventCount, size_t payloadBytes, double seconds, http::EGAHTTPApiResponse responseEnum, const rapidjson::Value& dataDict)
+        {
+            GAEvents* i = GAEvents::getInstance();
+            if(!i)
+            {
+                return;
+            }
+            i->inFlightBatches--;
+
+            bool delivered = responseEnum != http::NoResponse && responseEnum != http::RequestTimeout && responseEnum != http::InternalServerError;
+            i->batchController.onBatchSent(eventCount, payloadBytes, seconds, delivered);
+            if (responseEnum != http::NoResponse)
+            {
+                metrics::GAMetrics::record(metrics::HttpTime, 1000 * seconds);
+            }
+
+            EGACircuitState previousState = i->circuitBreaker.state();
+            if (delivered)
+            {
+                i->circuitBreaker.onSuccess();
+            }
+            else
+            {
+                i->circuitBreaker.onFailure(monotonicSeconds());
+            }
+            EGACircuitState state = i->circuitBreaker.state();
+            i->circuitState = state;
+            if (state == CircuitOpen && previousState != CircuitOpen)
+            {
+                logging::GALogger::w("Event queue: Collector unreachable, pausing for %.0f seconds", i->circuitBreaker.retryDelay(monotonicSeconds()));
+            }
+            else if (state == CircuitClosed && previousState != CircuitClosed)
+            {
+                GA_LOG_INFO("Event queue: Collector reachable again, resuming");
+            }
+
+            char deleteSql[129] = "";
+            snprintf(deleteSql, sizeof(deleteSql), "DELETE FROM ga_events WHERE status = '%s'", requestIdentifier);
+            char putbackSql[129] = "";
+            snprintf(putbackSql, sizeof(putbackSql), "UPDATE ga_events SET status = 'new' WHERE status = '%s';", requestIdentifier);
+
             if (responseEnum == http::Ok)
             {
                 // Delete events
                 store::GAStore::executeQuerySync(deleteSql);
+                metrics::GAMetrics::add(metrics::EventsSent, eventCount);
 
-                logging::GALogger::i("Event queue: %d events sent.", events.Size());
+                GA_LOG_INFO("Event queue: %d events sent.", (int)eventCount);
             }
             else
             {
@@ -748,17 +1081,22 @@ namespace gameanalytics
                 {
                     logging::GALogger::w("Event queue: Failed to send events to collector - Retrying next time");
                     store::GAStore::executeQuerySync(putbackSql);
+                    metrics::GAMetrics::add(metrics::BatchRetries);
                     // Delete events (When getting some anwser back always assume events are processed)
                 }
                 else
                 {
                     if (responseEnum == http::BadRequest && dataDict.IsArray())
                     {
-                        logging::GALogger::w("Event queue: %d events sent. %d events failed GA server validation.", events.Size(), dataDict.Size());
+                        logging::GALogger::w("Event queue: %d events sent. %d events failed GA server validation.", (int)eventCount, dataDict.Size());
+                        size_t rejected = std::min<size_t>(dataDict.Size(), eventCount);
+                        metrics::GAMetrics::add(metrics::EventsSent, eventCount - rejected);
+                        metrics::GAMetrics::add(metrics::EventsRejected, rejected);
                     }
                     else
                     {
                         logging::GALogger::w("Event queue: Failed to send events.");
+                        metrics::GAMetrics::add(metrics::EventsRejected, eventCount);
                     }
 
                     store::GAStore::executeQuerySync(deleteSql);
@@ -792,6 +1130,35 @@ namespace gameanalytics
             }
         }
 
+        void GAEvents::countEvents(size_t& backlog_out, size_t& total_out)
+        {
+            backlog_out = 0;
+            total_out = 0;
+
+            // one row for the new events and one for the claimed ones
+            rapidjson::Document result;
+            store::GAStore::executeQuerySync("SELECT status = 'new' AS ready, COUNT(*) AS count FROM ga_events GROUP BY ready;", result);
+            if (result.IsNull() || !result.IsArray())
+            {
+                return;
+            }
+
+            for (rapidjson::Value::ConstValueIterator itr = result.Begin(); itr != result.End(); ++itr)
+            {
+                const rapidjson::Value& row = *itr;
+                if (!row.HasMember("count") || !row["count"].IsInt() || !row.HasMember("ready") || !row["ready"].IsInt())
+                {
+                    continue;
+                }
+                size_t count = static_cast<size_t>(std::max(0, row["count"].GetInt()));
+                total_out += count;
+                if (row["ready"].GetInt() != 0)
+                {
+                    backlog_out += count;
+                }
+            }
+        }
+
         void GAEvents::cleanupEvents()
         {
             store::GAStore::executeQuerySync("UPDATE ga_events SET status = 'new';");
@@ -816,7 +1183,7 @@ namespace gameanalytics
                 return;
             }
 
-            logging::GALogger::i("%d session(s) located with missing session_end event.", sessions.Size());
+            GA_LOG_INFO("%d session(s) located with missing session_end event.", sessions.Size());
 
             // Add missing session_end events
             for (rapidjson::Value::ConstValueIterator itr = sessions.Begin(); itr != sessions.End(); ++itr)
@@ -828,12 +1195,12 @@ namespace gameanalytics
                     rapidjson::ParseResult ok = sessionEndEvent.Parse(session["event"].GetString());
                     if(!ok)
                     {
-                        logging::GALogger::d("fixMissingSessionEndEvents -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
-                        logging::GALogger::d("%s", session["event"].GetString());
+                        GA_LOG_DEBUG("fixMissingSessionEndEvents -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
+                        GA_LOG_DEBUG("%s", session["event"].GetString());
                     }
                     if(!ok)
                     {
-                        logging::GALogger::d("JSON parse error: %s (%u)", rapidjson::GetParseError_En(ok.Code()), ok.Offset());
+                        GA_LOG_DEBUG("JSON parse error: %s (%u)", rapidjson::GetParseError_En(ok.Code()), ok.Offset());
                     }
 
                     rapidjson::Document::AllocatorType& allocator = sessionEndEvent.GetAllocator();
@@ -843,7 +1210,7 @@ namespace gameanalytics
                     int64_t length = event_ts - start_ts;
                     length = static_cast<int64_t>(fmax(length, 0));
 
-                    logging::GALogger::d("fixMissingSessionEndEvents length calculated: %lld", length);
+                    GA_LOG_DEBUG("fixMissingSessionEndEvents length calculated: %lld", length);
 
                     {
                         rapidjson::Value v(GAEvents::CategorySessionEnd, allocator);
@@ -886,7 +1253,8 @@ namespace gameanalytics
 
             // Check db size limits (10mb)
             // If database is too large block all except user, session and business
-            if (store::GAStore::isDbTooLargeForEvents() && !utilities::GAUtilities::stringMatch(eventData["category"].GetString(), "^(user|session_end|business)$"))
+            const char* category = eventData["category"].GetString();
+            if (store::GAStore::isDbTooLargeForEvents() && strcmp(category, CategorySessionStart) != 0 && strcmp(category, CategorySessionEnd) != 0 && strcmp(category, CategoryBusiness) != 0)
             {
                 logging::GALogger::w("Database too large. Event has been blocked.");
                 http::GAHTTPApi* httpInstance = http::GAHTTPApi::getInstance();
@@ -929,7 +1297,7 @@ namespace gameanalytics
             const char* json = evBuffer.GetString();
 
             // output if VERBOSE LOG enabled
-            logging::GALogger::ii("Event added to queue: %s", json);
+            GA_LOG_VERBOSE("Event added to queue: %s", json);
 
             // Add to store
             char client_ts[21] = "";
@@ -937,7 +1305,12 @@ namespace gameanalytics
             const char* parameters[] = { "new", ev["category"].GetString(), ev["session_id"].GetString(), client_ts, json };
             const char* sql = "INSERT INTO ga_events (status, category, session_id, client_ts, event) VALUES(?, ?, ?, ?, ?);";
 
-            store::GAStore::executeQuerySync(sql, parameters, 5);
+            rapidjson::Document insertResult;
+            store::GAStore::executeQuerySync(sql, parameters, 5, insertResult);
+            if (!insertResult.IsNull())
+            {
+                metrics::GAMetrics::add(metrics::EventsStored);
+            }
 
             // Add to session store if not last
             if (strcmp(eventData["category"].GetString(), GAEvents::CategorySessionEnd) == 0)
@@ -986,19 +1359,51 @@ namespace gameanalytics
             }
         }
 
-        void GAEvents::addFieldsToEvent(rapidjson::Document& eventData, rapidjson::Document& fields)
+        void GAEvents::addFieldsToEvent(rapidjson::Document& eventData, const EventFields& fields)
         {
-            if(eventData.IsNull())
+            if(eventData.IsNull() || fields.empty())
             {
                 return;
             }
 
-            if(!fields.ObjectEmpty())
+            // fields were validated when they were added
+            rapidjson::Document::AllocatorType& allocator = eventData.GetAllocator();
+            rapidjson::Value v(rapidjson::kObjectType);
+            for(size_t i = 0; i < fields.size(); ++i)
+            {
+                rapidjson::Value key(fields.keyAt(i), allocator);
+                if(fields.isStringAt(i))
+                {
+                    rapidjson::Value value(fields.stringAt(i), allocator);
+                    v.AddMember(key.Move(), value.Move(), allocator);
+                }
+                else
+                {
+                    v.AddMember(key.Move(), fields.numberAt(i), allocator);
+                }
+            }
+            eventData.AddMember("custom_fields", v, allocator);
+        }
+
+        std::string GAEvents::customFieldsString(const EventFields& fields)
+        {
+            rapidjson::StringBuffer out;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(out);
+            writer.StartObject();
+            for(size_t i = 0; i < fields.size(); ++i)
             {
-                rapidjson::Value v(rapidjson::kObjectType);
-                v.CopyFrom(fields, fields.GetAllocator());
-                eventData.AddMember("custom_fields", v, eventData.GetAllocator());
+                writer.Key(fields.keyAt(i));
+                if(fields.isStringAt(i))
+                {
+                    writer.String(fields.stringAt(i));
+                }
+                else
+                {
+                    writer.Double(fields.numberAt(i));
+                }
             }
+            writer.EndObject();
+            return std::string(out.GetString(), out.GetSize());
         }
 
         void GAEvents::progressionStatusString(EGAProgressionStatus progressionStatus, char* out)
@@ -6,8 +6,17 @@
 #pragma once
 
 #include "GameAnalytics.h"
+#include "GAClient.h"
+#include "GAEventIdTable.h"
+#include "GAEventAggregator.h"
+#include "GAHTTPApi.h"
+#include "GABatchController.h"
+#include "GACircuitBreaker.h"
 #include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
 #include <mutex>
+#include <string>
+#include <atomic>
 #include <cstdlib>
 
 namespace gameanalytics
@@ -21,28 +30,46 @@ namespace gameanalytics
             static void ensureEventQueueIsRunning();
             static void addSessionStartEvent();
             static void addSessionEndEvent();
-            static void addBusinessEvent(const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType, const rapidjson::Value& fields);
-            static void addResourceEvent(EGAResourceFlowType flowType, const char* currency, double amount, const char* itemType, const char* itemId, const rapidjson::Value& fields);
-            static void addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, bool sendScore, const rapidjson::Value& fields);
-            static void addDesignEvent(const char* eventId, double value, bool sendValue, const rapidjson::Value& fields);
-            static void addErrorEvent(EGAErrorSeverity severity, const char* message, const rapidjson::Value& fields);
+            static void addBusinessEvent(const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType, const EventFields& fields);
+            static void addResourceEvent(EGAResourceFlowType flowType, const char* currency, double amount, const char* itemType, const char* itemId, const EventFields& fields);
+            static void addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, bool sendScore, const EventFields& fields);
+            static void addProgressionEvent(EGAProgressionStatus progressionStatus, uint32_t progressionHandle, int score, bool sendScore, const EventFields& fields);
+            static void addDesignEvent(const char* eventId, double value, bool sendValue, const EventFields& fields);
+            static void addDesignEvent(uint32_t eventIdHandle, double value, bool sendValue, const EventFields& fields);
+            static void addErrorEvent(EGAErrorSeverity severity, const char* message, const EventFields& fields);
+            static void removeDesignEventAggregation(const char* eventId);
+            static void flushAggregatedDesignEvents(bool all);
             static void progressionStatusString(EGAProgressionStatus progressionStatus, char* out);
             static void errorSeverityString(EGAErrorSeverity errorSeverity, char* out);
             static void resourceFlowTypeString(EGAResourceFlowType flowType, char* out);
             static void processEvents(const char* category, bool performCleanUp);
+            static void setMaxInFlightBatches(int maxInFlightBatches);
+            static EGACircuitState getCircuitState();
+            // ends the sessions an earlier run left open, call before any session starts
+            static void fixMissingSessionEndEvents();
 
         private:
             GAEvents();
             ~GAEvents();
             GAEvents(const GAEvents&) = delete;
             GAEvents& operator=(const GAEvents&) = delete;
+            friend class client::GAClientContext;
 
             static void processEventQueue();
+            static size_t sendEventBatch(const char* category, int batchSize);
+            static void onEventsSent(const char* requestIdentifier, size_t eventCount, size_t payloadBytes, double seconds, http::EGAHTTPApiResponse responseEnum, const rapidjson::Value& dataDict);
+            // backlog counts the events not claimed by a batch, total also the ones in flight
+            static void countEvents(size_t& backlog_out, size_t& total_out);
             static void cleanupEvents();
-            static void fixMissingSessionEndEvents();
+            static void addProgressionEvent(EGAProgressionStatus progressionStatus, const GAEventIdEntry& entry, const char* eventId, int score, bool sendScore, const EventFields& fields);
+            static void addDesignEvent(const GAEventIdEntry& entry, double value, bool sendValue, const EventFields& fields);
+            static bool isSampledOut(const char* category, const char* eventId);
+            static void addAggregatedDesignEvent(const GAAggregatedDesignEvent& aggregate);
             static void addEventToStore(const rapidjson::Value& eventData);
             static void addDimensionsToEvent(rapidjson::Document& eventData);
-            static void addFieldsToEvent(rapidjson::Document& eventData, rapidjson::Document& fields);
+            static void addFieldsToEvent(rapidjson::Document& eventData, const EventFields& fields);
+            // only for logging, pass it as a GA_LOG_* argument so it is not built when the level is off
+            static std::string customFieldsString(const EventFields& fields);
             static void updateSessionTime();
 
             static const char* CategorySessionStart;
@@ -53,7 +80,8 @@ namespace gameanalytics
             static const char* CategoryResource;
             static const char* CategoryError;
             static const double ProcessEventsIntervalInSeconds;
-            static const int MaxEventCount;
+            static const int DefaultMaxInFlightBatches;
+            static const int MaxInFlightBatchesLimit;
 
             static bool _destroyed;
             static GAEvents* _instance;
@@ -72,6 +100,13 @@ namespace gameanalytics
 
             bool isRunning;
             bool keepRunning;
+            // only used on the GA thread
+            int inFlightBatches;
+            int maxInFlightBatches;
+            GABatchController batchController;
+            GACircuitBreaker circuitBreaker;
+            // copy of the breaker state for other threads
+            std::atomic<int> circuitState;
         };
     }
 }
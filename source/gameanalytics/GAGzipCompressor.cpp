@@ -0,0 +1,209 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAGzipCompressor.h"
+#include "GALogger.h"
+#include <string.h>
+#include <algorithm>
+
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "miniz.c"
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        const int GAGzipCompressor::MinLevel = 1;
+        const int GAGzipCompressor::MaxLevel = 9;
+        const int GAGzipCompressor::DefaultLevel = 5;
+
+        // https://tools.ietf.org/html/rfc1952
+        static const unsigned char GzipHeader[10] =
+        {
+            0x1f, 0x8b, MZ_DEFLATED, 0,
+            0, 0, 0, 0, /* mtime */
+            0, 0x03 /* Unix OS_CODE */
+        };
+        static const size_t GzipTrailerSize = 8;
+        static const size_t SinkChunkSize = 16 * 1024;
+
+        struct GAGzipCompressor::Stream
+        {
+            mz_stream zs;
+            bool initialized;
+        };
+
+        static void writeLittleEndian(unsigned char* out, mz_ulong v)
+        {
+            out[0] = static_cast<unsigned char>(v & 0xff);
+            out[1] = static_cast<unsigned char>((v >> 8) & 0xff);
+            out[2] = static_cast<unsigned char>((v >> 16) & 0xff);
+            out[3] = static_cast<unsigned char>((v >> 24) & 0xff);
+        }
+
+        GAGzipCompressor::GAGzipCompressor():
+            _stream(new Stream()),
+            _level(DefaultLevel),
+            _strategy(CompressionDefault),
+            _reinitialize(true)
+        {
+            memset(&_stream->zs, 0, sizeof(_stream->zs));
+            _stream->initialized = false;
+        }
+
+        GAGzipCompressor::~GAGzipCompressor()
+        {
+            if(_stream->initialized)
+            {
+                mz_deflateEnd(&_stream->zs);
+            }
+            delete _stream;
+        }
+
+        bool GAGzipCompressor::setLevel(int level)
+        {
+            if(level < MinLevel || level > MaxLevel)
+            {
+                return false;
+            }
+            _reinitialize = _reinitialize || level != _level;
+            _level = level;
+            return true;
+        }
+
+        void GAGzipCompressor::setStrategy(EGACompressionStrategy strategy)
+        {
+            _reinitialize = _reinitialize || strategy != _strategy;
+            _strategy = strategy;
+        }
+
+        bool GAGzipCompressor::prepareStream()
+        {
+            if(_stream->initialized && !_reinitialize)
+            {
+                // keeps the compressor state allocation and only clears it
+                return mz_deflateReset(&_stream->zs) == MZ_OK;
+            }
+
+            if(_stream->initialized)
+            {
+                mz_deflateEnd(&_stream->zs);
+                _stream->initialized = false;
+            }
+            memset(&_stream->zs, 0, sizeof(_stream->zs));
+
+            // negative window bits for raw deflate, the gzip wrapper is written here
+            if(mz_deflateInit2(&_stream->zs, _level, MZ_DEFLATED, -MZ_DEFAULT_WINDOW_BITS, 9, static_cast<int>(_strategy)) != MZ_OK)
+            {
+                return false;
+            }
+            _stream->initialized = true;
+            _reinitialize = false;
+            return true;
+        }
+
+        bool GAGzipCompressor::compress(const char* data, size_t size, std::vector<char>& out)
+        {
+            return compress(data, size, out, OutputSink());
+        }
+
+        bool GAGzipCompressor::compress(const char* data, size_t size, std::vector<char>& out, const OutputSink& sink)
+        {
+            out.clear();
+            if(!prepareStream())
+            {
+                logging::GALogger::e("Gzip: could not initialise the deflate stream");
+                return false;
+            }
+
+            mz_stream& zs = _stream->zs;
+            out.resize(sizeof(GzipHeader) + mz_deflateBound(&zs, static_cast<mz_ulong>(size)) + GzipTrailerSize);
+            memcpy(out.data(), GzipHeader, sizeof(GzipHeader));
+            if(sink)
+            {
+                sink(out.data(), sizeof(GzipHeader));
+            }
+
+            zs.next_in = reinterpret_cast<const unsigned char*>(data);
+            zs.avail_in = static_cast<unsigned int>(size);
+            size_t written = sizeof(GzipHeader);
+            int ret = MZ_OK;
+            while(true)
+            {
+                size_t capacity = out.size() - GzipTrailerSize - written;
+                if(capacity == 0)
+                {
+                    // the bound is conservative, this only happens if it is wrong
+                    out.resize(out.size() + out.size() / 2);
+                    continue;
+                }
+
+                // small steps so the sink reads the output while it is still in cache
+                zs.next_out = reinterpret_cast<unsigned char*>(out.data()) + written;
+                zs.avail_out = static_cast<unsigned int>(sink ? std::min(capacity, SinkChunkSize) : capacity);
+                ret = mz_deflate(&zs, MZ_FINISH);
+
+                size_t produced = sizeof(GzipHeader) + zs.total_out - written;
+                if(sink && produced > 0)
+                {
+                    sink(out.data() + written, produced);
+                }
+                written += produced;
+
+                if(ret == MZ_STREAM_END || (ret != MZ_OK && ret != MZ_BUF_ERROR) || (ret == MZ_BUF_ERROR && produced == 0))
+                {
+                    break;
+                }
+            }
+
+            if(ret != MZ_STREAM_END)
+            {
+                logging::GALogger::e("Exception during zlib compression: (%d) %s", ret, zs.msg ? zs.msg : "");
+                out.clear();
+                return false;
+            }
+
+            // miniz only keeps an adler32 of the input, gzip needs a crc32
+            unsigned char* trailer = reinterpret_cast<unsigned char*>(out.data()) + written;
+            writeLittleEndian(trailer, mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const unsigned char*>(data), size));
+            writeLittleEndian(trailer + 4, static_cast<mz_ulong>(size & 0xffffffff));
+            out.resize(written + GzipTrailerSize);
+            if(sink)
+            {
+                sink(out.data() + written, GzipTrailerSize);
+            }
+            return true;
+        }
+
+        int GAGzipCompressor::adaptiveLevel(int currentLevel, double linkBytesPerSecond, double lastCompressSeconds, double cpuBudgetSeconds)
+        {
+            int target = DefaultLevel;
+            if(linkBytesPerSecond >= 1024 * 1024)
+            {
+                target = MinLevel;
+            }
+            else if(linkBytesPerSecond > 0 && linkBytesPerSecond < 64 * 1024)
+            {
+                target = MaxLevel;
+            }
+
+            int level = std::max(MinLevel, std::min(MaxLevel, currentLevel));
+            if(lastCompressSeconds > cpuBudgetSeconds)
+            {
+                level--;
+            }
+            else if(level < target && lastCompressSeconds < cpuBudgetSeconds / 2)
+            {
+                level++;
+            }
+            else if(level > target)
+            {
+                level--;
+            }
+            return std::max(MinLevel, std::min(MaxLevel, level));
+        }
+    }
+}
@@ -0,0 +1,64 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics.h"
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        // Gzip compressor that keeps its deflate state between payloads. The
+        // header, deflate output and trailer are written into one buffer that
+        // is sized up front, so a batch costs a single allocation at most.
+        // Not thread safe, use one instance per thread or lock around it.
+        class GAGzipCompressor
+        {
+        public:
+            static const int MinLevel;
+            static const int MaxLevel;
+            static const int DefaultLevel;
+
+            // receives the output in order while it is produced
+            typedef std::function<void(const char* data, size_t size)> OutputSink;
+
+            GAGzipCompressor();
+            ~GAGzipCompressor();
+            GAGzipCompressor(const GAGzipCompressor&) = delete;
+            GAGzipCompressor& operator=(const GAGzipCompressor&) = delete;
+
+            // level 1 (fastest) to 9 (smallest), returns false if out of range
+            bool setLevel(int level);
+            void setStrategy(EGACompressionStrategy strategy);
+            int getLevel() const { return _level; }
+
+            // replaces the content of out with a gzip member (RFC 1952) of data
+            bool compress(const char* data, size_t size, std::vector<char>& out);
+            // same, and passes every piece of output to sink right after it is
+            // written, e.g. to sign the payload while it is still in cache
+            bool compress(const char* data, size_t size, std::vector<char>& out, const OutputSink& sink);
+
+            // Level for the next payload. Fast links gain little from a smaller
+            // body so they get a fast level, slow links the smallest output.
+            // The level only moves one step at a time and goes down while the
+            // last compression took longer than the CPU budget.
+            static int adaptiveLevel(int currentLevel, double linkBytesPerSecond, double lastCompressSeconds, double cpuBudgetSeconds);
+
+        private:
+            bool prepareStream();
+
+            struct Stream;
+            Stream* _stream;
+            int _level;
+            EGACompressionStrategy _strategy;
+            // level or strategy changed since the stream was initialised
+            bool _reinitialize;
+        };
+    }
+}
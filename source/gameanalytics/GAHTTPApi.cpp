@@ -9,17 +9,16 @@
 #include "GALogger.h"
 #include "GAUtilities.h"
 #include "GAValidator.h"
-#include <future>
+#include "GAMetrics.h"
+#include "GAThreading.h"
 #include <utility>
+#include <algorithm>
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/error/en.h"
 #include <string.h>
 #include <stdio.h>
-#if USE_TIZEN
-#include <net_connection.h>
-#endif
-#include <array>
+#include <chrono>
 
 namespace gameanalytics
 {
@@ -66,6 +65,21 @@ namespace gameanalytics
             return size*nmemb;
         }
 
+        struct GAHTTPApi::AsyncRequest
+        {
+            CURL* curl;
+            struct curl_slist* header;
+            ResponseData response;
+            std::vector<char> payloadData;
+            EventsCallback callback;
+            // literal used in the logs
+            const char* requestId;
+#if USE_TIZEN
+            bool connectionCreated;
+            connection_h connection;
+#endif
+        };
+
         bool GAHTTPApi::_destroyed = false;
         GAHTTPApi* GAHTTPApi::_instance = 0;
         std::once_flag GAHTTPApi::_initInstanceFlag;
@@ -75,6 +89,26 @@ namespace gameanalytics
         {
             curl_global_init(CURL_GLOBAL_DEFAULT);
 
+            // DNS results, TLS sessions and open connections are shared by all
+            // requests so a batch every few seconds does not redo the handshakes
+            _share = curl_share_init();
+            if(_share)
+            {
+                curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, &GAHTTPApi::lockShare);
+                curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, &GAHTTPApi::unlockShare);
+                curl_share_setopt(_share, CURLSHOPT_USERDATA, this);
+                curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+                curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+                curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+            }
+            _curl = curl_easy_init();
+            _multi = curl_multi_init();
+            _stopMulti = false;
+            _adaptiveCompression = true;
+            _lastCompressSeconds = 0;
+            _uploadBytesPerSecond = 0;
+            _sdkErrorInFlight = false;
+
             snprintf(GAHTTPApi::baseUrl, sizeof(GAHTTPApi::baseUrl), "%s://%s/%s", protocol, hostName, version);
             snprintf(GAHTTPApi::remoteConfigsBaseUrl, sizeof(GAHTTPApi::remoteConfigsBaseUrl), "%s://%s/remote_configs/%s", protocol, hostName, remoteConfigsVersion);
             // use gzip compression on JSON body
@@ -87,9 +121,124 @@ namespace gameanalytics
 
         GAHTTPApi::~GAHTTPApi()
         {
+            if(_multiThread.joinable())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_multiMtx);
+                    _stopMulti = true;
+                }
+                curl_multi_wakeup(_multi);
+                _multiThread.join();
+            }
+            // unfinished batches stay claimed in the store and are reset on the next start
+            for(size_t i = 0; i < _activeRequests.size(); ++i)
+            {
+                curl_multi_remove_handle(_multi, _activeRequests[i]->curl);
+                releaseAsyncRequest(_activeRequests[i]);
+            }
+            for(size_t i = 0; i < _queuedRequests.size(); ++i)
+            {
+                releaseAsyncRequest(_queuedRequests[i]);
+            }
+            for(size_t i = 0; i < _idleHandles.size(); ++i)
+            {
+                curl_easy_cleanup(_idleHandles[i]);
+            }
+            if(_multi)
+            {
+                curl_multi_cleanup(_multi);
+            }
+            if(_curl)
+            {
+                curl_easy_cleanup(_curl);
+            }
+            if(_share)
+            {
+                curl_share_cleanup(_share);
+            }
             curl_global_cleanup();
         }
 
+        void GAHTTPApi::lockShare(CURL*, curl_lock_data data, curl_lock_access, void* userptr)
+        {
+            GAHTTPApi* api = static_cast<GAHTTPApi*>(userptr);
+            if(data >= 0 && data < CURL_LOCK_DATA_LAST)
+            {
+                api->_shareMtx[data].lock();
+            }
+        }
+
+        void GAHTTPApi::unlockShare(CURL*, curl_lock_data data, void* userptr)
+        {
+            GAHTTPApi* api = static_cast<GAHTTPApi*>(userptr);
+            if(data >= 0 && data < CURL_LOCK_DATA_LAST)
+            {
+                api->_shareMtx[data].unlock();
+            }
+        }
+
+        GAHTTPApi::CurlRequest::CurlRequest(GAHTTPApi* api):
+            api(api),
+            curl(NULL),
+            pooled(false),
+            header(NULL)
+#if USE_TIZEN
+            ,connectionCreated(false)
+#endif
+        {
+            if(api->_curl && api->_curlMtx.try_lock())
+            {
+                // keeps the connection, DNS and TLS session caches of the handle
+                curl_easy_reset(api->_curl);
+                curl = api->_curl;
+                pooled = true;
+            }
+            else
+            {
+                curl = curl_easy_init();
+            }
+
+            initResponseData(&response);
+
+            if(curl)
+            {
+                if(api->_share)
+                {
+                    curl_easy_setopt(curl, CURLOPT_SHARE, api->_share);
+                }
+                curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+                curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writefunc);
+                curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+            }
+        }
+
+        GAHTTPApi::CurlRequest::~CurlRequest()
+        {
+#if USE_TIZEN
+            if(connectionCreated)
+            {
+                connection_destroy(connection);
+            }
+#endif
+            if(pooled)
+            {
+                // drop the pointers into this request before it goes away
+                curl_easy_setopt(curl, CURLOPT_HTTPHEADER, NULL);
+                curl_easy_setopt(curl, CURLOPT_WRITEDATA, NULL);
+                api->_curlMtx.unlock();
+            }
+            else if(curl)
+            {
+                curl_easy_cleanup(curl);
+            }
+            if(header)
+            {
+                curl_slist_free_all(header);
+            }
+            free(response.ptr);
+        }
+
         void GAHTTPApi::cleanUp()
         {
             delete _instance;
@@ -104,6 +253,18 @@ namespace gameanalytics
         }
 
         void GAHTTPApi::requestInitReturningDict(EGAHTTPApiResponse& response_out, rapidjson::Document& json_out, const char* configsHash)
+        {
+            InitRequest request;
+            if(!prepareInitRequest(request, configsHash))
+            {
+                response_out = JsonEncodeFailed;
+                json_out.SetNull();
+                return;
+            }
+            sendInitRequest(request, response_out, json_out);
+        }
+
+        bool GAHTTPApi::prepareInitRequest(InitRequest& request_out, const char* configsHash)
         {
             const char* gameKey = state::GAState::getGameKey();
 
@@ -111,7 +272,7 @@ namespace gameanalytics
             char url[513] = "";
             snprintf(url, sizeof(url), "%s/%s?game_key=%s&interval_seconds=0&configs_hash=%s", remoteConfigsBaseUrl, initializeUrlPath, gameKey, configsHash);
 
-            logging::GALogger::d("Sending 'init' URL: %s", url);
+            GA_LOG_DEBUG("Sending 'init' URL: %s", url);
 
             rapidjson::Document initAnnotations;
             initAnnotations.SetObject();
@@ -123,81 +284,81 @@ namespace gameanalytics
                 rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
                 initAnnotations.Accept(writer);
             }
-            const char* JSONstring = buffer.GetString();
 
-            if (strlen(JSONstring) == 0)
+            if (buffer.GetSize() == 0)
             {
-                response_out = JsonEncodeFailed;
-                json_out.SetNull();
-                return;
+                return false;
             }
 
-            std::vector<char> payloadData = createPayloadData(JSONstring, useGzip);
+            request_out.url = url;
+            request_out.json.assign(buffer.GetString(), buffer.GetSize());
+            request_out.gzip = useGzip;
+            request_out.authorization[0] = '\0';
+            request_out.payloadData = createPayloadData(request_out.json.c_str(), request_out.gzip, request_out.authorization);
+            return true;
+        }
 
-            CURL *curl;
-            CURLcode res;
-            curl = curl_easy_init();
-            if(!curl)
+        void GAHTTPApi::sendInitRequest(const InitRequest& initRequest, EGAHTTPApiResponse& response_out, rapidjson::Document& json_out)
+        {
+            const char* url = initRequest.url.c_str();
+            const char* JSONstring = initRequest.json.c_str();
+            const char* authorization = initRequest.authorization;
+            bool gzip = initRequest.gzip;
+            const std::vector<char>& payloadData = initRequest.payloadData;
+
+            long response_code = 0;
+            std::string body;
+            if(!sendWithTransport(TransportInit, url, payloadData, authorization, gzip, response_code, body))
             {
-                response_out = NoResponse;
-                json_out.SetNull();
-                return;
-            }
-
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-
-            struct ResponseData s;
-            initResponseData(&s);
-
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writefunc);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &s);
+                CurlRequest request(this);
+                if(!request.curl)
+                {
+                    response_out = NoResponse;
+                    json_out.SetNull();
+                    return;
+                }
 #if USE_TIZEN
-            connection_h connection;
-            int conn_err;
-            conn_err = connection_create(&connection);
-            if (conn_err != CONNECTION_ERROR_NONE)
-            {
-                response_out = NoResponse;
-                json_out.SetNull();
-                return;
-            }
+                if (connection_create(&request.connection) != CONNECTION_ERROR_NONE)
+                {
+                    response_out = NoResponse;
+                    json_out.SetNull();
+                    return;
+                }
+                request.connectionCreated = true;
 #endif
 
-            std::vector<char> authorization = createRequest(curl, url, payloadData, useGzip);
+                createRequest(request.curl, url, payloadData, authorization, gzip, request.header);
 
-            res = curl_easy_perform(curl);
-            if(res != CURLE_OK)
-            {
-                logging::GALogger::d(curl_easy_strerror(res));
-                response_out = NoResponse;
-                json_out.SetNull();
-                return;
-            }
+                CURLcode res = curl_easy_perform(request.curl);
+                if(res != CURLE_OK)
+                {
+                    GA_LOG_DEBUG(curl_easy_strerror(res));
+                    metrics::GAMetrics::add(metrics::HttpNoResponse);
+                    response_out = NoResponse;
+                    json_out.SetNull();
+                    return;
+                }
 
-            long response_code;
-            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-            curl_easy_cleanup(curl);
+                curl_easy_getinfo(request.curl, CURLINFO_RESPONSE_CODE, &response_code);
+                body = request.response.ptr;
+            }
 
             // process the response
-            logging::GALogger::d("init request content: %s, JSONString: %s", s.ptr, JSONstring);
+            GA_LOG_DEBUG("init request content: %s, JSONString: %s", body.c_str(), JSONstring);
 
             rapidjson::Document requestJsonDict;
-            rapidjson::ParseResult ok = requestJsonDict.Parse(s.ptr);
+            rapidjson::ParseResult ok = requestJsonDict.Parse(body.c_str());
             if(!ok)
             {
-                logging::GALogger::d("requestInitReturningDict -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
-                logging::GALogger::d("%s", s.ptr);
+                GA_LOG_DEBUG("requestInitReturningDict -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
+                GA_LOG_DEBUG("%s", body.c_str());
             }
-            EGAHTTPApiResponse requestResponseEnum = processRequestResponse(response_code, s.ptr, "Init");
-            free(s.ptr);
+            EGAHTTPApiResponse requestResponseEnum = processRequestResponse(response_code, body.c_str(), "Init");
 
             // if not 200 result
             if (requestResponseEnum != Ok && requestResponseEnum != Created && requestResponseEnum != BadRequest)
             {
-                logging::GALogger::d("Failed Init Call. URL: %s, JSONString: %s, Authorization: %s", url, JSONstring, authorization.data());
-#if USE_TIZEN
-                connection_destroy(connection);
-#endif
+                GA_LOG_DEBUG("Failed Init Call. URL: %s, JSONString: %s, Authorization: %s", url, JSONstring, authorization);
                 response_out = requestResponseEnum;
                 json_out.SetNull();
                 return;
@@ -205,10 +366,7 @@ namespace gameanalytics
 
             if (requestJsonDict.IsNull())
             {
-                logging::GALogger::d("Failed Init Call. Json decoding failed");
-#if USE_TIZEN
-                connection_destroy(connection);
-#endif
+                GA_LOG_DEBUG("Failed Init Call. Json decoding failed");
                 response_out = JsonDecodeFailed;
                 json_out.SetNull();
                 return;
@@ -217,14 +375,14 @@ namespace gameanalytics
             // print reason if bad request
             if (requestResponseEnum == BadRequest)
             {
-                rapidjson::StringBuffer buffer;
-                rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-                requestJsonDict.Accept(writer);
-                logging::GALogger::d("Failed Init Call. Bad request. Response: %s", buffer.GetString());
+                if(GA_LOG_DEBUG_ENABLED())
+                {
+                    rapidjson::StringBuffer buffer;
+                    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+                    requestJsonDict.Accept(writer);
+                    GA_LOG_DEBUG("Failed Init Call. Bad request. Response: %s", buffer.GetString());
+                }
                 // return bad request result
-#if USE_TIZEN
-                connection_destroy(connection);
-#endif
                 response_out = requestResponseEnum;
                 json_out.SetNull();
                 return;
@@ -235,18 +393,11 @@ namespace gameanalytics
 
             if (json_out.IsNull())
             {
-#if USE_TIZEN
-                connection_destroy(connection);
-#endif
                 response_out = BadResponse;
                 json_out.SetNull();
                 return;
             }
 
-#if USE_TIZEN
-            connection_destroy(connection);
-#endif
-
             // all ok
             response_out = requestResponseEnum;
         }
@@ -255,7 +406,7 @@ namespace gameanalytics
         {
             if (eventArray.Empty())
             {
-                logging::GALogger::d("sendEventsInArray called with missing eventArray");
+                GA_LOG_DEBUG("sendEventsInArray called with missing eventArray");
                 return;
             }
 
@@ -265,7 +416,7 @@ namespace gameanalytics
             char url[513] = "";
             snprintf(url, sizeof(url), "%s/%s/%s", baseUrl, gameKey, eventsUrlPath);
 
-            logging::GALogger::d("Sending 'events' URL: %s", url);
+            GA_LOG_DEBUG("Sending 'events' URL: %s", url);
 
             // make JSON string from data
             rapidjson::StringBuffer buffer;
@@ -278,87 +429,74 @@ namespace gameanalytics
 
             if (strlen(JSONstring) == 0)
             {
-                logging::GALogger::d("sendEventsInArray JSON encoding failed of eventArray");
+                GA_LOG_DEBUG("sendEventsInArray JSON encoding failed of eventArray");
                 response_out = JsonEncodeFailed;
                 json_out.SetNull();;
                 return;
             }
 
-            std::vector<char> payloadData = createPayloadData(JSONstring, useGzip);
+            char authorization[65] = "";
+            std::vector<char> payloadData = createPayloadData(JSONstring, useGzip, authorization);
 
-            CURL *curl;
-            CURLcode res;
-            curl = curl_easy_init();
-            if(!curl)
+            long response_code = 0;
+            std::string body;
+            if(!sendWithTransport(TransportEvents, url, payloadData, authorization, useGzip, response_code, body))
             {
-                response_out = NoResponse;
-                json_out.SetNull();
-                return;
-            }
-
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-
-            struct ResponseData s;
-            initResponseData(&s);
-
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writefunc);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &s);
+                CurlRequest request(this);
+                if(!request.curl)
+                {
+                    response_out = NoResponse;
+                    json_out.SetNull();
+                    return;
+                }
 #if USE_TIZEN
-            connection_h connection;
-            int conn_err;
-            conn_err = connection_create(&connection);
-            if (conn_err != CONNECTION_ERROR_NONE)
-            {
-                response_out = NoResponse;
-                json_out = rapidjson::Value();
-                return;
-            }
+                if (connection_create(&request.connection) != CONNECTION_ERROR_NONE)
+                {
+                    response_out = NoResponse;
+                    json_out = rapidjson::Value();
+                    return;
+                }
+                request.connectionCreated = true;
 #endif
-            std::vector<char> authorization = createRequest(curl, url, payloadData, useGzip);
+                createRequest(request.curl, url, payloadData, authorization, useGzip, request.header);
 
-            res = curl_easy_perform(curl);
-            if(res != CURLE_OK)
-            {
-                logging::GALogger::d(curl_easy_strerror(res));
-                response_out = NoResponse;
-                json_out.SetNull();
-                return;
-            }
+                CURLcode res = curl_easy_perform(request.curl);
+                if(res != CURLE_OK)
+                {
+                    GA_LOG_DEBUG(curl_easy_strerror(res));
+                    metrics::GAMetrics::add(metrics::HttpNoResponse);
+                    response_out = NoResponse;
+                    json_out.SetNull();
+                    return;
+                }
 
-            long response_code;
-            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-            curl_easy_cleanup(curl);
+                curl_easy_getinfo(request.curl, CURLINFO_RESPONSE_CODE, &response_code);
+                body = request.response.ptr;
+            }
 
-            logging::GALogger::d("body: %s", s.ptr);
+            GA_LOG_DEBUG("body: %s", body.c_str());
 
-            EGAHTTPApiResponse requestResponseEnum = processRequestResponse(response_code, s.ptr, "Events");
+            EGAHTTPApiResponse requestResponseEnum = processRequestResponse(response_code, body.c_str(), "Events");
 
             // if not 200 result
             if (requestResponseEnum != Ok && requestResponseEnum != Created && requestResponseEnum != BadRequest)
             {
-                logging::GALogger::d("Failed Events Call. URL: %s, JSONString: %s, Authorization: %s", url, JSONstring, authorization.data());
-#if USE_TIZEN
-                connection_destroy(connection);
-#endif
+                GA_LOG_DEBUG("Failed Events Call. URL: %s, JSONString: %s, Authorization: %s", url, JSONstring, authorization);
                 response_out = requestResponseEnum;
                 json_out = rapidjson::Value();
             }
 
             // decode JSON
             rapidjson::Document requestJsonDict;
-            rapidjson::ParseResult ok = requestJsonDict.Parse(s.ptr);
+            rapidjson::ParseResult ok = requestJsonDict.Parse(body.c_str());
             if(!ok)
             {
-                logging::GALogger::d("sendEventsInArray -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
-                logging::GALogger::d("%s", s.ptr);
+                GA_LOG_DEBUG("sendEventsInArray -- JSON error (offset %u): %s", (unsigned)ok.Offset(), GetParseError_En(ok.Code()));
+                GA_LOG_DEBUG("%s", body.c_str());
             }
-            free(s.ptr);
 
             if (requestJsonDict.IsNull())
             {
-#if USE_TIZEN
-                connection_destroy(connection);
-#endif
                 response_out = JsonDecodeFailed;
                 json_out = rapidjson::Value();
                 return;
@@ -367,224 +505,542 @@ namespace gameanalytics
             // print reason if bad request
             if (requestResponseEnum == BadRequest)
             {
-                rapidjson::StringBuffer buffer;
-                rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-                requestJsonDict.Accept(writer);
-
-                logging::GALogger::d("Failed Events Call. Bad request. Response: %s", buffer.GetString());
+                if(GA_LOG_DEBUG_ENABLED())
+                {
+                    rapidjson::StringBuffer buffer;
+                    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+                    requestJsonDict.Accept(writer);
+                    GA_LOG_DEBUG("Failed Events Call. Bad request. Response: %s", buffer.GetString());
+                }
 
                 response_out = requestResponseEnum;
                 json_out = rapidjson::Value();
                 return;
             }
 
-#if USE_TIZEN
-            connection_destroy(connection);
-#endif
 
             // return response
             response_out = requestResponseEnum;
             json_out.CopyFrom(requestJsonDict, requestJsonDict.GetAllocator());
         }
 
-        void GAHTTPApi::sendSdkErrorEvent(EGASdkErrorCategory category, EGASdkErrorArea area, EGASdkErrorAction action, EGASdkErrorParameter parameter, const char* reason, const char* gameKey, const char* secretKey)
+        void GAHTTPApi::sendEventsInArrayAsync(const rapidjson::Value& eventArray, const EventsCallback& callback)
         {
-            if(!state::GAState::isEventSubmissionEnabled())
+            if (eventArray.Empty())
             {
+                GA_LOG_DEBUG("sendEventsInArrayAsync called with missing eventArray");
                 return;
             }
 
-            // Validate
-            if (!validators::GAValidator::validateSdkErrorEvent(gameKey, secretKey, category, area, action))
+            auto gameKey = state::GAState::getGameKey();
+
+            // Generate URL
+            char url[513] = "";
+            snprintf(url, sizeof(url), "%s/%s/%s", baseUrl, gameKey, eventsUrlPath);
+
+            GA_LOG_DEBUG("Sending 'events' URL: %s", url);
+
+            // make JSON string from data
+            rapidjson::StringBuffer buffer;
+            {
+                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+                eventArray.Accept(writer);
+            }
+
+            const char* JSONstring = buffer.GetString();
+
+            if (strlen(JSONstring) == 0)
             {
+                GA_LOG_DEBUG("sendEventsInArrayAsync JSON encoding failed of eventArray");
+                callback(JsonEncodeFailed, "", 0, 0);
                 return;
             }
 
-            // Generate URL
+            sendPayloadAsync(TransportEvents, url, JSONstring, "Events", callback);
+        }
 
-            std::array<char, 257> url = {'\0'};
-            snprintf(url.data(), url.size(), "%s/%s/%s", baseUrl, gameKey, eventsUrlPath);
+        void GAHTTPApi::sendPayloadAsync(EGATransportRequestType type, const char* url, const char* JSONstring, const char* requestId, const EventsCallback& clientCallback)
+        {
+            // the response is handled for the client that sent the request
+            EventsCallback callback = clientCallback;
+            if(client::GAClientContext::current())
+            {
+                std::shared_ptr<client::GAClientContext> client = client::GAClientContext::current()->shared_from_this();
+                callback = [client, clientCallback](EGAHTTPApiResponse response, const char* body, size_t payloadBytes, double seconds)
+                {
+                    client::GAClientScope scope(client.get());
+                    clientCallback(response, body, payloadBytes, seconds);
+                };
+            }
 
-            logging::GALogger::d("Sending 'events' URL: %s", url);
+            std::shared_ptr<ITransport> transport = getTransport();
+            if(transport)
+            {
+                char authorization[65] = "";
+                std::vector<char> payloadData = createPayloadData(JSONstring, useGzip, authorization);
+                GATransportRequest transportRequest = {type, url, payloadData.data(), payloadData.size(), authorization, useGzip};
+                size_t payloadBytes = payloadData.size();
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                transport->sendAsync(transportRequest, [this, callback, payloadBytes, start, requestId](const GATransportResponse& response)
+                {
+                    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    GA_LOG_DEBUG("body: %s", response.body.c_str());
+                    callback(processRequestResponse(response.statusCode, response.body.c_str(), requestId), response.body.c_str(), payloadBytes, seconds);
+                });
+                return;
+            }
 
-            rapidjson::Document json;
-            json.SetObject();
-            state::GAState::getSdkErrorEventAnnotations(json);
+            if(!_multi)
+            {
+                callback(NoResponse, "", 0, 0);
+                return;
+            }
 
-            char categoryString[40] = "";
-            sdkErrorCategoryString(category, categoryString);
+            AsyncRequest* request = new AsyncRequest();
+            request->header = NULL;
+            request->callback = callback;
+            request->requestId = requestId;
+            char authorization[65] = "";
+            request->payloadData = createPayloadData(JSONstring, useGzip, authorization);
+            initResponseData(&request->response);
+#if USE_TIZEN
+            request->connectionCreated = connection_create(&request->connection) == CONNECTION_ERROR_NONE;
+#endif
             {
-                rapidjson::Value v(categoryString, json.GetAllocator());
-                json.AddMember("error_category", v.Move(), json.GetAllocator());
+                std::lock_guard<std::mutex> lock(_multiMtx);
+                if(_idleHandles.empty())
+                {
+                    request->curl = curl_easy_init();
+                }
+                else
+                {
+                    request->curl = _idleHandles.back();
+                    _idleHandles.pop_back();
+                    curl_easy_reset(request->curl);
+                }
             }
 
-            char areaString[40] = "";
-            sdkErrorAreaString(area, areaString);
+            if(!request->curl)
             {
-                rapidjson::Value v(areaString, json.GetAllocator());
-                json.AddMember("error_area", v.Move(), json.GetAllocator());
+                releaseAsyncRequest(request);
+                callback(NoResponse, "", 0, 0);
+                return;
             }
 
-            char actionString[40] = "";
-            sdkErrorActionString(action, actionString);
+            if(_share)
             {
-                rapidjson::Value v(actionString, json.GetAllocator());
-                json.AddMember("error_action", v.Move(), json.GetAllocator());
+                curl_easy_setopt(request->curl, CURLOPT_SHARE, _share);
             }
+            curl_easy_setopt(request->curl, CURLOPT_TCP_KEEPALIVE, 1L);
+            curl_easy_setopt(request->curl, CURLOPT_SSL_VERIFYPEER, 0L);
+            curl_easy_setopt(request->curl, CURLOPT_WRITEFUNCTION, writefunc);
+            curl_easy_setopt(request->curl, CURLOPT_WRITEDATA, &request->response);
+            curl_easy_setopt(request->curl, CURLOPT_PRIVATE, request);
+            createRequest(request->curl, url, request->payloadData, authorization, useGzip, request->header);
 
-            char parameterString[40] = "";
-            sdkErrorParameterString(parameter, parameterString);
-            if(strlen(parameterString) > 0)
             {
-                rapidjson::Value v(parameterString, json.GetAllocator());
-                json.AddMember("error_parameter", v.Move(), json.GetAllocator());
+                std::lock_guard<std::mutex> lock(_multiMtx);
+                _queuedRequests.push_back(request);
+                if(!_multiThread.joinable())
+                {
+                    _multiThread = std::thread(&GAHTTPApi::runMultiLoop, this);
+                }
             }
+            curl_multi_wakeup(_multi);
+        }
 
-            if(strlen(reason) > 0)
+        void GAHTTPApi::runMultiLoop()
+        {
+            while(true)
             {
-                rapidjson::Value v(reason, json.GetAllocator());
-                json.AddMember("reason", v.Move(), json.GetAllocator());
+                {
+                    std::lock_guard<std::mutex> lock(_multiMtx);
+                    if(_stopMulti)
+                    {
+                        return;
+                    }
+                    for(size_t i = 0; i < _queuedRequests.size(); ++i)
+                    {
+                        curl_multi_add_handle(_multi, _queuedRequests[i]->curl);
+                        _activeRequests.push_back(_queuedRequests[i]);
+                    }
+                    _queuedRequests.clear();
+                }
+
+                int running = 0;
+                curl_multi_perform(_multi, &running);
+
+                CURLMsg* message = NULL;
+                int messagesLeft = 0;
+                while((message = curl_multi_info_read(_multi, &messagesLeft)) != NULL)
+                {
+                    if(message->msg != CURLMSG_DONE)
+                    {
+                        continue;
+                    }
+
+                    AsyncRequest* request = NULL;
+                    curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &request);
+                    CURLcode result = message->data.result;
+                    curl_multi_remove_handle(_multi, request->curl);
+                    {
+                        std::lock_guard<std::mutex> lock(_multiMtx);
+                        _activeRequests.erase(std::remove(_activeRequests.begin(), _activeRequests.end(), request), _activeRequests.end());
+                    }
+
+                    EGAHTTPApiResponse response = NoResponse;
+                    double seconds = 0;
+                    curl_easy_getinfo(request->curl, CURLINFO_TOTAL_TIME, &seconds);
+                    if(result == CURLE_OK)
+                    {
+                        updateUploadSpeed(request->curl);
+                        long statusCode = 0;
+                        curl_easy_getinfo(request->curl, CURLINFO_RESPONSE_CODE, &statusCode);
+                        GA_LOG_DEBUG("body: %s", request->response.ptr);
+                        response = processRequestResponse(statusCode, request->response.ptr, request->requestId);
+                    }
+                    else
+                    {
+                        GA_LOG_DEBUG(curl_easy_strerror(result));
+                        metrics::GAMetrics::add(metrics::HttpNoResponse);
+                    }
+
+                    request->callback(response, request->response.ptr, request->payloadData.size(), seconds);
+                    releaseAsyncRequest(request);
+                }
+
+                curl_multi_poll(_multi, NULL, 0, 1000, NULL);
             }
+        }
 
-            rapidjson::Document eventArray;
-            eventArray.SetArray();
-            rapidjson::Document::AllocatorType& allocator = eventArray.GetAllocator();
-            eventArray.PushBack(json, allocator);
-            rapidjson::StringBuffer buffer;
+        void GAHTTPApi::releaseAsyncRequest(AsyncRequest* request)
+        {
+#if USE_TIZEN
+            if(request->connectionCreated)
             {
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-                eventArray.Accept(writer);
+                connection_destroy(request->connection);
+            }
+#endif
+            if(request->curl)
+            {
+                // keep the handle around for the next batch
+                curl_easy_setopt(request->curl, CURLOPT_HTTPHEADER, NULL);
+                curl_easy_setopt(request->curl, CURLOPT_WRITEDATA, NULL);
+                std::lock_guard<std::mutex> lock(_multiMtx);
+                _idleHandles.push_back(request->curl);
+            }
+            if(request->header)
+            {
+                curl_slist_free_all(request->header);
             }
-            std::array<char, 10000> payloadJSONString = {'\0'};
-            snprintf(payloadJSONString.data(), payloadJSONString.size(), "%s", buffer.GetString());
+            free(request->response.ptr);
+            delete request;
+        }
 
-            if(strlen(payloadJSONString.data()) == 0)
+        void GAHTTPApi::sendSdkErrorEvent(EGASdkErrorCategory category, EGASdkErrorArea area, EGASdkErrorAction action, EGASdkErrorParameter parameter, const char* reason, const char* gameKey, const char* secretKey)
+        {
+            if(!state::GAState::isEventSubmissionEnabled())
             {
-                logging::GALogger::w("sendSdkErrorEvent: JSON encoding failed.");
                 return;
             }
 
-            logging::GALogger::d("sendSdkErrorEvent json: %s", payloadJSONString.data());
-
-            ErrorType errorType = std::make_tuple(category, area);
+            // Validate
+            if (!validators::GAValidator::validateSdkErrorEvent(gameKey, secretKey, category, area, action))
+            {
+                return;
+            }
 
 #if !NO_ASYNC
-            bool useGzip = this->useGzip;
-
-            std::async(std::launch::async, [url, payloadJSONString, useGzip, errorType]() -> void
+            reason = reason ? reason : "";
+            std::shared_ptr<client::GAClientContext> client;
+            if(client::GAClientContext::current())
             {
-                int64_t now = utilities::GAUtilities::timeIntervalSince1970();
-                if(timestampMap.count(errorType) == 0)
+                client = client::GAClientContext::current()->shared_from_this();
+            }
+            {
+                std::lock_guard<std::mutex> lock(_sdkErrorMtx);
+
+                // the same error waiting to be sent is only counted
+                for(size_t i = 0; i < _pendingSdkErrors.size(); ++i)
                 {
-                    timestampMap[errorType] = now;
+                    PendingSdkError& pending = _pendingSdkErrors[i];
+                    if(pending.client == client && pending.category == category && pending.area == area && pending.action == action && pending.parameter == parameter && pending.reason == reason)
+                    {
+                        pending.count++;
+                        return;
+                    }
                 }
-                if(countMap.count(errorType) == 0)
+
+                if(_pendingSdkErrors.size() >= MaxPendingSdkErrors)
                 {
-                    countMap[errorType] = 0;
+                    return;
                 }
 
-                int64_t diff = now - timestampMap[errorType];
-                if(diff >= 3600)
+                ErrorType errorType = std::make_tuple(category, area);
+                int64_t now = utilities::GAUtilities::timeIntervalSince1970();
+                std::map<ErrorType, int64_t>::iterator timestamp = timestampMap.find(errorType);
+                if(timestamp == timestampMap.end() || now - timestamp->second >= 3600)
                 {
-                    countMap[errorType] = 0;
                     timestampMap[errorType] = now;
+                    countMap[errorType] = 0;
                 }
-
-                if(countMap[errorType] >= MaxCount)
+                int& count = countMap[errorType];
+                if(count >= MaxCount)
                 {
                     return;
                 }
+                count++;
+
+                PendingSdkError pending;
+                pending.client = client;
+                pending.category = category;
+                pending.area = area;
+                pending.action = action;
+                pending.parameter = parameter;
+                pending.reason = reason;
+                pending.count = 1;
+                _pendingSdkErrors.push_back(pending);
+            }
 
-                std::vector<char> payloadData = GAHTTPApi::getInstance()->createPayloadData(payloadJSONString.data(), useGzip);
+            flushSdkErrors();
+#endif
+        }
 
-                CURL *curl;
-                CURLcode res;
-                curl = curl_easy_init();
-                if(!curl)
+        void GAHTTPApi::flushSdkErrors()
+        {
+            std::vector<PendingSdkError> errors;
+            {
+                std::lock_guard<std::mutex> lock(_sdkErrorMtx);
+                // one report at a time, errors raised meanwhile are coalesced and sent next
+                if(_sdkErrorInFlight || _pendingSdkErrors.empty())
                 {
                     return;
                 }
+                _sdkErrorInFlight = true;
 
-                curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+                // one client per report, the others follow
+                std::vector<PendingSdkError> remaining;
+                for(size_t i = 0; i < _pendingSdkErrors.size(); ++i)
+                {
+                    (_pendingSdkErrors[i].client == _pendingSdkErrors[0].client ? errors : remaining).push_back(_pendingSdkErrors[i]);
+                }
+                _pendingSdkErrors.swap(remaining);
+            }
+            client::GAClientScope scope(errors[0].client.get());
 
-                struct ResponseData s;
-                initResponseData(&s);
+            rapidjson::Document eventArray;
+            eventArray.SetArray();
+            rapidjson::Document::AllocatorType& allocator = eventArray.GetAllocator();
+            for(size_t i = 0; i < errors.size(); ++i)
+            {
+                const PendingSdkError& error = errors[i];
 
-                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writefunc);
-                curl_easy_setopt(curl, CURLOPT_WRITEDATA, &s);
-#if USE_TIZEN
-                connection_h connection;
-                int conn_err;
-                conn_err = connection_create(&connection);
-                if (conn_err != CONNECTION_ERROR_NONE)
+                rapidjson::Document json;
+                json.SetObject();
+                state::GAState::getSdkErrorEventAnnotations(json);
+
+                char categoryString[40] = "";
+                sdkErrorCategoryString(error.category, categoryString);
                 {
-                    return;
+                    rapidjson::Value v(categoryString, json.GetAllocator());
+                    json.AddMember("error_category", v.Move(), json.GetAllocator());
                 }
-#endif
-                GAHTTPApi::getInstance()->createRequest(curl, url.data(), payloadData, useGzip);
 
-                res = curl_easy_perform(curl);
-                if(res != CURLE_OK)
+                char areaString[40] = "";
+                sdkErrorAreaString(error.area, areaString);
                 {
-                    logging::GALogger::d(curl_easy_strerror(res));
-                    return;
+                    rapidjson::Value v(areaString, json.GetAllocator());
+                    json.AddMember("error_area", v.Move(), json.GetAllocator());
                 }
 
-                long statusCode;
-                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
-                curl_easy_cleanup(curl);
+                char actionString[40] = "";
+                sdkErrorActionString(error.action, actionString);
+                {
+                    rapidjson::Value v(actionString, json.GetAllocator());
+                    json.AddMember("error_action", v.Move(), json.GetAllocator());
+                }
 
-                // process the response
-                logging::GALogger::d("sdk error content : %s", s.ptr);
-                free(s.ptr);
+                char parameterString[40] = "";
+                sdkErrorParameterString(error.parameter, parameterString);
+                if(strlen(parameterString) > 0)
+                {
+                    rapidjson::Value v(parameterString, json.GetAllocator());
+                    json.AddMember("error_parameter", v.Move(), json.GetAllocator());
+                }
 
-                // if not 200 result
-                if (statusCode != 200)
+                if(!error.reason.empty() || error.count > 1)
                 {
-                    logging::GALogger::d("sdk error failed. response code not 200. status code: %u", CURLE_OK);
-#if USE_TIZEN
-                    connection_destroy(connection);
-#endif
-                    return;
+                    std::string reason = error.reason;
+                    if(error.count > 1)
+                    {
+                        char repeated[32] = "";
+                        snprintf(repeated, sizeof(repeated), " (%d times)", error.count);
+                        reason += repeated;
+                    }
+                    rapidjson::Value v(reason.c_str(), json.GetAllocator());
+                    json.AddMember("reason", v.Move(), json.GetAllocator());
                 }
 
-#if USE_TIZEN
-                connection_destroy(connection);
-#endif
+                eventArray.PushBack(rapidjson::Value(json, allocator).Move(), allocator);
+            }
+
+            rapidjson::StringBuffer buffer;
+            {
+                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+                eventArray.Accept(writer);
+            }
+
+            char url[513] = "";
+            snprintf(url, sizeof(url), "%s/%s/%s", baseUrl, state::GAState::getGameKey(), eventsUrlPath);
+
+            GA_LOG_DEBUG("Sending 'events' URL: %s", url);
+            GA_LOG_DEBUG("sendSdkErrorEvent json: %s", buffer.GetString());
+
+            sendPayloadAsync(TransportSdkError, url, buffer.GetString(), "SdkError", [this](EGAHTTPApiResponse response, const char* body, size_t, double)
+            {
+                if(response != Ok)
+                {
+                    GA_LOG_DEBUG("sdk error failed. response: %d, content: %s", response, body);
+                }
 
-                countMap[errorType] = countMap[errorType] + 1;
+                {
+                    std::lock_guard<std::mutex> lock(_sdkErrorMtx);
+                    _sdkErrorInFlight = false;
+                }
+                // runs on the sender thread, the next error is built on the GA thread
+                threading::GAThreading::performTaskOnGAThread([this]()
+                {
+                    flushSdkErrors();
+                });
             });
-#endif
         }
 
         const int GAHTTPApi::MaxCount = 10;
+        const size_t GAHTTPApi::MaxPendingSdkErrors = 16;
         std::map<ErrorType, int> GAHTTPApi::countMap = std::map<ErrorType, int>();
         std::map<ErrorType, int64_t> GAHTTPApi::timestampMap = std::map<ErrorType, int64_t>();
 
-        std::vector<char> GAHTTPApi::createPayloadData(const char* payload, bool gzip)
+        const double GAHTTPApi::CompressionCpuBudgetSeconds = 0.005;
+
+        void GAHTTPApi::configureCompression(int level, EGACompressionStrategy strategy)
         {
-            std::vector<char> payloadData;
+            std::lock_guard<std::mutex> lock(_compressorMtx);
+            _adaptiveCompression = level == 0;
+            if(!_adaptiveCompression && !_compressor.setLevel(level))
+            {
+                logging::GALogger::w("Compression level must be between %d and %d or 0 for adaptive, got %d", utilities::GAGzipCompressor::MinLevel, utilities::GAGzipCompressor::MaxLevel, level);
+                _adaptiveCompression = true;
+            }
+            _compressor.setStrategy(strategy);
+        }
 
-            if (gzip)
+        void GAHTTPApi::setTransport(const std::shared_ptr<ITransport>& transport)
+        {
+            client::GAClientContext* client = client::GAClientContext::current();
+            if(client)
             {
-                payloadData = utilities::GAUtilities::gzipCompress(payload);
+                client->setTransport(transport);
+                return;
+            }
 
-                logging::GALogger::d("Gzip stats. Size: %lu, Compressed: %lu", strlen(payload), payloadData.size());
+            std::lock_guard<std::mutex> lock(_transportMtx);
+            _transport = transport;
+        }
+
+        std::shared_ptr<ITransport> GAHTTPApi::getTransport()
+        {
+            // clients without their own transport use the shared curl connections
+            client::GAClientContext* client = client::GAClientContext::current();
+            if(client)
+            {
+                return client->getTransport();
             }
-            else
+
+            std::lock_guard<std::mutex> lock(_transportMtx);
+            return _transport;
+        }
+
+        bool GAHTTPApi::sendWithTransport(EGATransportRequestType type, const char* url, const std::vector<char>& payloadData, const char* authorization, bool gzip, long& statusCode_out, std::string& body_out)
+        {
+            std::shared_ptr<ITransport> transport = getTransport();
+            if(!transport)
+            {
+                return false;
+            }
+
+            GATransportRequest request = {type, url, payloadData.data(), payloadData.size(), authorization, gzip};
+            GATransportResponse response = transport->send(request);
+            statusCode_out = response.statusCode;
+            body_out.swap(response.body);
+            return true;
+        }
+
+        void GAHTTPApi::updateUploadSpeed(CURL* curl)
+        {
+            double bytesPerSecond = 0;
+            curl_easy_getinfo(curl, CURLINFO_SPEED_UPLOAD, &bytesPerSecond);
+            if(bytesPerSecond <= 0)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(_compressorMtx);
+            _uploadBytesPerSecond = _uploadBytesPerSecond > 0 ? _uploadBytesPerSecond + 0.25 * (bytesPerSecond - _uploadBytesPerSecond) : bytesPerSecond;
+        }
+
+        std::vector<char> GAHTTPApi::createPayloadData(const char* payload, bool gzip, char* authorization_out)
+        {
+            std::vector<char> payloadData;
+
+            // the keyed HMAC state is cached per game secret, only the payload is hashed here
+            std::chrono::steady_clock::time_point hmacStart = std::chrono::steady_clock::now();
+            hmac_sha256_ctx hmac;
+            utilities::GAUtilities::hmacContextForKey(state::GAState::getGameSecret(), hmac);
+            double hmacMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hmacStart).count();
+
+            if (gzip)
             {
-                size_t s = strlen(payload);
+                std::lock_guard<std::mutex> lock(_compressorMtx);
+                if(_adaptiveCompression)
+                {
+                    _compressor.setLevel(utilities::GAGzipCompressor::adaptiveLevel(_compressor.getLevel(), _uploadBytesPerSecond, _lastCompressSeconds, CompressionCpuBudgetSeconds));
+                }
 
-                for(size_t i = 0; i < s; ++i)
+                size_t size = strlen(payload);
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                // sign the compressed bytes while they are written instead of reading the payload again
+                _compressor.compress(payload, size, payloadData, [&hmac, &hmacMilliseconds](const char* data, size_t length)
                 {
-                    payloadData.push_back(payload[i]);
+                    std::chrono::steady_clock::time_point updateStart = std::chrono::steady_clock::now();
+                    hmac_sha256_update(&hmac, reinterpret_cast<const unsigned char*>(data), static_cast<unsigned int>(length));
+                    hmacMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - updateStart).count();
+                });
+                _lastCompressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                // the signing of the output is counted as HMAC time only
+                metrics::GAMetrics::record(metrics::GzipTime, std::max(0.0, 1000 * _lastCompressSeconds - hmacMilliseconds));
+                if(size > 0)
+                {
+                    metrics::GAMetrics::record(metrics::GzipRatio, static_cast<double>(payloadData.size()) / size);
                 }
+
+                GA_LOG_DEBUG("Gzip stats. Size: %lu, Compressed: %lu, Level: %d", size, payloadData.size(), _compressor.getLevel());
+            }
+            else
+            {
+                payloadData.assign(payload, payload + strlen(payload));
+                hmacStart = std::chrono::steady_clock::now();
+                hmac_sha256_update(&hmac, reinterpret_cast<const unsigned char*>(payloadData.data()), static_cast<unsigned int>(payloadData.size()));
+                hmacMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hmacStart).count();
             }
 
+            hmacStart = std::chrono::steady_clock::now();
+            utilities::GAUtilities::hmacFinalBase64(hmac, authorization_out);
+            hmacMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hmacStart).count();
+            metrics::GAMetrics::record(metrics::HmacTime, hmacMilliseconds);
             return payloadData;
         }
 
-        std::vector<char> GAHTTPApi::createRequest(CURL *curl, const char* url, const std::vector<char>& payloadData, bool gzip)
+        void GAHTTPApi::createRequest(CURL* curl, const char* url, const std::vector<char>& payloadData, const char* authorization, bool gzip, struct curl_slist*& header_out)
         {
             curl_easy_setopt(curl, CURLOPT_URL, url);
             curl_easy_setopt(curl, CURLOPT_POST, 1L);
@@ -595,11 +1051,6 @@ namespace gameanalytics
                 header = curl_slist_append(header, "Content-Encoding: gzip");
             }
 
-            // create authorization hash
-            const char* key = state::GAState::getGameSecret();
-
-            char authorization[257] = "";
-            utilities::GAUtilities::hmacWithKey(key, payloadData, authorization);
             char auth[129] = "";
             snprintf(auth, sizeof(auth), "Authorization: %s", authorization);
             header = curl_slist_append(header, auth);
@@ -607,28 +1058,21 @@ namespace gameanalytics
             // always JSON
             header = curl_slist_append(header, "Content-Type: application/json");
 
+            // freed with the request
+            header_out = header;
             curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header);
             curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payloadData.data());
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
             curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, payloadData.size());
-
-            std::vector<char> result;
-            size_t s = strlen(authorization);
-            for(size_t i = 0; i < s; ++i)
-            {
-                result.push_back(authorization[i]);
-            }
-            result.push_back('\0');
-
-            return result;
         }
 
         EGAHTTPApiResponse GAHTTPApi::processRequestResponse(long statusCode, const char* body, const char* requestId)
         {
+            metrics::GAMetrics::recordStatusCode(statusCode);
+
             // if no result - often no connection
-            if (utilities::GAUtilities::isStringNullOrEmpty(body))
+            if (statusCode == 0 || utilities::GAUtilities::isStringNullOrEmpty(body))
             {
-                logging::GALogger::d("%s request. failed. Might be no connection. Status code: %ld", requestId, statusCode);
+                GA_LOG_DEBUG("%s request. failed. Might be no connection. Status code: %ld", requestId, statusCode);
                 return NoResponse;
             }
 
@@ -642,22 +1086,21 @@ namespace gameanalytics
                 return Created;
             }
 
-            // 401 can return 0 status
-            if (statusCode == 0 || statusCode == 401)
+            if (statusCode == 401)
             {
-                logging::GALogger::d("%s request. 401 - Unauthorized.", requestId);
+                GA_LOG_DEBUG("%s request. 401 - Unauthorized.", requestId);
                 return Unauthorized;
             }
 
             if (statusCode == 400)
             {
-                logging::GALogger::d("%s request. 400 - Bad Request.", requestId);
+                GA_LOG_DEBUG("%s request. 400 - Bad Request.", requestId);
                 return BadRequest;
             }
 
             if (statusCode == 500)
             {
-                logging::GALogger::d("%s request. 500 - Internal Server Error.", requestId);
+                GA_LOG_DEBUG("%s request. 500 - Internal Server Error.", requestId);
                 return InternalServerError;
             }
             return UnknownResponseCode;
@@ -8,14 +8,26 @@
 #include <vector>
 #include <map>
 #include "rapidjson/document.h"
+#include "GAGzipCompressor.h"
+#include "GameAnalytics.h"
+#include "GAClient.h"
 #if USE_UWP
 #include <ppltasks.h>
 #else
 #include <curl/curl.h>
+#if USE_TIZEN
+#include <net_connection.h>
+#endif
 #endif
 #include <mutex>
 #include <cstdlib>
 #include <tuple>
+#include <functional>
+#include <memory>
+#include <string>
+#if !USE_UWP
+#include <thread>
+#endif
 
 namespace gameanalytics
 {
@@ -112,6 +124,20 @@ namespace gameanalytics
 
         typedef std::tuple<EGASdkErrorCategory, EGASdkErrorArea> ErrorType;
 
+        // init call built from the state on the GA thread, sending it reads no state
+        struct InitRequest
+        {
+            std::string url;
+            std::string json;
+            std::vector<char> payloadData;
+            char authorization[65];
+            bool gzip;
+        };
+
+        // response and raw body of an events request, body is empty when there was no response.
+        // payloadBytes is the size of the posted (compressed) body and seconds the request time.
+        typedef std::function<void(EGAHTTPApiResponse response, const char* body, size_t payloadBytes, double seconds)> EventsCallback;
+
         class GAHTTPApi
         {
         public:
@@ -124,8 +150,20 @@ namespace gameanalytics
             void sendSdkErrorEvent(EGASdkErrorCategory category, EGASdkErrorArea area, EGASdkErrorAction action, EGASdkErrorParameter parameter, std::string reason, std::string gameKey, std::string secretKey);
 #else
             void requestInitReturningDict(EGAHTTPApiResponse& response_out, rapidjson::Document& json_out, const char* configsHash);
+            // call on the GA thread, false if the annotations could not be encoded
+            bool prepareInitRequest(InitRequest& request_out, const char* configsHash);
+            // safe on any thread
+            void sendInitRequest(const InitRequest& initRequest, EGAHTTPApiResponse& response_out, rapidjson::Document& json_out);
             void sendEventsInArray(EGAHTTPApiResponse& response_out, rapidjson::Value& json_out, const rapidjson::Value& eventArray);
+            // Queues the batch on the sender thread and returns right away. Any
+            // number of batches can be in flight, the callback runs on the
+            // sender thread when the request completes.
+            void sendEventsInArrayAsync(const rapidjson::Value& eventArray, const EventsCallback& callback);
             void sendSdkErrorEvent(EGASdkErrorCategory category, EGASdkErrorArea area, EGASdkErrorAction action, EGASdkErrorParameter parameter, const char* reason, const char* gameKey, const char* secretKey);
+            // level 1-9 fixes the gzip level, 0 picks it from the upload speed and compression time
+            void configureCompression(int level, EGACompressionStrategy strategy);
+            // null sends with libcurl again
+            void setTransport(const std::shared_ptr<ITransport>& transport);
 #endif
 
             static void sdkErrorCategoryString(EGASdkErrorCategory value, char* out)
@@ -320,15 +358,66 @@ namespace gameanalytics
             ~GAHTTPApi();
             GAHTTPApi(const GAHTTPApi&) = delete;
             GAHTTPApi& operator=(const GAHTTPApi&) = delete;
-            std::vector<char> createPayloadData(const char* payload, bool gzip);
 
 #if USE_UWP
+            std::vector<char> createPayloadData(const char* payload, bool gzip);
             std::vector<char> createRequest(Windows::Web::Http::HttpRequestMessage^ message, const std::string& url, const std::vector<char>& payloadData, bool gzip);
             EGAHTTPApiResponse processRequestResponse(Windows::Web::Http::HttpResponseMessage^ response, const std::string& requestId);
             concurrency::task<Windows::Storage::Streams::InMemoryRandomAccessStream^> createStream(std::string data);
 #else
-            std::vector<char> createRequest(CURL *curl, const char* url, const std::vector<char>& payloadData, bool gzip);
+            // One request on a borrowed easy handle. The persistent handle is used
+            // when it is free, otherwise a temporary handle attached to the share
+            // handle so DNS, TLS sessions and connections are still reused.
+            // Everything is released when the request goes out of scope.
+            struct CurlRequest
+            {
+                CurlRequest(GAHTTPApi* api);
+                ~CurlRequest();
+                CurlRequest(const CurlRequest&) = delete;
+                CurlRequest& operator=(const CurlRequest&) = delete;
+
+                GAHTTPApi* api;
+                CURL* curl;
+                bool pooled;
+                struct curl_slist* header;
+                ResponseData response;
+#if USE_TIZEN
+                bool connectionCreated;
+                connection_h connection;
+#endif
+            };
+
+            // a request driven by the multi handle
+            struct AsyncRequest;
+
+            // an SDK error waiting for the report in flight, repeats only raise the count
+            struct PendingSdkError
+            {
+                // null for the default instance
+                std::shared_ptr<client::GAClientContext> client;
+                EGASdkErrorCategory category;
+                EGASdkErrorArea area;
+                EGASdkErrorAction action;
+                EGASdkErrorParameter parameter;
+                std::string reason;
+                int count;
+            };
+
+            void flushSdkErrors();
+
+            // authorization_out receives the base64 HMAC of the payload, at least HmacBase64Size
+            std::vector<char> createPayloadData(const char* payload, bool gzip, char* authorization_out);
+            void createRequest(CURL* curl, const char* url, const std::vector<char>& payloadData, const char* authorization, bool gzip, struct curl_slist*& header);
+            void sendPayloadAsync(EGATransportRequestType type, const char* url, const char* JSONstring, const char* requestId, const EventsCallback& callback);
+            void runMultiLoop();
+            void releaseAsyncRequest(AsyncRequest* request);
             EGAHTTPApiResponse processRequestResponse(long statusCode, const char* body, const char* requestId);
+            static void lockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr);
+            static void unlockShare(CURL* handle, curl_lock_data data, void* userptr);
+            void updateUploadSpeed(CURL* curl);
+            std::shared_ptr<ITransport> getTransport();
+            // blocking request on the custom transport, false when none is set
+            bool sendWithTransport(EGATransportRequestType type, const char* url, const std::vector<char>& payloadData, const char* authorization, bool gzip, long& statusCode_out, std::string& body_out);
 #endif
             static char protocol[];
             static char hostName[];
@@ -358,6 +447,37 @@ namespace gameanalytics
             }
 #if USE_UWP
             Windows::Web::Http::HttpClient^ httpClient;
+#else
+            CURLSH* _share;
+            CURL* _curl;
+            std::mutex _curlMtx;
+            std::mutex _shareMtx[CURL_LOCK_DATA_LAST];
+
+            CURLM* _multi;
+            std::thread _multiThread;
+            std::mutex _multiMtx;
+            bool _stopMulti;
+            std::vector<AsyncRequest*> _queuedRequests;
+            std::vector<AsyncRequest*> _activeRequests;
+            std::vector<CURL*> _idleHandles;
+
+            static const double CompressionCpuBudgetSeconds;
+            utilities::GAGzipCompressor _compressor;
+            std::mutex _compressorMtx;
+            bool _adaptiveCompression;
+            double _lastCompressSeconds;
+            // moving average in bytes per second, 0 until the first upload
+            double _uploadBytesPerSecond;
+
+            // replaces libcurl when set
+            std::shared_ptr<ITransport> _transport;
+            std::mutex _transportMtx;
+
+            static const size_t MaxPendingSdkErrors;
+            // also guards countMap and timestampMap
+            std::mutex _sdkErrorMtx;
+            std::vector<PendingSdkError> _pendingSdkErrors;
+            bool _sdkErrorInFlight;
 #endif
         };
 
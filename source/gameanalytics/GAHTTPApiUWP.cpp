@@ -4,6 +4,7 @@
 #include "GALogger.h"
 #include "GAUtilities.h"
 #include "GAValidator.h"
+#include "GAMetrics.h"
 #include <map>
 #include <robuffer.h>
 #include <assert.h>
@@ -110,7 +111,7 @@ namespace gameanalytics
             // Generate URL
             std::string url = std::string(remoteConfigsBaseUrl) + "/" + std::string(initializeUrlPath) + "?game_key=" + std::string(gameKey) + "&interval_seconds=0&configs_hash=" + hash;
 
-            logging::GALogger::d("Sending 'init' URL: %s", url.c_str());
+            GA_LOG_DEBUG("Sending 'init' URL: %s", url.c_str());
 
             rapidjson::Document initAnnotations;
             initAnnotations.SetObject();
@@ -152,14 +153,14 @@ namespace gameanalytics
                 // if not 200 result
                 if (requestResponseEnum != Ok && requestResponseEnum != Created && requestResponseEnum != BadRequest)
                 {
-                    logging::GALogger::d("Failed Init Call. URL: %s, JSONString: %s, Authorization: %s", url.c_str(), JSONstring.c_str(), authorization.data());
+                    GA_LOG_DEBUG("Failed Init Call. URL: %s, JSONString: %s, Authorization: %s", url.c_str(), JSONstring.c_str(), authorization.data());
                     return std::pair<EGAHTTPApiResponse, std::string>(requestResponseEnum, "");
                 }
 
                 // print reason if bad request
                 if (requestResponseEnum == BadRequest)
                 {
-                    logging::GALogger::d("Failed Init Call. Bad request. Response: %s", utilities::GAUtilities::ws2s(response->Content->ToString()->Data()).c_str());
+                    GA_LOG_DEBUG("Failed Init Call. Bad request. Response: %s", utilities::GAUtilities::ws2s(response->Content->ToString()->Data()).c_str());
                     // return bad request result
                     return std::pair<EGAHTTPApiResponse, std::string>(requestResponseEnum, "");
                 }
@@ -170,14 +171,14 @@ namespace gameanalytics
                 // Return response.
                 std::string body = utilities::GAUtilities::ws2s(responseBodyAsText->Data());
 
-                logging::GALogger::d("init request content : %s", body.c_str());
+                GA_LOG_DEBUG("init request content : %s", body.c_str());
 
                 rapidjson::Document requestJsonDict;
                 requestJsonDict.Parse(body.c_str());
 
                 if (requestJsonDict.IsNull())
                 {
-                    logging::GALogger::d("Failed Init Call. Json decoding failed");
+                    GA_LOG_DEBUG("Failed Init Call. Json decoding failed");
                     return std::pair<EGAHTTPApiResponse, std::string>(JsonDecodeFailed, "");
                 }
 
@@ -204,14 +205,14 @@ namespace gameanalytics
         {
             if (eventArray.Empty())
             {
-                logging::GALogger::d("sendEventsInArray called with missing eventArray");
+                GA_LOG_DEBUG("sendEventsInArray called with missing eventArray");
             }
 
             auto gameKey = state::GAState::getGameKey();
 
             // Generate URL
             std::string url = std::string(baseUrl) + "/" + std::string(gameKey) + "/" + std::string(eventsUrlPath);
-            logging::GALogger::d("Sending 'events' URL: %s", url.c_str());
+            GA_LOG_DEBUG("Sending 'events' URL: %s", url.c_str());
 
             // make JSON string from data
             rapidjson::StringBuffer buffer;
@@ -224,7 +225,7 @@ namespace gameanalytics
 
             if (JSONstring.empty())
             {
-                logging::GALogger::d("sendEventsInArray JSON encoding failed of eventArray");
+                GA_LOG_DEBUG("sendEventsInArray JSON encoding failed of eventArray");
                 return concurrency::create_task([]()
                 {
                     return std::pair<EGAHTTPApiResponse, std::string>(JsonDecodeFailed, "");
@@ -251,14 +252,14 @@ namespace gameanalytics
                 // if not 200 result
                 if (requestResponseEnum != Ok && requestResponseEnum != Created && requestResponseEnum != BadRequest)
                 {
-                    logging::GALogger::d("Failed Events Call. URL: %s, JSONString: %s, Authorization: %s", url.c_str(), JSONstring.c_str(), authorization.c_str());
+                    GA_LOG_DEBUG("Failed Events Call. URL: %s, JSONString: %s, Authorization: %s", url.c_str(), JSONstring.c_str(), authorization.c_str());
                     return std::pair<EGAHTTPApiResponse, std::string>(requestResponseEnum,"");
                 }
 
                 // print reason if bad request
                 if (requestResponseEnum == BadRequest)
                 {
-                    logging::GALogger::d("Failed Events Call. Bad request. Response: %s", utilities::GAUtilities::ws2s(response->Content->ToString()->Data()).c_str());
+                    GA_LOG_DEBUG("Failed Events Call. Bad request. Response: %s", utilities::GAUtilities::ws2s(response->Content->ToString()->Data()).c_str());
                     // return bad request result
                     return std::pair<EGAHTTPApiResponse, std::string>(requestResponseEnum,"");
                 }
@@ -269,7 +270,7 @@ namespace gameanalytics
                 // Return response.
                 std::string body = utilities::GAUtilities::ws2s(responseBodyAsText->Data());
 
-                logging::GALogger::d("body: %s", body.c_str());
+                GA_LOG_DEBUG("body: %s", body.c_str());
 
                 rapidjson::Document requestJsonDict;
                 requestJsonDict.Parse(body.c_str());
@@ -304,7 +305,7 @@ namespace gameanalytics
 
             // Generate URL
             std::string url = std::string(baseUrl) + "/" + std::string(gameKey) + "/" + std::string(eventsUrlPath);
-            logging::GALogger::d("Sending 'events' URL: %s", url.c_str());
+            GA_LOG_DEBUG("Sending 'events' URL: %s", url.c_str());
 
             rapidjson::Document json;
             json.SetObject();
@@ -362,7 +363,7 @@ namespace gameanalytics
                 return;
             }
 
-            logging::GALogger::d("sendSdkErrorEvent json: %s", payloadJSONString.c_str());
+            GA_LOG_DEBUG("sendSdkErrorEvent json: %s", payloadJSONString.c_str());
 
             ErrorType errorType = std::make_tuple(category, area);
 
@@ -405,7 +406,7 @@ namespace gameanalytics
                 // if not 200 result
                 if (statusCode != Windows::Web::Http::HttpStatusCode::Ok)
                 {
-                    logging::GALogger::d("sdk error failed. response code not 200. status code: %s", utilities::GAUtilities::ws2s(statusCode.ToString()->Data()).c_str());
+                    GA_LOG_DEBUG("sdk error failed. response code not 200. status code: %s", utilities::GAUtilities::ws2s(statusCode.ToString()->Data()).c_str());
                     return;
                 }
 
@@ -415,7 +416,7 @@ namespace gameanalytics
                 // Return response.
                 std::string body = utilities::GAUtilities::ws2s(responseBodyAsText->Data());
 
-                logging::GALogger::d("init request content : %s", body.c_str());
+                GA_LOG_DEBUG("init request content : %s", body.c_str());
 
                 countMap[errorType] = countMap[errorType] + 1;
             });
@@ -431,8 +432,16 @@ namespace gameanalytics
 
             if (gzip)
             {
-                payloadData = utilities::GAUtilities::gzipCompress(payload);
-                logging::GALogger::d("Gzip stats. Size: %d, Compressed: %d", strlen(payload), payloadData.size());
+                {
+                    metrics::GAMetricsTimer timer(metrics::GzipTime);
+                    payloadData = utilities::GAUtilities::gzipCompress(payload);
+                }
+                size_t size = strlen(payload);
+                if(size > 0)
+                {
+                    metrics::GAMetrics::record(metrics::GzipRatio, static_cast<double>(payloadData.size()) / size);
+                }
+                GA_LOG_DEBUG("Gzip stats. Size: %d, Compressed: %d", strlen(payload), payloadData.size());
             }
             else
             {
@@ -454,6 +463,7 @@ namespace gameanalytics
             message->Method = Windows::Web::Http::HttpMethod::Post;
 
             // create authorization hash
+            std::chrono::steady_clock::time_point hmacStart = std::chrono::steady_clock::now();
             auto data = ref new Platform::String(utilities::GAUtilities::s2ws(payloadData.data()).c_str());
             auto key = ref new Platform::String(utilities::GAUtilities::s2ws(state::GAState::getGameSecret()).c_str());
             auto input = Windows::Security::Cryptography::CryptographicBuffer::ConvertStringToBinary(data,
@@ -464,6 +474,7 @@ namespace gameanalytics
             auto signatureKey = macProvider->CreateKey(keyBuffer);
             auto hashed = Windows::Security::Cryptography::Core::CryptographicEngine::Sign(signatureKey, input);
             auto authorization = Windows::Security::Cryptography::CryptographicBuffer::EncodeToBase64String(hashed);
+            metrics::GAMetrics::record(metrics::HmacTime, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hmacStart).count());
 
             message->Headers->TryAppendWithoutValidation(L"Authorization", authorization);
 
@@ -538,11 +549,12 @@ namespace gameanalytics
         EGAHTTPApiResponse GAHTTPApi::processRequestResponse(Windows::Web::Http::HttpResponseMessage^ response, const std::string& requestId)
         {
             Windows::Web::Http::HttpStatusCode statusCode = response->StatusCode;
+            metrics::GAMetrics::recordStatusCode(static_cast<long>(statusCode));
 
             // if no result - often no connection
             if (!response->IsSuccessStatusCode && std::wstring(response->Content->ToString()->Data()).empty())
             {
-                logging::GALogger::d("%s request. failed. Might be no connection. Status code: %s", requestId.c_str(), utilities::GAUtilities::ws2s(statusCode.ToString()->Data()).c_str());
+                GA_LOG_DEBUG("%s request. failed. Might be no connection. Status code: %s", requestId.c_str(), utilities::GAUtilities::ws2s(statusCode.ToString()->Data()).c_str());
                 return NoResponse;
             }
 
@@ -559,23 +571,23 @@ namespace gameanalytics
             // 401 can return 0 status
             if (statusCode == (Windows::Web::Http::HttpStatusCode)0 || statusCode == Windows::Web::Http::HttpStatusCode::Unauthorized)
             {
-                logging::GALogger::d("%s request. 401 - Unauthorized.", requestId.c_str());
+                GA_LOG_DEBUG("%s request. 401 - Unauthorized.", requestId.c_str());
                 return Unauthorized;
             }
 
             if (statusCode == Windows::Web::Http::HttpStatusCode::BadRequest)
             {
-                logging::GALogger::d("%s request. 400 - Bad Request.", requestId.c_str());
+                GA_LOG_DEBUG("%s request. 400 - Bad Request.", requestId.c_str());
                 return BadRequest;
             }
 
             if (statusCode == Windows::Web::Http::HttpStatusCode::InternalServerError)
             {
-                logging::GALogger::d("%s request. 500 - Internal Server Error.", requestId.c_str());
+                GA_LOG_DEBUG("%s request. 500 - Internal Server Error.", requestId.c_str());
                 return InternalServerError;
             }
 
-            logging::GALogger::d("%s request. statusCode=%s response=%s.", requestId.c_str(), utilities::GAUtilities::ws2s(statusCode.ToString()->Data()).c_str(), utilities::GAUtilities::ws2s(response->Content->ToString()->Data()).c_str());
+            GA_LOG_DEBUG("%s request. statusCode=%s response=%s.", requestId.c_str(), utilities::GAUtilities::ws2s(statusCode.ToString()->Data()).c_str(), utilities::GAUtilities::ws2s(response->Content->ToString()->Data()).c_str());
 
             return UnknownResponseCode;
         }
@@ -0,0 +1,93 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GALogQueue.h"
+
+namespace gameanalytics
+{
+    namespace logging
+    {
+        static size_t roundUpToPowerOfTwo(size_t n)
+        {
+            size_t result = 2;
+            while(result < n)
+            {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        GALogQueue::GALogQueue(size_t capacity):
+            _cells(new Cell[roundUpToPowerOfTwo(capacity)]),
+            _mask(roundUpToPowerOfTwo(capacity) - 1),
+            _enqueuePos(0),
+            _dequeuePos(0),
+            _dropped(0)
+        {
+            // a cell is free for the producer at position i when its sequence is i,
+            // and ready for the consumer when it is i + 1
+            for(size_t i = 0; i <= _mask; ++i)
+            {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        bool GALogQueue::push(EGALoggerMessageType type, std::string& message)
+        {
+            Cell* cell = NULL;
+            size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+            for(;;)
+            {
+                cell = &_cells[pos & _mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                ptrdiff_t diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos);
+                if(diff == 0)
+                {
+                    if(_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if(diff < 0)
+                {
+                    // the consumer has not freed this cell yet
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->entry.type = type;
+            cell->entry.message.swap(message);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool GALogQueue::pop(GALogEntry& out)
+        {
+            Cell& cell = _cells[_dequeuePos & _mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if(sequence != _dequeuePos + 1)
+            {
+                return false;
+            }
+
+            out.type = cell.entry.type;
+            out.message.swap(cell.entry.message);
+            cell.entry.message.clear();
+            cell.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+            ++_dequeuePos;
+            return true;
+        }
+
+        size_t GALogQueue::takeDropped()
+        {
+            return _dropped.exchange(0, std::memory_order_relaxed);
+        }
+    }
+}
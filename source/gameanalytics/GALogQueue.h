@@ -0,0 +1,63 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GALogger.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace gameanalytics
+{
+    namespace logging
+    {
+        struct GALogEntry
+        {
+            GALogEntry(): type(Info) {}
+
+            EGALoggerMessageType type;
+            std::string message;
+        };
+
+        // Bounded queue of log lines, any number of threads push without taking
+        // a lock and one thread at a time pops. A full queue drops the line
+        // instead of making the game thread wait for the log file.
+        class GALogQueue
+        {
+        public:
+            // capacity is rounded up to a power of two
+            explicit GALogQueue(size_t capacity);
+
+            // takes the contents of message, false if the queue is full
+            bool push(EGALoggerMessageType type, std::string& message);
+            // single consumer, false if the queue is empty
+            bool pop(GALogEntry& out);
+            // lines dropped because the queue was full since the last call
+            size_t takeDropped();
+
+            size_t capacity() const { return _mask + 1; }
+
+        private:
+            GALogQueue(const GALogQueue&) = delete;
+            GALogQueue& operator=(const GALogQueue&) = delete;
+
+            struct Cell
+            {
+                std::atomic<size_t> sequence;
+                GALogEntry entry;
+            };
+
+            std::unique_ptr<Cell[]> _cells;
+            size_t _mask;
+            // producers and the consumer work on separate cache lines
+            char _pad0[64];
+            std::atomic<size_t> _enqueuePos;
+            char _pad1[64];
+            size_t _dequeuePos;
+            std::atomic<size_t> _dropped;
+        };
+    }
+}
@@ -1,8 +1,10 @@
 #include "GALogger.h"
+#include "GALogQueue.h"
 #include "GameAnalytics.h"
 #include <iostream>
 #include "GADevice.h"
 #include <cstdarg>
+#include <cstring>
 #include <exception>
 #if USE_UWP
 #include "GAUtilities.h"
@@ -34,10 +36,15 @@ namespace gameanalytics
         bool GALogger::_destroyed = false;
         GALogger* GALogger::_instance = 0;
         std::once_flag GALogger::_initInstanceFlag;
+#if !NO_ASYNC
+        const size_t GALogger::QueueCapacity = 4096;
+        const int GALogger::FlushIntervalInMilliseconds = 50;
+#endif
 
         GALogger::GALogger()
         {
             infoLogEnabled = false;
+            infoLogVerboseEnabled = false;
 
 
 #if defined(_DEBUG)
@@ -50,17 +57,38 @@ namespace gameanalytics
 #if USE_UWP
             Windows::Storage::StorageFolder^ gaFolder = concurrency::create_task(Windows::Storage::ApplicationData::Current->LocalFolder->CreateFolderAsync("GameAnalytics", Windows::Storage::CreationCollisionOption::OpenIfExists)).get();
             file = concurrency::create_task(gaFolder->CreateFileAsync("ga_log.txt", Windows::Storage::CreationCollisionOption::ReplaceExisting)).get();
+            pendingLines = ref new Platform::Collections::Vector<Platform::String^>();
 #endif
 
 #if !USE_UWP && !USE_TIZEN
             logInitialized = false;
-            currentLogCount = 0;
-            maxLogCount = 5000;
+            logOpenFailed = false;
+            logFileSize = 0;
+            maxLogFileSize = 1024 * 1024;
+            maxLogFiles = 2;
+#endif
+
+#if !NO_ASYNC
+            _queue.reset(new GALogQueue(QueueCapacity));
+            _stopFlusher = false;
+            _flusher = std::thread(&GALogger::runFlusher, this);
 #endif
         }
 
         GALogger::~GALogger()
         {
+#if !NO_ASYNC
+            {
+                std::lock_guard<std::mutex> lock(_flusherMtx);
+                _stopFlusher = true;
+            }
+            _flusherCv.notify_one();
+            if(_flusher.joinable())
+            {
+                _flusher.join();
+            }
+            writeQueued();
+#endif
 #if !USE_UWP && !USE_TIZEN
             if(logInitialized)
             {
@@ -102,6 +130,54 @@ namespace gameanalytics
             i->infoLogVerboseEnabled = enabled;
         }
 
+        bool GALogger::isInfoLogEnabled()
+        {
+            GALogger* i = GALogger::getInstance();
+            return i && i->infoLogEnabled;
+        }
+
+        bool GALogger::isVerboseInfoLogEnabled()
+        {
+            GALogger* i = GALogger::getInstance();
+            return i && i->infoLogVerboseEnabled;
+        }
+
+        bool GALogger::isDebugEnabled()
+        {
+            GALogger* i = GALogger::getInstance();
+            return i && i->debugEnabled;
+        }
+
+        void GALogger::setLogRotation(long maxFileSize, int maxFiles)
+        {
+#if !USE_UWP && !USE_TIZEN
+            GALogger* i = GALogger::getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+            std::lock_guard<std::recursive_mutex> lock(i->_writeMtx);
+            i->maxLogFileSize = maxFileSize < 16 * 1024 ? 16 * 1024 : maxFileSize;
+            i->maxLogFiles = maxFiles < 1 ? 1 : (maxFiles > 10 ? 10 : maxFiles);
+#else
+            (void)maxFileSize;
+            (void)maxFiles;
+#endif
+        }
+
+        void GALogger::flush()
+        {
+            GALogger* i = GALogger::getInstance();
+            if(!i)
+            {
+                return;
+            }
+#if !NO_ASYNC
+            i->writeQueued();
+#endif
+        }
+
 #if !USE_UWP && !USE_TIZEN
         void GALogger::file_output_callback(const zf_log_message *msg, void *arg)
         {
@@ -112,9 +188,8 @@ namespace gameanalytics
             }
 
             (void)arg;
-            *msg->p = '\n';
-            fwrite(msg->buf, msg->p - msg->buf + 1, 1, i->log_file);
-            fflush(i->log_file);
+            std::string message(msg->buf, msg->p - msg->buf);
+            i->enqueue(Warning, message);
         }
 
         void GALogger::initializeLog()
@@ -125,7 +200,8 @@ namespace gameanalytics
                 return;
             }
 
-            if(!ga->logInitialized)
+            std::lock_guard<std::recursive_mutex> lock(ga->_writeMtx);
+            if(!ga->logInitialized && !ga->logOpenFailed)
             {
                 const char* writablepath = device::GADevice::getWritablePath();
 
@@ -138,13 +214,15 @@ namespace gameanalytics
                 ga->log_file = fopen(ga->p, "w");
                 if (!ga->log_file)
                 {
-                    ZF_LOGW("Failed to open log file %s", ga->p);
+                    // not through zf_log, its output would land in this queue again
+                    fprintf(stderr, "Failed to open log file %s\n", ga->p);
+                    ga->logOpenFailed = true;
                     return;
                 }
                 zf_log_set_output_v(ZF_LOG_PUT_STD, 0, file_output_callback);
 
                 ga->logInitialized = true;
-                ga->currentLogCount = 0;
+                ga->logFileSize = 0;
 
                 GALogger::i("Log file added under: %s", device::GADevice::getWritablePath());
             }
@@ -158,30 +236,146 @@ namespace gameanalytics
                 return;
             }
 
+            std::lock_guard<std::recursive_mutex> lock(ga->_writeMtx);
             if(ga->logInitialized)
             {
                 fclose(ga->log_file);
+                ga->logInitialized = false;
             }
+            ga->logOpenFailed = false;
+
+            initializeLog();
+        }
 
+        void GALogger::logFilePath(int index, char* out, size_t size)
+        {
             const char* writablepath = device::GADevice::getWritablePath();
+            if(index == 0)
+            {
+                snprintf(out, size, "%s%sga_log.txt", writablepath, utilities::GAUtilities::getPathSeparator());
+            }
+            else
+            {
+                snprintf(out, size, "%s%sga_log-%d.txt", writablepath, utilities::GAUtilities::getPathSeparator(), index);
+            }
+        }
 
-            if(device::GADevice::getWritablePathStatus() <= 0)
+        // ga_log.txt becomes ga_log-1.txt, ga_log-1.txt becomes ga_log-2.txt and so on,
+        // the oldest file is removed
+        void GALogger::rotateLogFile()
+        {
+            fclose(log_file);
+            logInitialized = false;
+
+            char from[513] = "";
+            char to[513] = "";
+            logFilePath(maxLogFiles - 1, to, sizeof(to));
+            remove(to);
+            for(int n = maxLogFiles - 1; n > 0; --n)
             {
-                return;
+                logFilePath(n - 1, from, sizeof(from));
+                logFilePath(n, to, sizeof(to));
+                rename(from, to);
             }
-            snprintf(ga->p, sizeof(ga->p), "%s%sga_log.txt", writablepath, utilities::GAUtilities::getPathSeparator());
 
-            ga->log_file = fopen(ga->p, "w");
-            if (!ga->log_file)
+            log_file = fopen(p, "w");
+            if (!log_file)
             {
-                ZF_LOGW("Failed to open log file %s", ga->p);
+                fprintf(stderr, "Failed to open log file %s\n", p);
+                logOpenFailed = true;
                 return;
             }
-            zf_log_set_output_v(ZF_LOG_PUT_STD, 0, file_output_callback);
+            logInitialized = true;
+            logFileSize = 0;
+        }
+#endif
 
-            ga->logInitialized = true;
+        void GALogger::log(EGALoggerMessageType type, const char* level, const char* format, va_list args)
+        {
+            try
+            {
+                va_list measureArgs;
+                va_copy(measureArgs, args);
+                int len = std::vsnprintf(NULL, 0, format, measureArgs);
+                va_end(measureArgs);
+                if(len < 0)
+                {
+                    return;
+                }
 
-            GALogger::i("Log file added under: %s", device::GADevice::getWritablePath());
+                std::string message(level);
+                message += "/";
+                message += tag;
+                message += ": ";
+                size_t prefixLength = message.size();
+                message.resize(prefixLength + len + 1);
+                std::vsnprintf(&message[prefixLength], len + 1, format, args);
+                message.resize(prefixLength + len);
+                enqueue(type, message);
+            }
+            catch(const std::exception& e)
+            {
+                if (!debugEnabled) {
+                    // No logging of debug unless in full debug logging mode
+                    return;
+                }
+                std::string message(format);
+                enqueue(Debug, message);
+            }
+        }
+
+        void GALogger::enqueue(EGALoggerMessageType type, std::string& message)
+        {
+#if NO_ASYNC
+            std::lock_guard<std::recursive_mutex> lock(_writeMtx);
+            sendNotificationMessage(message.c_str(), type);
+            flushOutput();
+#else
+            // errors and warnings are written right away, the rest with the next batch
+            if(_queue->push(type, message) && type <= Warning)
+            {
+                _flusherCv.notify_one();
+            }
+#endif
+        }
+
+#if !NO_ASYNC
+        void GALogger::runFlusher()
+        {
+            std::unique_lock<std::mutex> lock(_flusherMtx);
+            while(!_stopFlusher)
+            {
+                _flusherCv.wait_for(lock, std::chrono::milliseconds(FlushIntervalInMilliseconds));
+                lock.unlock();
+                writeQueued();
+                lock.lock();
+            }
+        }
+
+        void GALogger::writeQueued()
+        {
+            std::lock_guard<std::recursive_mutex> lock(_writeMtx);
+            bool wrote = false;
+            GALogEntry entry;
+            while(_queue->pop(entry))
+            {
+                sendNotificationMessage(entry.message.c_str(), entry.type);
+                wrote = true;
+            }
+
+            size_t dropped = _queue->takeDropped();
+            if(dropped > 0)
+            {
+                char message[128] = "";
+                snprintf(message, sizeof(message), "Warning/%s: %lu log messages dropped, the log queue was full", tag, static_cast<unsigned long>(dropped));
+                sendNotificationMessage(message, Warning);
+                wrote = true;
+            }
+
+            if(wrote)
+            {
+                flushOutput();
+            }
         }
 #endif
 
@@ -204,32 +398,10 @@ namespace gameanalytics
                 return;
             }
 
-            try
-            {
-                va_list args;
-                va_start (args, format);
-                size_t len = std::vsnprintf(NULL, 0, format, args);
-                va_end (args);
-                char* formatted = new char[len + 1];
-                va_start (args, format);
-                std::vsnprintf(formatted, len + 1, format, args);
-                va_end (args);
-
-                size_t s = len + 1 + 11 + strlen(ga->tag);
-                char* message = new char[s];
-                snprintf(message, s, "Info/%s: %s", ga->tag, formatted);
-                ga->sendNotificationMessage(message, Info);
-                delete[] message;
-                delete[] formatted;
-            }
-            catch(const std::exception& e)
-            {
-                if (!ga->debugEnabled) {
-                    // No logging of debug unless in full debug logging mode
-                    return;
-                }
-                ga->sendNotificationMessage(format, Debug);
-            }
+            va_list args;
+            va_start (args, format);
+            ga->log(Info, "Info", format, args);
+            va_end (args);
         }
 
 
@@ -247,32 +419,10 @@ namespace gameanalytics
                 return;
             }
 
-            try
-            {
-                va_list args;
-                va_start (args, format);
-                size_t len = std::vsnprintf(NULL, 0, format, args);
-                va_end (args);
-                char* formatted = new char[len + 1];
-                va_start (args, format);
-                std::vsnprintf(formatted, len + 1, format, args);
-                va_end (args);
-
-                size_t s = len + 1 + 14 + strlen(ga->tag);
-                char* message = new char[s];
-                snprintf(message, s, "Warning/%s: %s", ga->tag, formatted);
-                ga->sendNotificationMessage(message, Warning);
-                delete[] message;
-                delete[] formatted;
-            }
-            catch(const std::exception& e)
-            {
-                if (!ga->debugEnabled) {
-                    // No logging of debug unless in full debug logging mode
-                    return;
-                }
-                ga->sendNotificationMessage(format, Debug);
-            }
+            va_list args;
+            va_start (args, format);
+            ga->log(Warning, "Warning", format, args);
+            va_end (args);
         }
 
 
@@ -291,32 +441,10 @@ namespace gameanalytics
                 return;
             }
 
-            try
-            {
-                va_list args;
-                va_start (args, format);
-                size_t len = std::vsnprintf(NULL, 0, format, args);
-                va_end (args);
-                char* formatted = new char[len + 1];
-                va_start (args, format);
-                std::vsnprintf(formatted, len + 1, format, args);
-                va_end (args);
-
-                size_t s = len + 1 + 12 + strlen(ga->tag);
-                char* message = new char[s];
-                snprintf(message, s, "Error/%s: %s", ga->tag, formatted);
-                ga->sendNotificationMessage(message, Error);
-                delete[] message;
-                delete[] formatted;
-            }
-            catch(const std::exception& e)
-            {
-                if (!ga->debugEnabled) {
-                    // No logging of debug unless in full debug logging mode
-                    return;
-                }
-                ga->sendNotificationMessage(format, Debug);
-            }
+            va_list args;
+            va_start (args, format);
+            ga->log(Error, "Error", format, args);
+            va_end (args);
         }
 
 
@@ -338,32 +466,10 @@ namespace gameanalytics
                 return;
             }
 
-            try
-            {
-                va_list args;
-                va_start (args, format);
-                size_t len = std::vsnprintf(NULL, 0, format, args);
-                va_end (args);
-                char* formatted = new char[len + 1];
-                va_start (args, format);
-                std::vsnprintf(formatted, len + 1, format, args);
-                va_end (args);
-
-                size_t s = len + 1 + 12 + strlen(ga->tag);
-                char* message = new char[s];
-                snprintf(message, s, "Debug/%s: %s", ga->tag, formatted);
-                ga->sendNotificationMessage(message, Debug);
-                delete[] message;
-                delete[] formatted;
-            }
-            catch(const std::exception& e)
-            {
-                if (!ga->debugEnabled) {
-                    // No logging of debug unless in full debug logging mode
-                    return;
-                }
-                ga->sendNotificationMessage(format, Debug);
-            }
+            va_list args;
+            va_start (args, format);
+            ga->log(Debug, "Debug", format, args);
+            va_end (args);
         }
 
 
@@ -384,180 +490,86 @@ namespace gameanalytics
                 return;
             }
 
-            try
-            {
-                va_list args;
-                va_start (args, format);
-                size_t len = std::vsnprintf(NULL, 0, format, args);
-                va_end (args);
-                char* formatted = new char[len + 1];
-                va_start (args, format);
-                std::vsnprintf(formatted, len + 1, format, args);
-                va_end (args);
-
-                size_t s = len + 1 + 14 + strlen(ga->tag);
-                char* message = new char[s];
-                snprintf(message, s, "Verbose/%s: %s", ga->tag, formatted);
-                ga->sendNotificationMessage(message, Info);
-                delete[] message;
-                delete[] formatted;
-            }
-            catch(const std::exception& e)
-            {
-                if (!ga->debugEnabled) {
-                    // No logging of debug unless in full debug logging mode
-                    return;
-                }
-                ga->sendNotificationMessage(format, Debug);
-            }
+            va_list args;
+            va_start (args, format);
+            ga->log(Info, "Verbose", format, args);
+            va_end (args);
         }
 
         void GALogger::sendNotificationMessage(const char* message, EGALoggerMessageType type)
         {
-            if(GameAnalytics::isThreadEnding())
-            {
-                //return;
-            }
-#if !USE_UWP && !USE_TIZEN
-            if(logInitialized)
-            {
-                ++currentLogCount;
-                if(currentLogCount >= maxLogCount)
-                {
-                    fclose(log_file);
-
-                    char p_prev[513] = "";
-                    const char* writablepath = device::GADevice::getWritablePath();
-
-                    if(device::GADevice::getWritablePathStatus() <= 0)
-                    {
-                        return;
-                    }
-                    snprintf(p_prev, sizeof(p_prev), "%s%sga_log-prev.txt", writablepath, utilities::GAUtilities::getPathSeparator());
-
-                    log_file = fopen(p, "r");
-                    if (!log_file)
-                    {
-                        ZF_LOGW("Failed to open log file %s", p);
-                        return;
-                    }
-                    FILE *log_file_prev;
-                    log_file_prev = fopen(p_prev, "w");
-                    if (!log_file_prev)
-                    {
-                        ZF_LOGW("Failed to open log file %s", p_prev);
-                        return;
-                    }
-
-                    char ch;
-                    while((ch = fgetc(log_file)) != EOF)
-                    {
-                        fputc(ch, log_file_prev);
-                    }
-
-                    fclose(log_file);
-                    fclose(log_file_prev);
-
-                    log_file = fopen(p, "w");
-                    if (!log_file)
-                    {
-                        ZF_LOGW("Failed to open log file %s", p);
-                        return;
-                    }
-                    currentLogCount = 0;
-                }
-            }
-#endif
 #if USE_UWP
+            (void)type;
             auto m = ref new Platform::String(utilities::GAUtilities::s2ws(message).c_str());
-            Platform::Collections::Vector<Platform::String^>^ lines = ref new Platform::Collections::Vector<Platform::String^>();
-            lines->Append(m);
-#endif
-
-#if !USE_UWP && !USE_TIZEN
-            if(!logInitialized)
-            {
-                initializeLog();
-            }
-            if(device::GADevice::getWritablePathStatus() <= 0)
-            {
-                return;
-            }
-#endif
+            pendingLines->Append(m);
+            LogMessageToConsole(m);
+#elif USE_TIZEN
             switch(type)
             {
                 case Error:
-#if USE_UWP
-                    try
-                    {
-                        concurrency::create_task(Windows::Storage::FileIO::AppendLinesAsync(file, lines)).wait();
-                    }
-                    catch (const std::exception&)
-                    {
-                    }
-                    LogMessageToConsole(m);
-#elif USE_TIZEN
                     dlog_print(DLOG_ERROR, GALogger::tag, message);
-#else
-                    std::cout << message << std::endl;
-                    fprintf(log_file, "%s\n", message);
-#endif
                     break;
 
                 case Warning:
-#if USE_UWP
-                    try
-                    {
-                        concurrency::create_task(Windows::Storage::FileIO::AppendLinesAsync(file, lines)).wait();
-                    }
-                    catch (const std::exception&)
-                    {
-                    }
-                    LogMessageToConsole(m);
-#elif USE_TIZEN
                     dlog_print(DLOG_WARN, GALogger::tag, message);
-#else
-                    std::cout << message << std::endl;
-                    fprintf(log_file, "%s\n", message);
-#endif
                     break;
 
                 case Debug:
-#if USE_UWP
-                    try
-                    {
-                        concurrency::create_task(Windows::Storage::FileIO::AppendLinesAsync(file, lines)).wait();
-                    }
-                    catch (const std::exception&)
-                    {
-                    }
-                    LogMessageToConsole(m);
-#elif USE_TIZEN
                     dlog_print(DLOG_DEBUG, GALogger::tag, message);
-#else
-                    std::cout << message << std::endl;
-                    fprintf(log_file, "%s\n", message);
-#endif
                     break;
 
                 case Info:
-#if USE_UWP
-                    try
-                    {
-                        concurrency::create_task(Windows::Storage::FileIO::AppendLinesAsync(file, lines)).wait();
-                    }
-                    catch (const std::exception&)
-                    {
-                    }
-                    LogMessageToConsole(m);
-#elif USE_TIZEN
                     dlog_print(DLOG_INFO, GALogger::tag, message);
+                    break;
+            }
 #else
-                    std::cout << message << std::endl;
-                    fprintf(log_file, "%s\n", message);
+            (void)type;
+            if(!logInitialized)
+            {
+                initializeLog();
+            }
+            if(device::GADevice::getWritablePathStatus() <= 0)
+            {
+                return;
+            }
+
+            std::cout << message << '\n';
+            if(logInitialized)
+            {
+                size_t length = strlen(message);
+                fwrite(message, 1, length, log_file);
+                fputc('\n', log_file);
+                logFileSize += static_cast<long>(length + 1);
+                if(logFileSize >= maxLogFileSize)
+                {
+                    rotateLogFile();
+                }
+            }
 #endif
-                    break;
+        }
+
+        void GALogger::flushOutput()
+        {
+#if USE_UWP
+            if(pendingLines->Size == 0)
+            {
+                return;
+            }
+            try
+            {
+                concurrency::create_task(Windows::Storage::FileIO::AppendLinesAsync(file, pendingLines)).wait();
             }
+            catch (const std::exception&)
+            {
+            }
+            pendingLines = ref new Platform::Collections::Vector<Platform::String^>();
+#elif !USE_TIZEN
+            std::cout.flush();
+            if(logInitialized)
+            {
+                fflush(log_file);
+            }
+#endif
         }
 
 #if USE_UWP
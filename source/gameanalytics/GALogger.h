@@ -13,6 +13,37 @@
 #endif
 #include <mutex>
 #include <cstdlib>
+#include <cstdarg>
+#include <string>
+#if !NO_ASYNC
+#include <thread>
+#include <condition_variable>
+#endif
+
+// Highest level compiled in, calls above it are removed by the compiler.
+// Debug logging only exists in _DEBUG builds unless GA_LOG_LEVEL is defined.
+#define GA_LOG_LEVEL_ERROR 0
+#define GA_LOG_LEVEL_WARNING 1
+#define GA_LOG_LEVEL_INFO 2
+#define GA_LOG_LEVEL_VERBOSE 3
+#define GA_LOG_LEVEL_DEBUG 4
+
+#ifndef GA_LOG_LEVEL
+#if defined(_DEBUG)
+#define GA_LOG_LEVEL GA_LOG_LEVEL_DEBUG
+#else
+#define GA_LOG_LEVEL GA_LOG_LEVEL_VERBOSE
+#endif
+#endif
+
+#define GA_LOG_INFO_ENABLED() (GA_LOG_LEVEL >= GA_LOG_LEVEL_INFO && ::gameanalytics::logging::GALogger::isInfoLogEnabled())
+#define GA_LOG_VERBOSE_ENABLED() (GA_LOG_LEVEL >= GA_LOG_LEVEL_VERBOSE && ::gameanalytics::logging::GALogger::isVerboseInfoLogEnabled())
+#define GA_LOG_DEBUG_ENABLED() (GA_LOG_LEVEL >= GA_LOG_LEVEL_DEBUG && ::gameanalytics::logging::GALogger::isDebugEnabled())
+
+// the arguments are only evaluated when the level is enabled
+#define GA_LOG_INFO(...) do { if(GA_LOG_INFO_ENABLED()) { ::gameanalytics::logging::GALogger::i(__VA_ARGS__); } } while(0)
+#define GA_LOG_VERBOSE(...) do { if(GA_LOG_VERBOSE_ENABLED()) { ::gameanalytics::logging::GALogger::ii(__VA_ARGS__); } } while(0)
+#define GA_LOG_DEBUG(...) do { if(GA_LOG_DEBUG_ENABLED()) { ::gameanalytics::logging::GALogger::d(__VA_ARGS__); } } while(0)
 
 namespace gameanalytics
 {
@@ -26,20 +57,35 @@ namespace gameanalytics
             Debug = 3
         };
 
+        class GALogQueue;
+
+        // Callers format the line and hand it to a lock free queue, a flusher
+        // thread writes the queued lines to the console and log file in batches.
+        // With NO_ASYNC lines are written on the calling thread.
         class GALogger
         {
          public:
             // set debug enabled (client)
             static void setInfoLog(bool enabled);
             static void setVerboseInfoLog(bool enabled);
+            static bool isInfoLogEnabled();
+            static bool isVerboseInfoLogEnabled();
+            static bool isDebugEnabled();
 
             // Debug (w/e always shows, d only shows during SDK development, i shows when client has set debugEnabled to YES)
+            // use the GA_LOG_* macros for i, ii and d so disabled levels cost nothing
             static void  w(const char* format, ...);
             static void  e(const char* format, ...);
             static void  d(const char* format, ...);
             static void  i(const char* format, ...);
             static void ii(const char* format, ...);
 
+            // the log file is renamed to ga_log-1.txt when it reaches maxFileSize
+            // bytes and at most maxFiles files are kept (default 1 MB, 2 files)
+            static void setLogRotation(long maxFileSize, int maxFiles);
+            // writes the queued lines before returning
+            static void flush();
+
 #if !USE_UWP && !USE_TIZEN
             static void customInitializeLog();
 #endif
@@ -49,7 +95,12 @@ namespace gameanalytics
             GALogger(const GALogger&) = delete;
             GALogger& operator=(const GALogger&) = delete;
 
+            void log(EGALoggerMessageType type, const char* level, const char* format, va_list args);
+            void enqueue(EGALoggerMessageType type, std::string& message);
+            void writeQueued();
+            // called with _writeMtx held
             void sendNotificationMessage(const char* message, EGALoggerMessageType type);
+            void flushOutput();
 
             static bool _destroyed;
             static GALogger* _instance;
@@ -74,16 +125,35 @@ namespace gameanalytics
             bool infoLogVerboseEnabled;
             bool debugEnabled;
             static const char* tag;
+
+            std::recursive_mutex _writeMtx;
+#if !NO_ASYNC
+            static const size_t QueueCapacity;
+            static const int FlushIntervalInMilliseconds;
+            void runFlusher();
+
+            std::unique_ptr<GALogQueue> _queue;
+            std::thread _flusher;
+            bool _stopFlusher;
+            std::mutex _flusherMtx;
+            std::condition_variable _flusherCv;
+#endif
 #if USE_UWP
             static void LogMessageToConsole(Platform::Object^ parameter);
             Windows::Storage::StorageFile^ file;
+            Windows::Foundation::Collections::IVector<Platform::String^>^ pendingLines;
 #endif
 #if !USE_UWP && !USE_TIZEN
             static void file_output_callback(const zf_log_message *msg, void *arg);
+            void rotateLogFile();
+            void logFilePath(int index, char* out, size_t size);
             bool logInitialized;
+            // not retried for every line, only when the log is set up again
+            bool logOpenFailed;
             FILE *log_file;
-            int currentLogCount;
-            int maxLogCount;
+            long logFileSize;
+            long maxLogFileSize;
+            int maxLogFiles;
             char p[513] = {'\0'};
 #endif
         };
@@ -0,0 +1,355 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAMetrics.h"
+#include "GALogger.h"
+#include <exception>
+#include <algorithm>
+
+namespace gameanalytics
+{
+    namespace metrics
+    {
+        static const double BatchSizeBounds[GAMetricsHistogram::BucketCount - 1] = { 1, 2, 5, 10, 20, 50, 100, 200, 300, 500, 750, 1000, 2000, 5000, 10000 };
+        static const double RatioBounds[GAMetricsHistogram::BucketCount - 1] = { 0.05, 0.1, 0.15, 0.2, 0.25, 0.3, 0.35, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1, 1.5 };
+        // milliseconds, work done on this device
+        static const double LocalTimeBounds[GAMetricsHistogram::BucketCount - 1] = { 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100, 250, 1000 };
+        // milliseconds, round trips to the collector
+        static const double NetworkTimeBounds[GAMetricsHistogram::BucketCount - 1] = { 10, 25, 50, 100, 150, 200, 300, 500, 750, 1000, 2000, 5000, 10000, 30000, 60000 };
+
+        GAHistogram::GAHistogram():
+            _bounds(LocalTimeBounds)
+        {
+            reset();
+        }
+
+        void GAHistogram::setBounds(const double* bounds)
+        {
+            _bounds = bounds;
+        }
+
+        void GAHistogram::record(double value)
+        {
+            int bucket = 0;
+            while(bucket < GAMetricsHistogram::BucketCount - 1 && value > _bounds[bucket])
+            {
+                ++bucket;
+            }
+            _counts[bucket].fetch_add(1, std::memory_order_relaxed);
+            _count.fetch_add(1, std::memory_order_relaxed);
+
+            double sum = _sum.load(std::memory_order_relaxed);
+            while(!_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed))
+            {
+            }
+            double max = _max.load(std::memory_order_relaxed);
+            while(value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void GAHistogram::snapshot(GAMetricsHistogram& out) const
+        {
+            for(int i = 0; i < GAMetricsHistogram::BucketCount - 1; ++i)
+            {
+                out.bounds[i] = _bounds[i];
+            }
+            for(int i = 0; i < GAMetricsHistogram::BucketCount; ++i)
+            {
+                out.counts[i] = _counts[i].load(std::memory_order_relaxed);
+            }
+            out.count = _count.load(std::memory_order_relaxed);
+            out.sum = _sum.load(std::memory_order_relaxed);
+            out.max = _max.load(std::memory_order_relaxed);
+        }
+
+        void GAHistogram::reset()
+        {
+            for(int i = 0; i < GAMetricsHistogram::BucketCount; ++i)
+            {
+                _counts[i] = 0;
+            }
+            _count = 0;
+            _sum = 0;
+            _max = 0;
+        }
+
+        GAMetricsRegistry::GAMetricsRegistry()
+        {
+            for(int i = 0; i < CounterCount; ++i)
+            {
+                _counters[i] = 0;
+            }
+            _dbSizeBytes = 0;
+            _dbEventRows = 0;
+
+            _histograms[BatchSize].setBounds(BatchSizeBounds);
+            _histograms[GzipRatio].setBounds(RatioBounds);
+            _histograms[GzipTime].setBounds(LocalTimeBounds);
+            _histograms[HmacTime].setBounds(LocalTimeBounds);
+            _histograms[HttpTime].setBounds(NetworkTimeBounds);
+            _histograms[QueryTime].setBounds(LocalTimeBounds);
+        }
+
+        void GAMetricsRegistry::add(EGAMetricsCounter counter, uint64_t value)
+        {
+            _counters[counter].fetch_add(value, std::memory_order_relaxed);
+        }
+
+        void GAMetricsRegistry::record(EGAMetricsHistogram histogram, double value)
+        {
+            _histograms[histogram].record(value);
+        }
+
+        void GAMetricsRegistry::recordStatusCode(long statusCode)
+        {
+            if(statusCode <= 0)
+            {
+                add(HttpNoResponse);
+            }
+            else if(statusCode >= 200 && statusCode < 300)
+            {
+                add(Http2xx);
+            }
+            else if(statusCode >= 400 && statusCode < 500)
+            {
+                add(Http4xx);
+            }
+            else if(statusCode >= 500 && statusCode < 600)
+            {
+                add(Http5xx);
+            }
+            else
+            {
+                add(HttpOther);
+            }
+        }
+
+        void GAMetricsRegistry::setStoreSize(long long sizeBytes, size_t eventRows)
+        {
+            _dbSizeBytes.store(sizeBytes > 0 ? static_cast<uint64_t>(sizeBytes) : 0, std::memory_order_relaxed);
+            _dbEventRows.store(eventRows, std::memory_order_relaxed);
+        }
+
+        void GAMetricsRegistry::snapshot(GAMetricsSnapshot& out) const
+        {
+            out.tasksEnqueued = _counters[TasksEnqueued].load(std::memory_order_relaxed);
+            out.tasksDropped = _counters[TasksDropped].load(std::memory_order_relaxed);
+            out.tasksProcessed = _counters[TasksProcessed].load(std::memory_order_relaxed);
+            // the counters are read one after the other, a task may have run in between
+            out.taskQueueDepth = out.tasksEnqueued > out.tasksProcessed ? out.tasksEnqueued - out.tasksProcessed : 0;
+            out.eventsStored = _counters[EventsStored].load(std::memory_order_relaxed);
+            out.eventsSent = _counters[EventsSent].load(std::memory_order_relaxed);
+            out.eventsRejected = _counters[EventsRejected].load(std::memory_order_relaxed);
+            out.batchRetries = _counters[BatchRetries].load(std::memory_order_relaxed);
+            out.dbSizeBytes = _dbSizeBytes.load(std::memory_order_relaxed);
+            out.dbEventRows = _dbEventRows.load(std::memory_order_relaxed);
+            out.httpNoResponse = _counters[HttpNoResponse].load(std::memory_order_relaxed);
+            out.http2xx = _counters[Http2xx].load(std::memory_order_relaxed);
+            out.http4xx = _counters[Http4xx].load(std::memory_order_relaxed);
+            out.http5xx = _counters[Http5xx].load(std::memory_order_relaxed);
+            out.httpOther = _counters[HttpOther].load(std::memory_order_relaxed);
+
+            _histograms[BatchSize].snapshot(out.batchSize);
+            _histograms[GzipRatio].snapshot(out.gzipRatio);
+            _histograms[GzipTime].snapshot(out.gzipTime);
+            _histograms[HmacTime].snapshot(out.hmacTime);
+            _histograms[HttpTime].snapshot(out.httpTime);
+            _histograms[QueryTime].snapshot(out.queryTime);
+        }
+
+        void GAMetricsRegistry::reset()
+        {
+            for(int c = 0; c < CounterCount; ++c)
+            {
+                _counters[c] = 0;
+            }
+            _dbSizeBytes = 0;
+            _dbEventRows = 0;
+            for(int h = 0; h < HistogramCount; ++h)
+            {
+                _histograms[h].reset();
+            }
+        }
+
+        bool GAMetrics::_destroyed = false;
+        GAMetrics* GAMetrics::_instance = 0;
+        std::once_flag GAMetrics::_initInstanceFlag;
+        const double GAMetrics::MinExportIntervalSeconds = 1;
+
+        GAMetrics::GAMetrics()
+        {
+#if !NO_ASYNC
+            _exportIntervalSeconds = 0;
+            _exportGeneration = 0;
+            _stopExport = false;
+#endif
+        }
+
+        GAMetrics::~GAMetrics()
+        {
+#if !NO_ASYNC
+            {
+                std::lock_guard<std::mutex> lock(_exportMtx);
+                _stopExport = true;
+            }
+            _exportCv.notify_one();
+            if(_exportThread.joinable())
+            {
+                _exportThread.join();
+            }
+#endif
+        }
+
+        void GAMetrics::cleanUp()
+        {
+            delete _instance;
+            _instance = 0;
+            _destroyed = true;
+        }
+
+        GAMetrics* GAMetrics::getInstance()
+        {
+            std::call_once(_initInstanceFlag, &GAMetrics::initInstance);
+            return _instance;
+        }
+
+        void GAMetrics::add(EGAMetricsCounter counter, uint64_t value)
+        {
+            GAMetrics* i = GAMetrics::getInstance();
+            if(!i)
+            {
+                return;
+            }
+            i->_registry.add(counter, value);
+        }
+
+        void GAMetrics::record(EGAMetricsHistogram histogram, double value)
+        {
+            GAMetrics* i = GAMetrics::getInstance();
+            if(!i)
+            {
+                return;
+            }
+            i->_registry.record(histogram, value);
+        }
+
+        void GAMetrics::recordStatusCode(long statusCode)
+        {
+            GAMetrics* i = GAMetrics::getInstance();
+            if(!i)
+            {
+                return;
+            }
+            i->_registry.recordStatusCode(statusCode);
+        }
+
+        void GAMetrics::setStoreSize(long long sizeBytes, size_t eventRows)
+        {
+            GAMetrics* i = GAMetrics::getInstance();
+            if(!i)
+            {
+                return;
+            }
+            i->_registry.setStoreSize(sizeBytes, eventRows);
+        }
+
+        GAMetricsSnapshot GAMetrics::snapshot()
+        {
+            GAMetricsSnapshot out = GAMetricsSnapshot();
+            GAMetrics* i = GAMetrics::getInstance();
+            if(!i)
+            {
+                return out;
+            }
+            i->_registry.snapshot(out);
+            return out;
+        }
+
+        void GAMetrics::reset()
+        {
+            GAMetrics* i = GAMetrics::getInstance();
+            if(!i)
+            {
+                return;
+            }
+            i->_registry.reset();
+        }
+
+        void GAMetrics::setExport(double intervalSeconds, const GAMetricsCallback& callback)
+        {
+            GAMetrics* i = GAMetrics::getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+#if NO_ASYNC
+            logging::GALogger::w("Metrics export needs a thread and is not available in this build, poll getMetrics instead");
+#else
+            {
+                std::lock_guard<std::mutex> lock(i->_exportMtx);
+                i->_exportCallback = callback;
+                i->_exportIntervalSeconds = std::max(intervalSeconds, MinExportIntervalSeconds);
+                ++i->_exportGeneration;
+
+                // started under the lock so concurrent calls start only one thread,
+                // it waits for the lock before reading the export settings
+                if(callback && !i->_exportThread.joinable())
+                {
+                    i->_exportThread = std::thread(&GAMetrics::runExport, i);
+                }
+            }
+            i->_exportCv.notify_one();
+#endif
+        }
+
+#if !NO_ASYNC
+        void GAMetrics::runExport()
+        {
+            std::unique_lock<std::mutex> lock(_exportMtx);
+            std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<long long>(1000 * _exportIntervalSeconds));
+            while(!_stopExport)
+            {
+                // a changed export starts a new interval
+                unsigned int generation = _exportGeneration;
+                if(_exportCv.wait_until(lock, next, [this, generation]() { return _stopExport || _exportGeneration != generation; }))
+                {
+                    next = std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<long long>(1000 * _exportIntervalSeconds));
+                    continue;
+                }
+                next += std::chrono::milliseconds(static_cast<long long>(1000 * _exportIntervalSeconds));
+                if(!_exportCallback)
+                {
+                    continue;
+                }
+
+                GAMetricsCallback callback = _exportCallback;
+                lock.unlock();
+                try
+                {
+                    callback(snapshot());
+                }
+                catch(const std::exception& e)
+                {
+                    logging::GALogger::e("Error in metrics export callback: %s", e.what());
+                }
+                lock.lock();
+            }
+        }
+#endif
+
+        GAMetricsTimer::GAMetricsTimer(EGAMetricsHistogram histogram):
+            _histogram(histogram),
+            _start(std::chrono::steady_clock::now())
+        {
+        }
+
+        GAMetricsTimer::~GAMetricsTimer()
+        {
+            GAMetrics::record(_histogram, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start).count());
+        }
+    }
+}
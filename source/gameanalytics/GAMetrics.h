@@ -0,0 +1,166 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <cstdlib>
+#if !NO_ASYNC
+#include <thread>
+#include <condition_variable>
+#endif
+
+namespace gameanalytics
+{
+    namespace metrics
+    {
+        enum EGAMetricsCounter
+        {
+            TasksEnqueued = 0,
+            TasksDropped,
+            TasksProcessed,
+            EventsStored,
+            EventsSent,
+            EventsRejected,
+            BatchRetries,
+            HttpNoResponse,
+            Http2xx,
+            Http4xx,
+            Http5xx,
+            HttpOther,
+            CounterCount
+        };
+
+        enum EGAMetricsHistogram
+        {
+            BatchSize = 0,
+            GzipRatio,
+            GzipTime,
+            HmacTime,
+            HttpTime,
+            QueryTime,
+            HistogramCount
+        };
+
+        // Fixed bucket histogram that any thread can record into without a lock
+        class GAHistogram
+        {
+        public:
+            GAHistogram();
+
+            // GAMetricsHistogram::BucketCount - 1 ascending upper bounds, not copied
+            void setBounds(const double* bounds);
+            void record(double value);
+            void snapshot(GAMetricsHistogram& out) const;
+            void reset();
+
+        private:
+            GAHistogram(const GAHistogram&) = delete;
+            GAHistogram& operator=(const GAHistogram&) = delete;
+
+            const double* _bounds;
+            std::atomic<uint64_t> _counts[GAMetricsHistogram::BucketCount];
+            std::atomic<uint64_t> _count;
+            std::atomic<double> _sum;
+            std::atomic<double> _max;
+        };
+
+        // Counters, store gauges and histograms of the SDK pipeline. Recording is
+        // a relaxed atomic update, a snapshot is not taken atomically across counters.
+        class GAMetricsRegistry
+        {
+        public:
+            GAMetricsRegistry();
+
+            void add(EGAMetricsCounter counter, uint64_t value = 1);
+            void record(EGAMetricsHistogram histogram, double value);
+            void recordStatusCode(long statusCode);
+            void setStoreSize(long long sizeBytes, size_t eventRows);
+
+            void snapshot(GAMetricsSnapshot& out) const;
+            void reset();
+
+        private:
+            GAMetricsRegistry(const GAMetricsRegistry&) = delete;
+            GAMetricsRegistry& operator=(const GAMetricsRegistry&) = delete;
+
+            std::atomic<uint64_t> _counters[CounterCount];
+            std::atomic<uint64_t> _dbSizeBytes;
+            std::atomic<uint64_t> _dbEventRows;
+            GAHistogram _histograms[HistogramCount];
+        };
+
+        // The process wide registry and its periodic export
+        class GAMetrics
+        {
+        public:
+            static void add(EGAMetricsCounter counter, uint64_t value = 1);
+            static void record(EGAMetricsHistogram histogram, double value);
+            static void recordStatusCode(long statusCode);
+            static void setStoreSize(long long sizeBytes, size_t eventRows);
+
+            static GAMetricsSnapshot snapshot();
+            static void reset();
+
+            // a null callback stops the export
+            static void setExport(double intervalSeconds, const GAMetricsCallback& callback);
+
+        private:
+            GAMetrics();
+            ~GAMetrics();
+            GAMetrics(const GAMetrics&) = delete;
+            GAMetrics& operator=(const GAMetrics&) = delete;
+
+            static bool _destroyed;
+            static GAMetrics* _instance;
+            static std::once_flag _initInstanceFlag;
+            static void cleanUp();
+            static GAMetrics* getInstance();
+
+            static void initInstance()
+            {
+                if(!_destroyed && !_instance)
+                {
+                    _instance = new GAMetrics();
+                    std::atexit(&cleanUp);
+                }
+            }
+
+            static const double MinExportIntervalSeconds;
+
+            GAMetricsRegistry _registry;
+
+#if !NO_ASYNC
+            void runExport();
+
+            std::thread _exportThread;
+            std::mutex _exportMtx;
+            std::condition_variable _exportCv;
+            GAMetricsCallback _exportCallback;
+            double _exportIntervalSeconds;
+            unsigned int _exportGeneration;
+            bool _stopExport;
+#endif
+        };
+
+        // records the milliseconds from construction to destruction
+        class GAMetricsTimer
+        {
+        public:
+            explicit GAMetricsTimer(EGAMetricsHistogram histogram);
+            ~GAMetricsTimer();
+
+        private:
+            GAMetricsTimer(const GAMetricsTimer&) = delete;
+            GAMetricsTimer& operator=(const GAMetricsTimer&) = delete;
+
+            EGAMetricsHistogram _histogram;
+            std::chrono::steady_clock::time_point _start;
+        };
+    }
+}
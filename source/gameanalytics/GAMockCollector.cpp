@@ -0,0 +1,316 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAMockCollector.h"
+#include "rapidjson/document.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/stringbuffer.h"
+#include <string>
+#include <vector>
+#include <ctime>
+
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "miniz.c"
+
+namespace gameanalytics
+{
+    namespace http
+    {
+        // header and trailer around the deflate data, see GAGzipCompressor
+        static const size_t GzipHeaderSize = 10;
+        static const size_t GzipTrailerSize = 8;
+
+        static bool decodeBody(const GATransportRequest& request, std::string& out)
+        {
+            if(!request.gzip)
+            {
+                out.assign(request.body, request.size);
+                return true;
+            }
+
+            const unsigned char* data = reinterpret_cast<const unsigned char*>(request.body);
+            // only the plain header written by the SDK, no optional fields
+            if(request.size < GzipHeaderSize + GzipTrailerSize || data[0] != 0x1f || data[1] != 0x8b || data[3] != 0)
+            {
+                return false;
+            }
+
+            size_t length = 0;
+            void* inflated = tinfl_decompress_mem_to_heap(data + GzipHeaderSize, request.size - GzipHeaderSize - GzipTrailerSize, &length, 0);
+            if(!inflated)
+            {
+                return false;
+            }
+            out.assign(static_cast<const char*>(inflated), length);
+            mz_free(inflated);
+            return true;
+        }
+
+        GAMockCollector::GAMockCollector():
+            GAMockCollector(std::random_device()())
+        {
+        }
+
+        GAMockCollector::GAMockCollector(uint32_t seed):
+            _random(seed),
+            _latencySeconds(0),
+            _dropRate(0),
+            _serverErrorRate(0),
+            _badEventRate(0),
+            _requests(0),
+            _eventsAccepted(0),
+            _eventsRejected(0),
+            _payloadBytes(0),
+            _stop(false)
+        {
+        }
+
+        GAMockCollector::~GAMockCollector()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                _stop = true;
+            }
+            _changed.notify_all();
+            if(_thread.joinable())
+            {
+                _thread.join();
+            }
+
+            // requests still waiting for their latency are answered as dropped
+            for(std::multimap<std::chrono::steady_clock::time_point, Pending>::iterator it = _pending.begin(); it != _pending.end(); ++it)
+            {
+                GATransportResponse dropped;
+                dropped.statusCode = 0;
+                it->second.done(dropped);
+            }
+            _pending.clear();
+        }
+
+        void GAMockCollector::setLatency(double seconds)
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _latencySeconds = seconds > 0 ? seconds : 0;
+        }
+
+        void GAMockCollector::setDropRate(double rate)
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _dropRate = rate;
+        }
+
+        void GAMockCollector::setServerErrorRate(double rate)
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _serverErrorRate = rate;
+        }
+
+        void GAMockCollector::setBadEventRate(double rate)
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _badEventRate = rate;
+        }
+
+        uint64_t GAMockCollector::requests()
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _requests;
+        }
+
+        uint64_t GAMockCollector::eventsAccepted()
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _eventsAccepted;
+        }
+
+        uint64_t GAMockCollector::eventsRejected()
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _eventsRejected;
+        }
+
+        uint64_t GAMockCollector::payloadBytes()
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _payloadBytes;
+        }
+
+        bool GAMockCollector::waitForEventsAccepted(uint64_t count, double timeoutSeconds)
+        {
+            std::unique_lock<std::mutex> lock(_mtx);
+            return _changed.wait_for(lock, std::chrono::duration<double>(timeoutSeconds), [this, count]() { return _eventsAccepted >= count; });
+        }
+
+        bool GAMockCollector::chance(double rate)
+        {
+            return rate > 0 && std::uniform_real_distribution<double>(0, 1)(_random) < rate;
+        }
+
+        GATransportResponse GAMockCollector::send(const GATransportRequest& request)
+        {
+            double latencySeconds = 0;
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                latencySeconds = _latencySeconds;
+            }
+            GATransportResponse response = respond(request);
+            if(latencySeconds > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::duration<double>(latencySeconds));
+            }
+            return response;
+        }
+
+        void GAMockCollector::sendAsync(const GATransportRequest& request, const std::function<void(const GATransportResponse&)>& done)
+        {
+            Pending pending;
+            pending.response = respond(request);
+            pending.done = done;
+
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                std::chrono::steady_clock::time_point due = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(_latencySeconds));
+                _pending.insert(std::make_pair(due, pending));
+                if(!_thread.joinable())
+                {
+                    _thread = std::thread(&GAMockCollector::run, this);
+                }
+            }
+            _changed.notify_all();
+        }
+
+        void GAMockCollector::run()
+        {
+            std::unique_lock<std::mutex> lock(_mtx);
+            while(!_stop)
+            {
+                if(_pending.empty())
+                {
+                    _changed.wait(lock);
+                    continue;
+                }
+
+                std::multimap<std::chrono::steady_clock::time_point, Pending>::iterator next = _pending.begin();
+                if(next->first > std::chrono::steady_clock::now())
+                {
+                    _changed.wait_until(lock, next->first);
+                    continue;
+                }
+
+                Pending pending = next->second;
+                _pending.erase(next);
+                lock.unlock();
+                pending.done(pending.response);
+                lock.lock();
+            }
+        }
+
+        GATransportResponse GAMockCollector::respond(const GATransportRequest& request)
+        {
+            GATransportResponse response;
+            response.statusCode = 0;
+
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                _requests++;
+                _payloadBytes += request.size;
+                if(chance(_dropRate))
+                {
+                    return response;
+                }
+                if(chance(_serverErrorRate))
+                {
+                    response.statusCode = 500;
+                    response.body = "{\"error\":\"mock server error\"}";
+                    return response;
+                }
+            }
+
+            if(!request.authorization || request.authorization[0] == '\0')
+            {
+                response.statusCode = 401;
+                response.body = "{\"error\":\"missing authorization\"}";
+                return response;
+            }
+
+            switch(request.type)
+            {
+                case TransportInit:
+                {
+                    char body[128] = "";
+                    snprintf(body, sizeof(body), "{\"server_ts\":%lld,\"configs\":[],\"configs_hash\":\"mock\"}", static_cast<long long>(time(NULL)));
+                    response.statusCode = 201;
+                    response.body = body;
+                    return response;
+                }
+                case TransportEvents:
+                    return respondToEvents(request);
+                case TransportSdkError:
+                default:
+                    response.statusCode = 200;
+                    response.body = "{}";
+                    return response;
+            }
+        }
+
+        GATransportResponse GAMockCollector::respondToEvents(const GATransportRequest& request)
+        {
+            GATransportResponse response;
+            response.statusCode = 400;
+
+            std::string json;
+            rapidjson::Document events;
+            if(!decodeBody(request, json) || events.Parse(json.c_str()).HasParseError() || !events.IsArray())
+            {
+                response.body = "{\"error\":\"body is not a JSON array\"}";
+                return response;
+            }
+
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            writer.StartArray();
+            uint64_t rejected = 0;
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                for(rapidjson::SizeType i = 0; i < events.Size(); ++i)
+                {
+                    if(!events[i].IsObject() || chance(_badEventRate))
+                    {
+                        writer.StartObject();
+                        writer.Key("index");
+                        writer.Uint(i);
+                        writer.Key("error");
+                        writer.String("mock validation error");
+                        writer.EndObject();
+                        rejected++;
+                    }
+                }
+
+                if(rejected > 0)
+                {
+                    _eventsRejected += rejected;
+                }
+                else
+                {
+                    _eventsAccepted += events.Size();
+                }
+            }
+            writer.EndArray();
+            _changed.notify_all();
+
+            if(rejected > 0)
+            {
+                response.body = buffer.GetString();
+            }
+            else
+            {
+                response.statusCode = 200;
+                response.body = "{}";
+            }
+            return response;
+        }
+    }
+}
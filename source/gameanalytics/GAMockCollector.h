@@ -0,0 +1,87 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics.h"
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+namespace gameanalytics
+{
+    namespace http
+    {
+        // In-process collector for tests and benchmarks, set it with
+        // GameAnalytics::configureTransport to run without a network. Init is
+        // answered with the server time, event batches are decoded and counted.
+        // Responses can be delayed, dropped, rejected per event (400 listing the
+        // failed events) or failed with a 500.
+        class GAMockCollector : public ITransport
+        {
+        public:
+            GAMockCollector();
+            explicit GAMockCollector(uint32_t seed);
+            // answers requests that are still pending with no response (status 0)
+            ~GAMockCollector();
+
+            GATransportResponse send(const GATransportRequest& request);
+            // answers from a worker thread once the latency has passed
+            void sendAsync(const GATransportRequest& request, const std::function<void(const GATransportResponse&)>& done);
+
+            void setLatency(double seconds);
+            // fraction of requests answered with no response (status 0)
+            void setDropRate(double rate);
+            // fraction of requests answered with a 500
+            void setServerErrorRate(double rate);
+            // fraction of events failing validation, a batch with any is a 400
+            void setBadEventRate(double rate);
+
+            uint64_t requests();
+            // events in batches that were answered with a 200
+            uint64_t eventsAccepted();
+            uint64_t eventsRejected();
+            uint64_t payloadBytes();
+            // false on timeout
+            bool waitForEventsAccepted(uint64_t count, double timeoutSeconds);
+
+        private:
+            GAMockCollector(const GAMockCollector&) = delete;
+            GAMockCollector& operator=(const GAMockCollector&) = delete;
+
+            struct Pending
+            {
+                GATransportResponse response;
+                std::function<void(const GATransportResponse&)> done;
+            };
+
+            GATransportResponse respond(const GATransportRequest& request);
+            GATransportResponse respondToEvents(const GATransportRequest& request);
+            bool chance(double rate);
+            void run();
+
+            std::mutex _mtx;
+            std::condition_variable _changed;
+            std::mt19937 _random;
+            double _latencySeconds;
+            double _dropRate;
+            double _serverErrorRate;
+            double _badEventRate;
+
+            uint64_t _requests;
+            uint64_t _eventsAccepted;
+            uint64_t _eventsRejected;
+            uint64_t _payloadBytes;
+
+            std::multimap<std::chrono::steady_clock::time_point, Pending> _pending;
+            std::thread _thread;
+            bool _stop;
+        };
+    }
+}
@@ -0,0 +1,133 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAPlayerContexts.h"
+#include <functional>
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        const size_t GAPlayerContexts::ShardCount;
+        const size_t GAPlayerContexts::DefaultMaxPlayers;
+
+        static size_t perShard(size_t maxPlayers)
+        {
+            size_t n = (maxPlayers + GAPlayerContexts::ShardCount - 1) / GAPlayerContexts::ShardCount;
+            return n > 0 ? n : 1;
+        }
+
+        GAPlayerContexts::GAPlayerContexts():
+            _maxPlayers(DefaultMaxPlayers),
+            _maxPerShard(perShard(DefaultMaxPlayers))
+        {
+        }
+
+        void GAPlayerContexts::setMaxPlayers(size_t maxPlayers, GAPlayerContextVector& evicted)
+        {
+            _maxPlayers = maxPlayers;
+            _maxPerShard = perShard(maxPlayers);
+            for(size_t i = 0; i < ShardCount; ++i)
+            {
+                std::lock_guard<std::mutex> lock(_shards[i].mtx);
+                trim(_shards[i], _maxPerShard, evicted);
+            }
+        }
+
+        size_t GAPlayerContexts::getMaxPlayers() const
+        {
+            return _maxPlayers;
+        }
+
+        std::shared_ptr<GAPlayerContext> GAPlayerContexts::get(const std::string& userId)
+        {
+            Shard& shard = shardFor(userId);
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            std::unordered_map<std::string, Order::iterator>::iterator itr = shard.index.find(userId);
+            if(itr == shard.index.end())
+            {
+                return std::shared_ptr<GAPlayerContext>();
+            }
+
+            shard.order.splice(shard.order.begin(), shard.order, itr->second);
+            return *itr->second;
+        }
+
+        std::shared_ptr<GAPlayerContext> GAPlayerContexts::add(const std::string& userId, std::shared_ptr<GAPlayerContext>& replaced, GAPlayerContextVector& evicted)
+        {
+            std::shared_ptr<GAPlayerContext> player = std::make_shared<GAPlayerContext>();
+            player->userId = userId;
+
+            Shard& shard = shardFor(userId);
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            std::unordered_map<std::string, Order::iterator>::iterator itr = shard.index.find(userId);
+            if(itr != shard.index.end())
+            {
+                replaced = *itr->second;
+                shard.order.erase(itr->second);
+                shard.index.erase(itr);
+            }
+
+            trim(shard, _maxPerShard - 1, evicted);
+            shard.order.push_front(player);
+            shard.index[userId] = shard.order.begin();
+            return player;
+        }
+
+        std::shared_ptr<GAPlayerContext> GAPlayerContexts::remove(const std::string& userId)
+        {
+            Shard& shard = shardFor(userId);
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            std::unordered_map<std::string, Order::iterator>::iterator itr = shard.index.find(userId);
+            if(itr == shard.index.end())
+            {
+                return std::shared_ptr<GAPlayerContext>();
+            }
+
+            std::shared_ptr<GAPlayerContext> player = *itr->second;
+            shard.order.erase(itr->second);
+            shard.index.erase(itr);
+            return player;
+        }
+
+        void GAPlayerContexts::removeAll(GAPlayerContextVector& out)
+        {
+            for(size_t i = 0; i < ShardCount; ++i)
+            {
+                std::lock_guard<std::mutex> lock(_shards[i].mtx);
+                out.insert(out.end(), _shards[i].order.begin(), _shards[i].order.end());
+                _shards[i].order.clear();
+                _shards[i].index.clear();
+            }
+        }
+
+        size_t GAPlayerContexts::size()
+        {
+            size_t result = 0;
+            for(size_t i = 0; i < ShardCount; ++i)
+            {
+                std::lock_guard<std::mutex> lock(_shards[i].mtx);
+                result += _shards[i].index.size();
+            }
+            return result;
+        }
+
+        GAPlayerContexts::Shard& GAPlayerContexts::shardFor(const std::string& userId)
+        {
+            return _shards[std::hash<std::string>()(userId) % ShardCount];
+        }
+
+        void GAPlayerContexts::trim(Shard& shard, size_t maxSize, GAPlayerContextVector& evicted)
+        {
+            while(shard.index.size() > maxSize)
+            {
+                std::shared_ptr<GAPlayerContext> oldest = shard.order.back();
+                shard.index.erase(oldest->userId);
+                shard.order.pop_back();
+                evicted.push_back(oldest);
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include <unordered_map>
+#include <map>
+#include <list>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        // Session state of one player in multi-user (server) mode, what GAState
+        // holds for the local user. Only touched on the GA thread.
+        struct GAPlayerContext
+        {
+            std::string userId;
+            std::string sessionId;
+            int64_t sessionStart = 0;
+            int sessionNum = 0;
+            int transactionNum = 0;
+            std::string customDimension01;
+            std::string customDimension02;
+            std::string customDimension03;
+            std::map<std::string, int> progressionTries;
+        };
+
+        typedef std::vector<std::shared_ptr<GAPlayerContext>> GAPlayerContextVector;
+
+        // Player contexts by user id, split over shards with their own lock and
+        // least recently used order. Each shard holds at most its share of the
+        // max players, adding beyond it evicts that shard's oldest contexts.
+        class GAPlayerContexts
+        {
+        public:
+            static const size_t ShardCount = 16;
+            static const size_t DefaultMaxPlayers = 100000;
+
+            GAPlayerContexts();
+
+            // contexts over the new bound are returned in evicted
+            void setMaxPlayers(size_t maxPlayers, GAPlayerContextVector& evicted);
+            size_t getMaxPlayers() const;
+            // null when the player has no context, marks it as recently used
+            std::shared_ptr<GAPlayerContext> get(const std::string& userId);
+            // a new context for the player, an existing one is returned in replaced
+            std::shared_ptr<GAPlayerContext> add(const std::string& userId, std::shared_ptr<GAPlayerContext>& replaced, GAPlayerContextVector& evicted);
+            std::shared_ptr<GAPlayerContext> remove(const std::string& userId);
+            void removeAll(GAPlayerContextVector& out);
+            size_t size();
+
+        private:
+            GAPlayerContexts(const GAPlayerContexts&) = delete;
+            GAPlayerContexts& operator=(const GAPlayerContexts&) = delete;
+
+            typedef std::list<std::shared_ptr<GAPlayerContext>> Order;
+
+            struct Shard
+            {
+                std::mutex mtx;
+                // most recently used first
+                Order order;
+                std::unordered_map<std::string, Order::iterator> index;
+            };
+
+            Shard& shardFor(const std::string& userId);
+            void trim(Shard& shard, size_t maxSize, GAPlayerContextVector& evicted);
+
+            Shard _shards[ShardCount];
+            std::atomic<size_t> _maxPlayers;
+            std::atomic<size_t> _maxPerShard;
+        };
+    }
+}
@@ -0,0 +1,183 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GARemoteConfigsSnapshot.h"
+#include "GAUtilities.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+#include <cerrno>
+#include <cmath>
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        size_t GARemoteConfigsSnapshot::KeyHash::operator()(const char* key) const
+        {
+            return static_cast<size_t>(utilities::GAUtilities::fnv1a(key));
+        }
+
+        // the typed views of a string value, configs often carry numbers and flags as strings
+        static void parseString(GARemoteConfigsSnapshot::Value& value)
+        {
+            const char* s = value.string;
+            if(strcmp(s, "true") == 0 || strcmp(s, "false") == 0)
+            {
+                value.isBool = true;
+                value.boolean = s[0] == 't';
+                return;
+            }
+            if(*s == '\0')
+            {
+                return;
+            }
+
+            char* end = NULL;
+            errno = 0;
+            long long integer = strtoll(s, &end, 10);
+            if(*end == '\0' && errno == 0)
+            {
+                value.isInteger = true;
+                value.integer = integer;
+            }
+
+            errno = 0;
+            double number = strtod(s, &end);
+            if(*end == '\0' && errno == 0 && std::isfinite(number))
+            {
+                value.isNumber = true;
+                value.number = number;
+            }
+        }
+
+        GARemoteConfigsSnapshot::GARemoteConfigsSnapshot(const rapidjson::Value& configurations, const std::vector<const char*>& registeredKeys)
+        {
+            if(!configurations.IsObject())
+            {
+                _content = "{}";
+                _slots.assign(registeredKeys.size(), NULL);
+                return;
+            }
+
+            {
+                rapidjson::StringBuffer buffer;
+                rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+                configurations.Accept(writer);
+                _content = buffer.GetString();
+            }
+
+            std::vector<size_t> offsets;
+            offsets.reserve(configurations.MemberCount() * 2);
+            for (rapidjson::Value::ConstMemberIterator itr = configurations.MemberBegin(); itr != configurations.MemberEnd(); ++itr)
+            {
+                offsets.push_back(_strings.size());
+                _strings.insert(_strings.end(), itr->name.GetString(), itr->name.GetString() + itr->name.GetStringLength());
+                _strings.push_back('\0');
+
+                offsets.push_back(_strings.size());
+                if(itr->value.IsString())
+                {
+                    _strings.insert(_strings.end(), itr->value.GetString(), itr->value.GetString() + itr->value.GetStringLength());
+                }
+                else
+                {
+                    rapidjson::StringBuffer buffer;
+                    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+                    itr->value.Accept(writer);
+                    _strings.insert(_strings.end(), buffer.GetString(), buffer.GetString() + buffer.GetSize());
+                }
+                _strings.push_back('\0');
+            }
+
+            // index once the storage no longer moves
+            _values.resize(offsets.size() / 2);
+            _index.reserve(_values.size());
+            rapidjson::Value::ConstMemberIterator member = configurations.MemberBegin();
+            for(size_t i = 0; i < _values.size(); ++i, ++member)
+            {
+                Value& value = _values[i];
+                value.string = _strings.data() + offsets[i * 2 + 1];
+                value.isInteger = false;
+                value.integer = 0;
+                value.isNumber = false;
+                value.number = 0;
+                value.isBool = false;
+                value.boolean = false;
+
+                if(member->value.IsInt64())
+                {
+                    value.isInteger = true;
+                    value.integer = member->value.GetInt64();
+                    value.isNumber = true;
+                    value.number = static_cast<double>(value.integer);
+                }
+                else if(member->value.IsNumber())
+                {
+                    value.isNumber = true;
+                    value.number = member->value.GetDouble();
+                }
+                else
+                {
+                    parseString(value);
+                }
+                if(value.isInteger && (value.integer == 0 || value.integer == 1))
+                {
+                    value.isBool = true;
+                    value.boolean = value.integer == 1;
+                }
+
+                _index[_strings.data() + offsets[i * 2]] = &value;
+            }
+
+            _slots.reserve(registeredKeys.size());
+            for(size_t i = 0; i < registeredKeys.size(); ++i)
+            {
+                _slots.push_back(find(registeredKeys[i]));
+            }
+        }
+
+        const GARemoteConfigsSnapshot::Value* GARemoteConfigsSnapshot::find(const char* key) const
+        {
+            if(!key || _index.empty())
+            {
+                return NULL;
+            }
+
+            std::unordered_map<const char*, const Value*, KeyHash, KeyEqual>::const_iterator itr = _index.find(key);
+            return itr != _index.end() ? itr->second : NULL;
+        }
+
+        const char* GARemoteConfigsSnapshot::getValue(const char* key) const
+        {
+            const Value* value = find(key);
+            return value ? value->string : NULL;
+        }
+
+        void GARemoteConfigsSnapshot::getChangedKeys(const GARemoteConfigsSnapshot* previous, std::vector<std::string>& out) const
+        {
+            for(std::unordered_map<const char*, const Value*, KeyHash, KeyEqual>::const_iterator itr = _index.begin(); itr != _index.end(); ++itr)
+            {
+                const Value* before = previous ? previous->find(itr->first) : NULL;
+                if(!before || strcmp(before->string, itr->second->string) != 0)
+                {
+                    out.push_back(itr->first);
+                }
+            }
+
+            if(!previous)
+            {
+                return;
+            }
+            for(std::unordered_map<const char*, const Value*, KeyHash, KeyEqual>::const_iterator itr = previous->_index.begin(); itr != previous->_index.end(); ++itr)
+            {
+                if(!find(itr->first))
+                {
+                    out.push_back(itr->first);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "rapidjson/document.h"
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstdint>
+#include <string.h>
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        // Immutable copy of the remote configs with a hash index. GAState
+        // publishes a new snapshot through an atomic pointer when the configs
+        // change and keeps the old ones alive, so readers never lock and the
+        // returned strings stay valid.
+        class GARemoteConfigsSnapshot
+        {
+        public:
+            // a config value parsed once when the snapshot is built
+            struct Value
+            {
+                const char* string;
+                bool isInteger;
+                int64_t integer;
+                bool isNumber;
+                double number;
+                bool isBool;
+                bool boolean;
+            };
+
+            // configurations is the key/value object built by GAState, numbers are
+            // kept as JSON text. registeredKeys get a slot each, in the same order.
+            GARemoteConfigsSnapshot(const rapidjson::Value& configurations, const std::vector<const char*>& registeredKeys);
+
+            // null when the key is missing, does not allocate
+            const char* getValue(const char* key) const;
+            const Value* find(const char* key) const;
+            // by registered key slot, null when missing or registered after this snapshot
+            const Value* at(size_t slot) const { return slot < _slots.size() ? _slots[slot] : NULL; }
+            bool hasSlot(size_t slot) const { return slot < _slots.size(); }
+            // keys added, changed or removed since previous, all keys when it is null
+            void getChangedKeys(const GARemoteConfigsSnapshot* previous, std::vector<std::string>& out) const;
+            // the configs as a pretty printed JSON object
+            const char* getContent() const { return _content.c_str(); }
+            size_t size() const { return _index.size(); }
+            bool hasSameContent(const GARemoteConfigsSnapshot& other) const { return _content == other._content; }
+
+        private:
+            GARemoteConfigsSnapshot(const GARemoteConfigsSnapshot&) = delete;
+            GARemoteConfigsSnapshot& operator=(const GARemoteConfigsSnapshot&) = delete;
+
+            struct KeyHash
+            {
+                size_t operator()(const char* key) const;
+            };
+
+            struct KeyEqual
+            {
+                bool operator()(const char* first, const char* second) const
+                {
+                    return strcmp(first, second) == 0;
+                }
+            };
+
+            // keys and values as consecutive null terminated strings, the index points into it
+            std::vector<char> _strings;
+            std::vector<Value> _values;
+            std::unordered_map<const char*, const Value*, KeyHash, KeyEqual> _index;
+            std::vector<const Value*> _slots;
+            std::string _content;
+        };
+    }
+}
@@ -5,6 +5,7 @@
 
 #include "GAState.h"
 #include "GAEvents.h"
+#include "GAEventSampler.h"
 #include "GAStore.h"
 #include "GAUtilities.h"
 #include "GAValidator.h"
@@ -12,6 +13,9 @@
 #include "GAThreading.h"
 #include "GALogger.h"
 #include "GADevice.h"
+#if !USE_UWP && !USE_TIZEN
+#include "GAUncaughtExceptionHandler.h"
+#endif
 #include <utility>
 #include <algorithm>
 #include <climits>
@@ -20,9 +24,6 @@
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/prettywriter.h"
 
-#define MAX_CUSTOM_FIELDS_COUNT 50
-#define MAX_CUSTOM_FIELDS_KEY_LENGTH 64
-#define MAX_CUSTOM_FIELDS_VALUE_STRING_LENGTH 256
 
 namespace gameanalytics
 {
@@ -30,9 +31,12 @@ namespace gameanalytics
     {
         const char* GAState::CategorySdkError = "sdk_error";
 
+        const uint32_t GAState::MaxRemoteConfigKeys = 1024;
+
         bool GAState::_destroyed = false;
         GAState* GAState::_instance = 0;
         std::once_flag GAState::_initInstanceFlag;
+        thread_local GAPlayerContext* GAState::_activePlayer = NULL;
 
         GAState::GAState()
         {
@@ -40,6 +44,20 @@ namespace gameanalytics
 
         GAState::~GAState()
         {
+#if !USE_UWP && !NO_ASYNC
+            if(_initThread.joinable())
+            {
+                // a client can be released by the last task of its init thread
+                if(_initThread.get_id() == std::this_thread::get_id())
+                {
+                    _initThread.detach();
+                }
+                else
+                {
+                    _initThread.join();
+                }
+            }
+#endif
         }
 
         void GAState::cleanUp()
@@ -52,6 +70,11 @@ namespace gameanalytics
 
         GAState* GAState::getInstance()
         {
+            client::GAClientContext* client = client::GAClientContext::current();
+            if(client)
+            {
+                return client->getState();
+            }
             std::call_once(_initInstanceFlag, &GAState::initInstance);
             return _instance;
         }
@@ -74,6 +97,10 @@ namespace gameanalytics
 
         const char* GAState::getIdentifier()
         {
+            if(_activePlayer)
+            {
+                return _activePlayer->userId.c_str();
+            }
             return getInstance()->_identifier;
         }
 
@@ -89,6 +116,10 @@ namespace gameanalytics
 
         int64_t GAState::getSessionStart()
         {
+            if(_activePlayer)
+            {
+                return _activePlayer->sessionStart;
+            }
             GAState* i = getInstance();
             if(!i)
             {
@@ -99,6 +130,10 @@ namespace gameanalytics
 
         int GAState::getSessionNum()
         {
+            if(_activePlayer)
+            {
+                return _activePlayer->sessionNum;
+            }
             GAState* i = getInstance();
             if(!i)
             {
@@ -109,6 +144,10 @@ namespace gameanalytics
 
         int GAState::getTransactionNum()
         {
+            if(_activePlayer)
+            {
+                return _activePlayer->transactionNum;
+            }
             GAState* i = getInstance();
             if(!i)
             {
@@ -119,6 +158,10 @@ namespace gameanalytics
 
         const char* GAState::getSessionId()
         {
+            if(_activePlayer)
+            {
+                return _activePlayer->sessionId.c_str();
+            }
             GAState* i = getInstance();
             if(!i)
             {
@@ -129,6 +172,10 @@ namespace gameanalytics
 
         const char* GAState::getCurrentCustomDimension01()
         {
+            if(_activePlayer)
+            {
+                return _activePlayer->customDimension01.c_str();
+            }
             GAState* i = getInstance();
             if(!i)
             {
@@ -139,6 +186,10 @@ namespace gameanalytics
 
         const char* GAState::getCurrentCustomDimension02()
         {
+            if(_activePlayer)
+            {
+                return _activePlayer->customDimension02.c_str();
+            }
             GAState* i = getInstance();
             if(!i)
             {
@@ -149,6 +200,10 @@ namespace gameanalytics
 
         const char* GAState::getCurrentCustomDimension03()
         {
+            if(_activePlayer)
+            {
+                return _activePlayer->customDimension03.c_str();
+            }
             GAState* i = getInstance();
             if(!i)
             {
@@ -170,7 +225,7 @@ namespace gameanalytics
             {
                 return;
             }
-            i->_availableCustomDimensions01 = availableCustomDimensions;
+            i->_availableCustomDimensions01.assign(availableCustomDimensions);
 
             // validate current dimension values
             validateAndFixCurrentDimensions();
@@ -191,7 +246,7 @@ namespace gameanalytics
             {
                 return;
             }
-            i->_availableCustomDimensions02 = availableCustomDimensions;
+            i->_availableCustomDimensions02.assign(availableCustomDimensions);
 
             // validate current dimension values
             validateAndFixCurrentDimensions();
@@ -211,7 +266,7 @@ namespace gameanalytics
             {
                 return;
             }
-            i->_availableCustomDimensions03 = availableCustomDimensions;
+            i->_availableCustomDimensions03.assign(availableCustomDimensions);
 
             // validate current dimension values
             validateAndFixCurrentDimensions();
@@ -231,7 +286,7 @@ namespace gameanalytics
             if (!validators::GAValidator::validateResourceCurrencies(availableResourceCurrencies)) {
                 return;
             }
-            i->_availableResourceCurrencies = availableResourceCurrencies;
+            i->_availableResourceCurrencies.assign(availableResourceCurrencies);
 
             utilities::GAUtilities::printJoinStringArray(availableResourceCurrencies, "Set available resource currencies: (%s)");
         }
@@ -248,7 +303,7 @@ namespace gameanalytics
             if (!validators::GAValidator::validateResourceItemTypes(availableResourceItemTypes)) {
                 return;
             }
-            i->_availableResourceItemTypes = availableResourceItemTypes;
+            i->_availableResourceItemTypes.assign(availableResourceItemTypes);
 
             utilities::GAUtilities::printJoinStringArray(availableResourceItemTypes, "Set available resource item types: (%s)");
         }
@@ -263,7 +318,7 @@ namespace gameanalytics
 
             snprintf(i->_build, sizeof(i->_build), "%s", build);
 
-            logging::GALogger::i("Set build: %s", build);
+            GA_LOG_INFO("Set build: %s", build);
         }
 
         void GAState::setDefaultUserId(const char* id)
@@ -317,6 +372,12 @@ namespace gameanalytics
 
         void GAState::setCustomDimension01(const char* dimension)
         {
+            if(_activePlayer)
+            {
+                _activePlayer->customDimension01 = dimension;
+                return;
+            }
+
             GAState* i = getInstance();
             if(!i)
             {
@@ -328,11 +389,17 @@ namespace gameanalytics
             {
                 store::GAStore::setState("dimension01", dimension);
             }
-            logging::GALogger::i("Set custom01 dimension value: %s", dimension);
+            GA_LOG_INFO("Set custom01 dimension value: %s", dimension);
         }
 
         void GAState::setCustomDimension02(const char* dimension)
         {
+            if(_activePlayer)
+            {
+                _activePlayer->customDimension02 = dimension;
+                return;
+            }
+
             GAState* i = getInstance();
             if(!i)
             {
@@ -344,11 +411,17 @@ namespace gameanalytics
             {
                 store::GAStore::setState("dimension02", dimension);
             }
-            logging::GALogger::i("Set custom02 dimension value: %s", dimension);
+            GA_LOG_INFO("Set custom02 dimension value: %s", dimension);
         }
 
         void GAState::setCustomDimension03(const char* dimension)
         {
+            if(_activePlayer)
+            {
+                _activePlayer->customDimension03 = dimension;
+                return;
+            }
+
             GAState* i = getInstance();
             if(!i)
             {
@@ -360,11 +433,17 @@ namespace gameanalytics
             {
                 store::GAStore::setState("dimension03", dimension);
             }
-            logging::GALogger::i("Set custom03 dimension value: %s", dimension);
+            GA_LOG_INFO("Set custom03 dimension value: %s", dimension);
         }
 
         void GAState::incrementSessionNum()
         {
+            if(_activePlayer)
+            {
+                _activePlayer->sessionNum++;
+                return;
+            }
+
             GAState* i = getInstance();
             if(!i)
             {
@@ -377,6 +456,12 @@ namespace gameanalytics
 
         void GAState::incrementTransactionNum()
         {
+            if(_activePlayer)
+            {
+                _activePlayer->transactionNum++;
+                return;
+            }
+
             GAState* i = getInstance();
             if(!i)
             {
@@ -389,6 +474,13 @@ namespace gameanalytics
 
         void GAState::incrementProgressionTries(const char* progression)
         {
+            // players' attempts are kept in memory only
+            if(_activePlayer)
+            {
+                _activePlayer->progressionTries[progression]++;
+                return;
+            }
+
             GAState* i = getInstance();
             if(!i)
             {
@@ -409,6 +501,12 @@ namespace gameanalytics
 
         int GAState::getProgressionTries(const char* progression)
         {
+            if(_activePlayer)
+            {
+                std::map<std::string, int>::const_iterator itr = _activePlayer->progressionTries.find(progression);
+                return itr != _activePlayer->progressionTries.end() ? itr->second : 0;
+            }
+
             GAState* i = getInstance();
             if(!i)
             {
@@ -427,6 +525,12 @@ namespace gameanalytics
 
         void GAState::clearProgressionTries(const char* progression)
         {
+            if(_activePlayer)
+            {
+                _activePlayer->progressionTries.erase(progression);
+                return;
+            }
+
             GAState* i = getInstance();
             if(!i)
             {
@@ -452,7 +556,7 @@ namespace gameanalytics
             {
                 return false;
             }
-            return utilities::GAUtilities::stringVectorContainsString(i->_availableCustomDimensions01, dimension1);
+            return i->_availableCustomDimensions01.contains(dimension1);
         }
 
         bool GAState::hasAvailableCustomDimensions02(const char* dimension2)
@@ -462,7 +566,7 @@ namespace gameanalytics
             {
                 return false;
             }
-            return utilities::GAUtilities::stringVectorContainsString(i->_availableCustomDimensions02, dimension2);
+            return i->_availableCustomDimensions02.contains(dimension2);
         }
 
         bool GAState::hasAvailableCustomDimensions03(const char* dimension3)
@@ -472,7 +576,7 @@ namespace gameanalytics
             {
                 return false;
             }
-            return utilities::GAUtilities::stringVectorContainsString(i->_availableCustomDimensions03, dimension3);
+            return i->_availableCustomDimensions03.contains(dimension3);
         }
 
         bool GAState::hasAvailableResourceCurrency(const char* currency)
@@ -482,7 +586,7 @@ namespace gameanalytics
             {
                 return false;
             }
-            return utilities::GAUtilities::stringVectorContainsString(i->_availableResourceCurrencies, currency);
+            return i->_availableResourceCurrencies.contains(currency);
         }
 
         bool GAState::hasAvailableResourceItemType(const char* itemType)
@@ -492,7 +596,7 @@ namespace gameanalytics
             {
                 return false;
             }
-            return utilities::GAUtilities::stringVectorContainsString(i->_availableResourceItemTypes, itemType);
+            return i->_availableResourceItemTypes.contains(itemType);
         }
 
         void GAState::setKeys(const char* gameKey, const char* gameSecret)
@@ -545,6 +649,9 @@ namespace gameanalytics
             store::GAStore::setState("default_user_id", i->_defaultUserId);
             i->_initialized = true;
 
+            // only sessions of an earlier run are in ga_session yet, player sessions start later
+            events::GAEvents::fixMissingSessionEndEvents();
+
             startNewSession();
 
             if (isEnabled())
@@ -559,7 +666,7 @@ namespace gameanalytics
             {
                 return;
             }
-            logging::GALogger::i("Resuming session.");
+            GA_LOG_INFO("Resuming session.");
             if(!GAState::sessionIsStarted())
             {
                 startNewSession();
@@ -577,10 +684,12 @@ namespace gameanalytics
 
             if(GAState::isInitialized())
             {
-                logging::GALogger::i("Ending session.");
+                GA_LOG_INFO("Ending session.");
                 events::GAEvents::stopEventQueue();
+                i->_sessionWaitingForInit = false;
                 if (GAState::isEnabled() && GAState::sessionIsStarted())
                 {
+                    endAllPlayerSessions();
                     events::GAEvents::addSessionEndEvent();
                     i->_sessionStart = 0;
                 }
@@ -592,6 +701,125 @@ namespace gameanalytics
             }
         }
 
+        void GAState::startPlayerSession(const char* userId, int sessionNum, int transactionNum)
+        {
+            GAState* i = getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+            std::shared_ptr<GAPlayerContext> replaced;
+            GAPlayerContextVector evicted;
+            std::shared_ptr<GAPlayerContext> player = i->_players.add(userId, replaced, evicted);
+            if(replaced)
+            {
+                endPlayerSession(*replaced);
+            }
+            if(!evicted.empty())
+            {
+                logging::GALogger::w("Player limit of %d reached, ending %d least recently active player session(s)", (int)i->_players.getMaxPlayers(), (int)evicted.size());
+                for(size_t n = 0; n < evicted.size(); ++n)
+                {
+                    endPlayerSession(*evicted[n]);
+                }
+            }
+
+            char sessionId[65] = "";
+            utilities::GAUtilities::generateUUID(sessionId);
+            utilities::GAUtilities::lowercaseString(sessionId);
+
+            GAPlayerScope scope(player.get());
+            player->sessionId = sessionId;
+            player->sessionStart = getClientTsAdjusted();
+            player->sessionNum = sessionNum;
+            player->transactionNum = transactionNum;
+            events::GAEvents::addSessionStartEvent();
+        }
+
+        void GAState::endPlayerSession(const char* userId)
+        {
+            GAState* i = getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+            std::shared_ptr<GAPlayerContext> player = i->_players.remove(userId);
+            if(player)
+            {
+                endPlayerSession(*player);
+            }
+        }
+
+        void GAState::endPlayerSession(GAPlayerContext& player)
+        {
+            GAPlayerScope scope(&player);
+            events::GAEvents::addSessionEndEvent();
+        }
+
+        void GAState::endAllPlayerSessions()
+        {
+            GAState* i = getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+            GAPlayerContextVector players;
+            i->_players.removeAll(players);
+            if(!players.empty())
+            {
+                GA_LOG_INFO("Ending %d player session(s).", (int)players.size());
+            }
+            for(size_t n = 0; n < players.size(); ++n)
+            {
+                endPlayerSession(*players[n]);
+            }
+        }
+
+        std::shared_ptr<GAPlayerContext> GAState::getPlayer(const char* userId)
+        {
+            GAState* i = getInstance();
+            if(!i)
+            {
+                return std::shared_ptr<GAPlayerContext>();
+            }
+            return i->_players.get(userId);
+        }
+
+        void GAState::setMaxPlayers(int maxPlayers)
+        {
+            GAState* i = getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+            GAPlayerContextVector evicted;
+            i->_players.setMaxPlayers(static_cast<size_t>(maxPlayers), evicted);
+            for(size_t n = 0; n < evicted.size(); ++n)
+            {
+                endPlayerSession(*evicted[n]);
+            }
+        }
+
+        bool GAState::hasActivePlayer()
+        {
+            return _activePlayer != NULL;
+        }
+
+        GAPlayerScope::GAPlayerScope(GAPlayerContext* player):
+            _previous(GAState::_activePlayer)
+        {
+            GAState::_activePlayer = player;
+        }
+
+        GAPlayerScope::~GAPlayerScope()
+        {
+            GAState::_activePlayer = _previous;
+        }
+
         void GAState::getEventAnnotations(rapidjson::Document& out)
         {
             GAState* i = getInstance();
@@ -663,7 +891,7 @@ namespace gameanalytics
             }
             // Session identifier
             {
-                rapidjson::Value v(i->_sessionId, allocator);
+                rapidjson::Value v(getSessionId(), allocator);
                 out.AddMember("session_id", v.Move(), allocator);
             }
             // Session number
@@ -847,7 +1075,7 @@ namespace gameanalytics
                 snprintf(i->_identifier, sizeof(i->_identifier), "%s", i->_defaultUserId);
             }
 
-            logging::GALogger::d("identifier, {clean:%s}", i->_identifier);
+            GA_LOG_DEBUG("identifier, {clean:%s}", i->_identifier);
         }
 
         void GAState::ensurePersistedStates()
@@ -906,7 +1134,7 @@ namespace gameanalytics
                 snprintf(i->_currentCustomDimension01, sizeof(i->_currentCustomDimension01), "%s", state_dict.HasMember("dimension01") ? state_dict["dimension01"].GetString() : "");
                 if (strlen(i->_currentCustomDimension01))
                 {
-                    logging::GALogger::d("Dimension01 found in cache: %s", i->_currentCustomDimension01);
+                    GA_LOG_DEBUG("Dimension01 found in cache: %s", i->_currentCustomDimension01);
                 }
             }
 
@@ -919,7 +1147,7 @@ namespace gameanalytics
                 snprintf(i->_currentCustomDimension02, sizeof(i->_currentCustomDimension02), "%s", state_dict.HasMember("dimension02") ? state_dict["dimension02"].GetString() : "");
                 if (strlen(i->_currentCustomDimension02) > 0)
                 {
-                    logging::GALogger::d("Dimension02 found in cache: %s", i->_currentCustomDimension02);
+                    GA_LOG_DEBUG("Dimension02 found in cache: %s", i->_currentCustomDimension02);
                 }
             }
 
@@ -932,7 +1160,7 @@ namespace gameanalytics
                 snprintf(i->_currentCustomDimension03, sizeof(i->_currentCustomDimension03), "%s", state_dict.HasMember("dimension03") ? state_dict["dimension03"].GetString() : "");
                 if (strlen(i->_currentCustomDimension03) > 0)
                 {
-                    logging::GALogger::d("Dimension03 found in cache: %s", i->_currentCustomDimension03);
+                    GA_LOG_DEBUG("Dimension03 found in cache: %s", i->_currentCustomDimension03);
                 }
             }
 
@@ -977,39 +1205,211 @@ namespace gameanalytics
                 return;
             }
 
-            logging::GALogger::i("Starting a new session.");
+            GA_LOG_INFO("Starting a new session.");
 
             // make sure the current custom dimensions are valid
             GAState::validateAndFixCurrentDimensions();
 
-            // call the init call
+            // start right away from the config of the last init call (cached
+            // across sessions) and refresh it in the background, so the first
+            // events do not wait for the network
+            if (i->_sdkConfig.IsNull())
+            {
+                if (!i->_sdkConfigCached.IsNull())
+                {
+                    GA_LOG_INFO("Starting session with cached init values.");
+                    i->_sdkConfig.CopyFrom(i->_sdkConfigCached, i->_sdkConfig.GetAllocator());
+                }
+                else
+                {
+                    GA_LOG_INFO("Starting session with default init values.");
+                    if(i->_sdkConfigDefault.IsNull())
+                    {
+                        i->_sdkConfigDefault.SetObject();
+                    }
+                    i->_sdkConfig.CopyFrom(i->_sdkConfigDefault, i->_sdkConfig.GetAllocator());
+                }
+                // assumed until the first init call answers
+                i->_initAuthorized = true;
+            }
+            applySdkConfig();
+
+            // if SDK is disabled in config
+            if (!GAState::isEnabled())
+            {
+                logging::GALogger::w("Could not start session: SDK is disabled.");
+                // stop event queue
+                // + make sure it's able to restart if the init call detects it's enabled again
+                events::GAEvents::stopEventQueue();
+                i->_sessionWaitingForInit = true;
+                requestInit();
+                return;
+            }
+
+            events::GAEvents::ensureEventQueueIsRunning();
+            beginSession();
+            requestInit();
+        }
+
+        void GAState::beginSession()
+        {
+            GAState* i = getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+            i->_sessionWaitingForInit = false;
+
+            // generate the new session
+            char newSessionId[65] = "";
+            utilities::GAUtilities::generateUUID(newSessionId);
+            utilities::GAUtilities::lowercaseString(newSessionId);
+
+            // Set session id
+            snprintf(i->_sessionId, sizeof(i->_sessionId), "%s", newSessionId);
+
+            // Set session start
+            i->_sessionStart = getClientTsAdjusted();
+
+            // Add session start event
+            events::GAEvents::addSessionStartEvent();
+
+#if !USE_UWP && !USE_TIZEN
+            // a crash from the previous run is reported in the new session
+            errorreporter::GAUncaughtExceptionHandler::setCrashSession(i->_sessionId, getSessionNum());
+            errorreporter::GAUncaughtExceptionHandler::reportPreviousCrash();
+#endif
+        }
+
+        void GAState::applySdkConfig()
+        {
+            GAState* i = getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+            rapidjson::Value currentSdkConfig;
+            GAState::getSdkConfig(currentSdkConfig);
+
+            {
+                if (currentSdkConfig.IsObject() && ((currentSdkConfig.HasMember("enabled") && currentSdkConfig["enabled"].IsBool()) ? currentSdkConfig["enabled"].GetBool() : true) == false)
+                {
+                    i->_enabled = false;
+                }
+                else if (!i->_initAuthorized)
+                {
+                    i->_enabled = false;
+                }
+                else
+                {
+                    i->_enabled = true;
+                }
+            }
+
+            // set offset in state (memory) from current config (config could be from cache etc.)
+            i->_clientServerTimeOffset = currentSdkConfig.HasMember("time_offset") ? currentSdkConfig["time_offset"].GetInt64() : 0;
+
+            // populate configurations
+            populateConfigurations(currentSdkConfig);
+        }
+
+        void GAState::requestInit()
+        {
+            GAState* i = getInstance();
+            if(!i)
+            {
+                return;
+            }
+
             http::GAHTTPApi *httpApi = http::GAHTTPApi::getInstance();
             if(!httpApi)
             {
                 return;
             }
+
+            // a session started again before the answer shares the call in flight
+            if(i->_initInFlight.exchange(true))
+            {
+                return;
+            }
+
+#if USE_UWP
+            httpApi->requestInitReturningDict(i->_configsHash).then([](concurrency::task<std::pair<http::EGAHTTPApiResponse, std::string>> task)
+            {
+                std::pair<http::EGAHTTPApiResponse, std::string> pair;
+                try
+                {
+                    pair = task.get();
+                }
+                catch(Platform::COMException^ e)
+                {
+                    pair = std::pair<http::EGAHTTPApiResponse, std::string>(http::NoResponse, "");
+                }
+
+                threading::GAThreading::performTaskOnGAThread([pair]()
+                {
+                    rapidjson::Document initResponseDict;
+                    initResponseDict.SetObject();
+                    if(pair.second.size() > 0)
+                    {
+                        initResponseDict.Parse(pair.second.c_str());
+                    }
+                    applyInitResponse(pair.first, initResponseDict);
+                });
+            });
+#elif NO_ASYNC
+            // no worker threads, the call blocks the GA thread after the session has started
             rapidjson::Document initResponseDict;
             initResponseDict.SetObject();
-            rapidjson::Document::AllocatorType& allocator = initResponseDict.GetAllocator();
             http::EGAHTTPApiResponse initResponse;
-#if USE_UWP
-            std::pair<http::EGAHTTPApiResponse, std::string> pair;
-            try
+            httpApi->requestInitReturningDict(initResponse, initResponseDict, i->_configsHash);
+            applyInitResponse(initResponse, initResponseDict);
+#else
+            if(i->_initThread.joinable())
             {
-                pair = httpApi->requestInitReturningDict(i->_configsHash).get();
+                // the previous call is already done
+                i->_initThread.join();
             }
-            catch(Platform::COMException^ e)
+
+            // the request is built from the state here, the thread only sends it
+            std::shared_ptr<http::InitRequest> initRequest = std::make_shared<http::InitRequest>();
+            if(!httpApi->prepareInitRequest(*initRequest, i->_configsHash))
             {
-                pair = std::pair<http::EGAHTTPApiResponse, std::string>(http::NoResponse, "");
+                rapidjson::Document initResponseDict;
+                applyInitResponse(http::JsonEncodeFailed, initResponseDict);
+                return;
             }
-            initResponse = pair.first;
-            if(pair.second.size() > 0)
+
+            // the state joins the thread before the client goes away
+            client::GAClientContext* client = client::GAClientContext::current();
+            i->_initThread = std::thread([httpApi, initRequest, client]()
             {
-                initResponseDict.Parse(pair.second.c_str());
-            }
-#else
-            httpApi->requestInitReturningDict(initResponse, initResponseDict, i->_configsHash);
+                client::GAClientScope scope(client);
+                std::shared_ptr<rapidjson::Document> initResponseDict = std::make_shared<rapidjson::Document>();
+                initResponseDict->SetObject();
+                http::EGAHTTPApiResponse initResponse;
+                httpApi->sendInitRequest(*initRequest, initResponse, *initResponseDict);
+
+                threading::GAThreading::performTaskOnGAThread([initResponse, initResponseDict]()
+                {
+                    applyInitResponse(initResponse, *initResponseDict);
+                });
+            });
 #endif
+        }
+
+        void GAState::applyInitResponse(http::EGAHTTPApiResponse initResponse, rapidjson::Document& initResponseDict)
+        {
+            GAState* i = getInstance();
+            if(!i)
+            {
+                return;
+            }
+
+            i->_initInFlight = false;
+            rapidjson::Document::AllocatorType& allocator = initResponseDict.GetAllocator();
 
             // init is ok
             if ((initResponse == http::Ok || initResponse == http::Created) && !initResponseDict.IsNull())
@@ -1080,98 +1480,42 @@ namespace gameanalytics
                 // log the status if no connection
                 if (initResponse == http::NoResponse || initResponse == http::RequestTimeout)
                 {
-                    logging::GALogger::i("Init call (session start) failed - no response. Could be offline or timeout.");
+                    GA_LOG_INFO("Init call (session start) failed - no response. Could be offline or timeout.");
                 }
                 else if (initResponse == http::BadResponse || initResponse == http::JsonEncodeFailed || initResponse == http::JsonDecodeFailed)
                 {
-                    logging::GALogger::i("Init call (session start) failed - bad response. Could be bad response from proxy or GA servers.");
+                    GA_LOG_INFO("Init call (session start) failed - bad response. Could be bad response from proxy or GA servers.");
                 }
                 else if (initResponse == http::BadRequest || initResponse == http::UnknownResponseCode)
                 {
-                    logging::GALogger::i("Init call (session start) failed - bad request or unknown response.");
+                    GA_LOG_INFO("Init call (session start) failed - bad request or unknown response.");
                 }
 
-                // init call failed (perhaps offline)
-                if (i->_sdkConfig.IsNull())
-                {
-                    if (!i->_sdkConfigCached.IsNull())
-                    {
-                        logging::GALogger::i("Init call (session start) failed - using cached init values.");
-                        // set last cross session stored config init values
-                        i->_sdkConfig.CopyFrom(i->_sdkConfigCached, i->_sdkConfig.GetAllocator());
-                    }
-                    else
-                    {
-                        logging::GALogger::i("Init call (session start) failed - using default init values.");
-                        // set default init values
-
-                        if(i->_sdkConfigDefault.IsNull())
-                        {
-                            i->_sdkConfigDefault.SetObject();
-                        }
-
-                        i->_sdkConfig.CopyFrom(i->_sdkConfigDefault, i->_sdkConfig.GetAllocator());
-                    }
-                }
-                else
-                {
-                    logging::GALogger::i("Init call (session start) failed - using cached init values.");
-                }
+                // init call failed (perhaps offline), the session already runs on the cached or default values
+                GA_LOG_INFO("Init call (session start) failed - using cached init values.");
                 i->_initAuthorized = true;
             }
 
-            rapidjson::Value currentSdkConfig;
-            GAState::getSdkConfig(currentSdkConfig);
+            bool wasEnabled = GAState::isEnabled();
+            applySdkConfig();
 
+            if (!GAState::isEnabled())
             {
-                if (currentSdkConfig.IsObject() && ((currentSdkConfig.HasMember("enabled") && currentSdkConfig["enabled"].IsBool()) ? currentSdkConfig["enabled"].GetBool() : true) == false)
-                {
-                    i->_enabled = false;
-                }
-                else if (!i->_initAuthorized)
+                if (wasEnabled)
                 {
-                    i->_enabled = false;
+                    logging::GALogger::w("SDK disabled by the init call, stopping the event queue.");
+                    // + make sure it's able to restart if another session detects it's enabled again
+                    events::GAEvents::stopEventQueue();
                 }
-                else
-                {
-                    i->_enabled = true;
-                }
-            }
-
-            // set offset in state (memory) from current config (config could be from cache etc.)
-
-            i->_clientServerTimeOffset = currentSdkConfig.HasMember("time_offset") ? currentSdkConfig["time_offset"].GetInt64() : 0;
-
-            // populate configurations
-            populateConfigurations(currentSdkConfig);
-
-            // if SDK is disabled in config
-            if (!GAState::isEnabled())
-            {
-                logging::GALogger::w("Could not start session: SDK is disabled.");
-                // stop event queue
-                // + make sure it's able to restart if another session detects it's enabled again
-                events::GAEvents::stopEventQueue();
                 return;
             }
-            else
+
+            // the cached config had the SDK disabled so the session did not start yet
+            if (i->_sessionWaitingForInit && !sessionIsStarted())
             {
                 events::GAEvents::ensureEventQueueIsRunning();
+                beginSession();
             }
-
-            // generate the new session
-            char newSessionId[65] = "";
-            utilities::GAUtilities::generateUUID(newSessionId);
-            utilities::GAUtilities::lowercaseString(newSessionId);
-
-            // Set session id
-            snprintf(i->_sessionId, sizeof(i->_sessionId), "%s", newSessionId);
-
-            // Set session start
-            i->_sessionStart = getClientTsAdjusted();
-
-            // Add session start event
-            events::GAEvents::addSessionStartEvent();
         }
 
         void GAState::validateAndFixCurrentDimensions()
@@ -1184,19 +1528,19 @@ namespace gameanalytics
             // validate that there are no current dimension01 not in list
             if (!validators::GAValidator::validateDimension01(i->_currentCustomDimension01))
             {
-                logging::GALogger::d("Invalid dimension01 found in variable. Setting to nil. Invalid dimension: %s", i->_currentCustomDimension01);
+                GA_LOG_DEBUG("Invalid dimension01 found in variable. Setting to nil. Invalid dimension: %s", i->_currentCustomDimension01);
                 setCustomDimension01("");
             }
             // validate that there are no current dimension02 not in list
             if (!validators::GAValidator::validateDimension02(i->_currentCustomDimension02))
             {
-                logging::GALogger::d("Invalid dimension02 found in variable. Setting to nil. Invalid dimension: %s", i->_currentCustomDimension02);
+                GA_LOG_DEBUG("Invalid dimension02 found in variable. Setting to nil. Invalid dimension: %s", i->_currentCustomDimension02);
                 setCustomDimension02("");
             }
             // validate that there are no current dimension03 not in list
             if (!validators::GAValidator::validateDimension03(i->_currentCustomDimension03))
             {
-                logging::GALogger::d("Invalid dimension03 found in variable. Setting to nil. Invalid dimension: %s", i->_currentCustomDimension03);
+                GA_LOG_DEBUG("Invalid dimension03 found in variable. Setting to nil. Invalid dimension: %s", i->_currentCustomDimension03);
                 setCustomDimension03("");
             }
         }
@@ -1213,24 +1557,87 @@ namespace gameanalytics
 
         std::vector<char> GAState::getRemoteConfigsStringValue(const char* key, const char* defaultValue)
         {
-            std::vector<char> result;
+            const char* returnValue = getRemoteConfigsValue(key, defaultValue);
+            return std::vector<char>(returnValue, returnValue + strlen(returnValue) + 1);
+        }
+
+        const char* GAState::getRemoteConfigsValue(const char* key, const char* defaultValue)
+        {
+            defaultValue = defaultValue ? defaultValue : "";
             GAState* i = getInstance();
             if(!i)
             {
-                result.push_back('\0');
-                return result;
+                return defaultValue;
             }
-            std::lock_guard<std::mutex> lg(i->_mtx);
-            const char* returnValue = i->_configurations.HasMember(key) ? i->_configurations[key].GetString() : defaultValue;
 
-            size_t s = strlen(returnValue);
-            for(size_t i = 0; i < s; ++i)
+            const GARemoteConfigsSnapshot* configs = i->_remoteConfigs.load(std::memory_order_acquire);
+            const char* value = configs ? configs->getValue(key) : NULL;
+            return value ? value : defaultValue;
+        }
+
+        RemoteConfigKey GAState::registerRemoteConfigKey(const char* key)
+        {
+            RemoteConfigKey handle;
+            GAState* i = getInstance();
+            if(!i || !key || strlen(key) == 0)
             {
-                result.push_back(returnValue[i]);
+                return handle;
             }
-            result.push_back('\0');
 
-            return result;
+            std::lock_guard<std::mutex> lock(i->_remoteConfigKeysMtx);
+            for(size_t k = 0; k < i->_remoteConfigKeys.size(); ++k)
+            {
+                if(i->_remoteConfigKeys[k] == key)
+                {
+                    handle.id = static_cast<uint32_t>(k + 1);
+                    return handle;
+                }
+            }
+            if(i->_remoteConfigKeys.size() >= MaxRemoteConfigKeys)
+            {
+                logging::GALogger::w("Could not register remote config key, too many keys registered: %s", key);
+                return handle;
+            }
+
+            // reserved up front so readers can use the strings without locking
+            if(i->_remoteConfigKeys.capacity() < MaxRemoteConfigKeys)
+            {
+                i->_remoteConfigKeys.reserve(MaxRemoteConfigKeys);
+            }
+            i->_remoteConfigKeys.push_back(key);
+            handle.id = static_cast<uint32_t>(i->_remoteConfigKeys.size());
+            i->_remoteConfigKeyCount.store(handle.id, std::memory_order_release);
+            return handle;
+        }
+
+        const GARemoteConfigsSnapshot::Value* GAState::getRemoteConfig(const char* key)
+        {
+            GAState* i = getInstance();
+            if(!i)
+            {
+                return NULL;
+            }
+
+            const GARemoteConfigsSnapshot* configs = i->_remoteConfigs.load(std::memory_order_acquire);
+            return configs ? configs->find(key) : NULL;
+        }
+
+        const GARemoteConfigsSnapshot::Value* GAState::getRemoteConfig(RemoteConfigKey key)
+        {
+            GAState* i = getInstance();
+            if(!i || key.id == 0 || key.id > i->_remoteConfigKeyCount.load(std::memory_order_acquire))
+            {
+                return NULL;
+            }
+
+            const GARemoteConfigsSnapshot* configs = i->_remoteConfigs.load(std::memory_order_acquire);
+            if(!configs)
+            {
+                return NULL;
+            }
+            size_t slot = key.id - 1;
+            // keys registered after the snapshot was built are looked up by name
+            return configs->hasSlot(slot) ? configs->at(slot) : configs->find(i->_remoteConfigKeys[slot].c_str());
         }
 
         bool GAState::isRemoteConfigsReady()
@@ -1240,7 +1647,7 @@ namespace gameanalytics
             {
                 return false;
             }
-            return i->_remoteConfigsIsReady;
+            return i->_remoteConfigs.load(std::memory_order_acquire) != NULL;
         }
 
         void GAState::addRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener)
@@ -1273,27 +1680,10 @@ namespace gameanalytics
 
         std::vector<char> GAState::getRemoteConfigsContentAsString()
         {
-            std::vector<char> result;
             GAState* i = getInstance();
-            if(!i)
-            {
-                result.push_back('\0');
-                return result;
-            }
-
-            rapidjson::StringBuffer buffer;
-            rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-            i->_configurations.Accept(writer);
-            const char* returnValue = buffer.GetString();
-
-            size_t s = strlen(returnValue);
-            for(size_t i = 0; i < s; ++i)
-            {
-                result.push_back(returnValue[i]);
-            }
-            result.push_back('\0');
-
-            return result;
+            const GARemoteConfigsSnapshot* configs = i ? i->_remoteConfigs.load(std::memory_order_acquire) : NULL;
+            const char* returnValue = configs ? configs->getContent() : "{}";
+            return std::vector<char>(returnValue, returnValue + strlen(returnValue) + 1);
         }
 
         void GAState::populateConfigurations(rapidjson::Value& sdkConfig)
@@ -1349,20 +1739,49 @@ namespace gameanalytics
                                 }
                             }
 
-                            rapidjson::StringBuffer buffer;
-                            rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-                            configuration.Accept(writer);
-
-                            logging::GALogger::d("configuration added: %s", buffer.GetString());
+                            if(GA_LOG_DEBUG_ENABLED())
+                            {
+                                rapidjson::StringBuffer buffer;
+                                rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+                                configuration.Accept(writer);
+                                GA_LOG_DEBUG("configuration added: %s", buffer.GetString());
+                            }
                         }
                     }
                 }
             }
 
-            i->_remoteConfigsIsReady = true;
+            // sampling rules delivered through remote configs
+            const char* samplingKey = events::GAEventSampler::RemoteConfigsKey;
+            bool hasSamplingRules = i->_configurations.HasMember(samplingKey) && i->_configurations[samplingKey].IsString();
+            events::GAEventSampler::setRemoteRules(hasSamplingRules ? i->_configurations[samplingKey].GetString() : nullptr);
+
+            std::vector<const char*> registeredKeys;
+            {
+                std::lock_guard<std::mutex> lock(i->_remoteConfigKeysMtx);
+                for(size_t k = 0; k < i->_remoteConfigKeys.size(); ++k)
+                {
+                    registeredKeys.push_back(i->_remoteConfigKeys[k].c_str());
+                }
+            }
+
+            // publish a new snapshot only when something changed, the old one stays readable
+            std::unique_ptr<GARemoteConfigsSnapshot> snapshot(new GARemoteConfigsSnapshot(i->_configurations, registeredKeys));
+            const GARemoteConfigsSnapshot* current = i->_remoteConfigs.load(std::memory_order_relaxed);
+            std::vector<std::string> changedKeys;
+            if(!current || !current->hasSameContent(*snapshot))
+            {
+                snapshot->getChangedKeys(current, changedKeys);
+                i->_remoteConfigs.store(snapshot.get(), std::memory_order_release);
+                i->_remoteConfigsSnapshots.push_back(std::move(snapshot));
+            }
             for(auto& listener : i->_remoteConfigsListeners)
             {
                 listener->onRemoteConfigsUpdated();
+                if(!changedKeys.empty())
+                {
+                    listener->onRemoteConfigsChanged(changedKeys);
+                }
             }
 
             i->_mtx.unlock();
@@ -1374,67 +1793,56 @@ namespace gameanalytics
             result.SetObject();
             rapidjson::Document::AllocatorType& allocator = result.GetAllocator();
 
-            if (fields.IsObject() && fields.MemberCount() > 0)
+            EventFields cleanedFields;
+            validateAndCleanCustomFields(fields, cleanedFields);
+            for (size_t i = 0; i < cleanedFields.size(); ++i)
             {
-                int count = 0;
-
-                for (rapidjson::Value::ConstMemberIterator itr = fields.MemberBegin(); itr != fields.MemberEnd(); ++itr)
+                rapidjson::Value v(cleanedFields.keyAt(i), allocator);
+                if(cleanedFields.isStringAt(i))
                 {
-                    const char* key = itr->name.GetString();
-                    if(fields[key].IsNull())
-                    {
-                        logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s, value=null has been omitted because its key or value is null", key);
-                    }
-                    else if(count < MAX_CUSTOM_FIELDS_COUNT)
-                    {
-                        char pattern[65] = "";
-                        snprintf(pattern, sizeof(pattern), "^[a-zA-Z0-9_]{1,%d}$", MAX_CUSTOM_FIELDS_KEY_LENGTH);
-                        if(utilities::GAUtilities::stringMatch(key, pattern))
-                        {
-                            const rapidjson::Value& value = fields[key];
-
-                            if(value.IsNumber())
-                            {
-                                rapidjson::Value v(key, allocator);
-                                result.AddMember(v.Move(), value.GetDouble(), allocator);
-                                ++count;
-                            }
-                            else if(value.IsString())
-                            {
-                                std::string valueAsString = value.GetString();
-
-                                if(valueAsString.length() <= MAX_CUSTOM_FIELDS_VALUE_STRING_LENGTH && valueAsString.length() > 0)
-                                {
-                                    rapidjson::Value v(key, allocator);
-                                    rapidjson::Value v1(value.GetString(), allocator);
-                                    result.AddMember(v.Move(), v1.Move(), allocator);
-                                    ++count;
-                                }
-                                else
-                                {
-                                    logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s, value=%s has been omitted because its value is an empty string or exceeds the max number of characters (%d)", key, fields[key].GetString(), MAX_CUSTOM_FIELDS_VALUE_STRING_LENGTH);
-                                }
-                            }
-                            else
-                            {
-                                logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s has been omitted because its value is not a string or number", key);
-                            }
-                        }
-                        else
-                        {
-                            logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s, value=%s has been omitted because its key contains illegal character, is empty or exceeds the max number of characters (%d)", key, fields[key].GetString(), MAX_CUSTOM_FIELDS_KEY_LENGTH);
-                        }
-                    }
-                    else
-                    {
-                        logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s has been omitted because it exceeds the max number of custom fields (%d)", key, MAX_CUSTOM_FIELDS_COUNT);
-                    }
+                    rapidjson::Value v1(cleanedFields.stringAt(i), allocator);
+                    result.AddMember(v.Move(), v1.Move(), allocator);
+                }
+                else
+                {
+                    result.AddMember(v.Move(), cleanedFields.numberAt(i), allocator);
                 }
             }
 
             out.CopyFrom(result, allocator);
         }
 
+        void GAState::validateAndCleanCustomFields(const rapidjson::Value& fields, EventFields& out)
+        {
+            if (!fields.IsObject())
+            {
+                return;
+            }
+
+            // key, value and count limits are checked by EventFields::add
+            for (rapidjson::Value::ConstMemberIterator itr = fields.MemberBegin(); itr != fields.MemberEnd(); ++itr)
+            {
+                const char* key = itr->name.GetString();
+                const rapidjson::Value& value = itr->value;
+                if(value.IsNull())
+                {
+                    logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s, value=null has been omitted because its key or value is null", key);
+                }
+                else if(value.IsNumber())
+                {
+                    out.add(key, value.GetDouble());
+                }
+                else if(value.IsString())
+                {
+                    out.add(key, value.GetString());
+                }
+                else
+                {
+                    logging::GALogger::w("validateAndCleanCustomFields: entry with key=%s has been omitted because its value is not a string or number", key);
+                }
+            }
+        }
+
         int64_t GAState::getClientTsAdjusted()
         {
             GAState* i = getInstance();
@@ -1482,11 +1890,11 @@ namespace gameanalytics
             i->_useManualSessionHandling = flag;
             if(flag)
             {
-                logging::GALogger::i("Use manual session handling: true");
+                GA_LOG_INFO("Use manual session handling: true");
             }
             else
             {
-                logging::GALogger::i("Use manual session handling: false");
+                GA_LOG_INFO("Use manual session handling: false");
             }
         }
 
@@ -1510,11 +1918,11 @@ namespace gameanalytics
             i->_enableErrorReporting = flag;
             if(flag)
             {
-                logging::GALogger::i("Use error reporting: true");
+                GA_LOG_INFO("Use error reporting: true");
             }
             else
             {
-                logging::GALogger::i("Use error reporting: false");
+                GA_LOG_INFO("Use error reporting: false");
             }
         }
 
@@ -10,7 +10,17 @@
 #include <functional>
 #include "rapidjson/document.h"
 #include "GameAnalytics.h"
+#include "GAClient.h"
+#include "GAHTTPApi.h"
+#include "GARemoteConfigsSnapshot.h"
+#include "GAStringSet.h"
+#include "GAPlayerContexts.h"
 #include <mutex>
+#include <atomic>
+#include <memory>
+#if !USE_UWP && !NO_ASYNC
+#include <thread>
+#endif
 #include <cstdlib>
 
 namespace gameanalytics
@@ -39,6 +49,7 @@ namespace gameanalytics
             static int getSessionNum();
             static int getTransactionNum();
             static const char* getSessionId();
+            static const char* getIdentifier();
             static const char* getCurrentCustomDimension01();
             static const char* getCurrentCustomDimension02();
             static const char* getCurrentCustomDimension03();
@@ -80,26 +91,48 @@ namespace gameanalytics
             static bool isEventSubmissionEnabled();
             static bool sessionIsStarted();
             static void validateAndCleanCustomFields(const rapidjson::Value& fields, rapidjson::Value& out);
+            static void validateAndCleanCustomFields(const rapidjson::Value& fields, EventFields& out);
             static std::vector<char> getRemoteConfigsStringValue(const char* key, const char* defaultValue);
+            // lock and allocation free, the string stays valid until shutdown
+            static const char* getRemoteConfigsValue(const char* key, const char* defaultValue);
+            static RemoteConfigKey registerRemoteConfigKey(const char* key);
+            // null when missing, lock and allocation free
+            static const GARemoteConfigsSnapshot::Value* getRemoteConfig(const char* key);
+            static const GARemoteConfigsSnapshot::Value* getRemoteConfig(RemoteConfigKey key);
             static bool isRemoteConfigsReady();
             static void addRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener);
             static void removeRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener);
             static std::vector<char> getRemoteConfigsContentAsString();
             static std::vector<char> getAbId();
             static std::vector<char> getAbVariantId();
+            // multi-user mode, GA thread only. Starting a session for a player that
+            // has one ends it first, players over the limit are evicted and ended.
+            static void startPlayerSession(const char* userId, int sessionNum, int transactionNum);
+            static void endPlayerSession(const char* userId);
+            static void endAllPlayerSessions();
+            static std::shared_ptr<GAPlayerContext> getPlayer(const char* userId);
+            static void setMaxPlayers(int maxPlayers);
+            // true while events are built for a player, see GAPlayerScope
+            static bool hasActivePlayer();
 
         private:
             GAState();
             ~GAState();
             GAState(const GAState&) = delete;
             GAState& operator=(const GAState&) = delete;
+            friend class client::GAClientContext;
 
-            static const char* getIdentifier();
             static void setDefaultUserId(const char* id);
             static void getSdkConfig(rapidjson::Value& out);
             static void cacheIdentifier();
             static void ensurePersistedStates();
             static void startNewSession();
+            static void beginSession();
+            // enabled flag, time offset and remote configs from the current sdk config
+            static void applySdkConfig();
+            // refreshes the sdk config without blocking the session start
+            static void requestInit();
+            static void applyInitResponse(http::EGAHTTPApiResponse initResponse, rapidjson::Document& initResponseDict);
             static void validateAndFixCurrentDimensions();
             static const char* getBuild();
             static int64_t calculateServerTimeOffset(int64_t serverTs);
@@ -107,11 +140,15 @@ namespace gameanalytics
             static void setConfigsHash(const char* configsHash);
             static void setAbId(const char* abId);
             static void setAbVariantId(const char* abVariantId);
+            static void endPlayerSession(GAPlayerContext& player);
 
             static bool _destroyed;
             static GAState* _instance;
             static std::once_flag _initInstanceFlag;
             static void cleanUp();
+            // overrides the user and session state for the current thread
+            static thread_local GAPlayerContext* _activePlayer;
+            friend class GAPlayerScope;
 
             static void initInstance()
             {
@@ -134,14 +171,20 @@ namespace gameanalytics
             char _currentCustomDimension03[65] = {'\0'};
             char _gameKey[65] = {'\0'};
             char _gameSecret[65] = {'\0'};
-            StringVector _availableCustomDimensions01;
-            StringVector _availableCustomDimensions02;
-            StringVector _availableCustomDimensions03;
-            StringVector _availableResourceCurrencies;
-            StringVector _availableResourceItemTypes;
+            utilities::GAStringSet _availableCustomDimensions01;
+            utilities::GAStringSet _availableCustomDimensions02;
+            utilities::GAStringSet _availableCustomDimensions03;
+            utilities::GAStringSet _availableResourceCurrencies;
+            utilities::GAStringSet _availableResourceItemTypes;
             char _build[65] = {'\0'};
             bool _initAuthorized = false;
             bool _enabled = false;
+            // session start was skipped because the cached config had the SDK disabled
+            bool _sessionWaitingForInit = false;
+            std::atomic<bool> _initInFlight{false};
+#if !USE_UWP && !NO_ASYNC
+            std::thread _initThread;
+#endif
             int64_t _clientServerTimeOffset = 0;
             char _defaultUserId[129] = {'\0'};
             char _configsHash[129] = {'\0'};
@@ -156,9 +199,34 @@ namespace gameanalytics
             bool _enableErrorReporting = true;
             bool _enableEventSubmission = true;
             rapidjson::Document _configurations;
-            bool _remoteConfigsIsReady;
+            // current remote configs, null until the first sdk config is applied
+            std::atomic<const GARemoteConfigsSnapshot*> _remoteConfigs{nullptr};
+            // every published snapshot, kept until shutdown so readers never see one freed
+            std::vector<std::unique_ptr<GARemoteConfigsSnapshot>> _remoteConfigsSnapshots;
+            static const uint32_t MaxRemoteConfigKeys;
+            // registered key names by id - 1, never reallocated once the first key is in
+            std::vector<std::string> _remoteConfigKeys;
+            std::atomic<uint32_t> _remoteConfigKeyCount{0};
+            std::mutex _remoteConfigKeysMtx;
             std::vector<std::shared_ptr<IRemoteConfigsListener>> _remoteConfigsListeners;
+            GAPlayerContexts _players;
             std::mutex _mtx;
         };
+
+        // While in scope the user, session, counter, dimension and progression
+        // state of GAState is the player's on the calling thread, so events
+        // are built for the player through the regular GAEvents functions.
+        class GAPlayerScope
+        {
+        public:
+            explicit GAPlayerScope(GAPlayerContext* player);
+            ~GAPlayerScope();
+
+        private:
+            GAPlayerScope(const GAPlayerScope&) = delete;
+            GAPlayerScope& operator=(const GAPlayerScope&) = delete;
+
+            GAPlayerContext* _previous;
+        };
     }
 }
@@ -8,6 +8,7 @@
 #include "GAThreading.h"
 #include "GALogger.h"
 #include "GAUtilities.h"
+#include "GAMetrics.h"
 #include <fstream>
 #include <string.h>
 #if USE_UWP
@@ -34,6 +35,15 @@ namespace gameanalytics
         {
         }
 
+        GAStore::~GAStore()
+        {
+            if(sqlDatabase)
+            {
+                sqlite3_close(sqlDatabase);
+                sqlDatabase = nullptr;
+            }
+        }
+
         void GAStore::cleanUp()
         {
             delete _instance;
@@ -44,6 +54,11 @@ namespace gameanalytics
 
         GAStore* GAStore::getInstance()
         {
+            client::GAClientContext* client = client::GAClientContext::current();
+            if(client)
+            {
+                return client->getStore();
+            }
             std::call_once(_initInstanceFlag, &GAStore::initInstance);
             return _instance;
         }
@@ -90,16 +105,15 @@ namespace gameanalytics
             {
                 return;
             }
+            metrics::GAMetricsTimer timer(metrics::QueryTime);
             // Force transaction if it is an update, insert or delete.
-            size_t arraySize = strlen(sql) + 1;
-            char* sqlUpper = new char[arraySize];
-            snprintf(sqlUpper, arraySize, "%s", sql);
-            utilities::GAUtilities::uppercaseString(sqlUpper);
-            if (utilities::GAUtilities::stringMatch(sqlUpper, "^(UPDATE|INSERT|DELETE)"))
+            char sqlPrefix[7] = "";
+            snprintf(sqlPrefix, sizeof(sqlPrefix), "%s", sql);
+            utilities::GAUtilities::uppercaseString(sqlPrefix);
+            if (strcmp(sqlPrefix, "UPDATE") == 0 || strcmp(sqlPrefix, "INSERT") == 0 || strcmp(sqlPrefix, "DELETE") == 0)
             {
                 useTransaction = true;
             }
-            delete[] sqlUpper;
 
             // Get database connection from singelton getInstance
             sqlite3 *sqlDatabasePtr = i->getDatabase();
@@ -202,7 +216,7 @@ namespace gameanalytics
             }
             else
             {
-                logging::GALogger::d("SQLITE3 FINALIZE ERROR: %s", sqlite3_errmsg(sqlDatabasePtr));
+                GA_LOG_DEBUG("SQLITE3 FINALIZE ERROR: %s", sqlite3_errmsg(sqlDatabasePtr));
 
                 out.Clear();
                 if (useTransaction)
@@ -265,16 +279,17 @@ namespace gameanalytics
             else
             {
                 i->dbReady = true;
-                logging::GALogger::i("Database opened: %s", i->dbPath);
+                GA_LOG_INFO("Database opened: %s", i->dbPath);
             }
 
             if (dropDatabase)
             {
-                logging::GALogger::d("Drop tables");
+                GA_LOG_DEBUG("Drop tables");
                 GAStore::executeQuerySync("DROP TABLE ga_events");
                 GAStore::executeQuerySync("DROP TABLE ga_state");
                 GAStore::executeQuerySync("DROP TABLE ga_session");
                 GAStore::executeQuerySync("DROP TABLE ga_progression");
+                GAStore::executeQuerySync("DROP TABLE ga_crashes");
                 GAStore::executeQuerySync("VACUUM");
             }
 
@@ -283,16 +298,18 @@ namespace gameanalytics
             const char* sql_ga_session = "CREATE TABLE IF NOT EXISTS ga_session(session_id CHAR(50) PRIMARY KEY NOT NULL, timestamp CHAR(50) NOT NULL, event TEXT NOT NULL);";
             const char* sql_ga_state = "CREATE TABLE IF NOT EXISTS ga_state(key CHAR(255) PRIMARY KEY NOT NULL, value TEXT);";
             const char* sql_ga_progression = "CREATE TABLE IF NOT EXISTS ga_progression(progression CHAR(255) PRIMARY KEY NOT NULL, tries CHAR(255));";
+            // crash fingerprints already sent with their stack and the repeats not sent yet
+            const char* sql_ga_crashes = "CREATE TABLE IF NOT EXISTS ga_crashes(fingerprint CHAR(50) PRIMARY KEY NOT NULL, count INTEGER NOT NULL, pending INTEGER NOT NULL, reported_ts INTEGER NOT NULL);";
 
             if (!GAStore::executeQuerySync(sql_ga_events))
             {
-                logging::GALogger::d("ensureDatabase failed: %s", sql_ga_events);
+                GA_LOG_DEBUG("ensureDatabase failed: %s", sql_ga_events);
                 return false;
             }
 
             if (!GAStore::executeQuerySync("SELECT status FROM ga_events LIMIT 0,1"))
             {
-                logging::GALogger::d("ga_events corrupt, recreating.");
+                GA_LOG_DEBUG("ga_events corrupt, recreating.");
                 GAStore::executeQuerySync("DROP TABLE ga_events");
                 if (!GAStore::executeQuerySync(sql_ga_events))
                 {
@@ -308,7 +325,7 @@ namespace gameanalytics
 
             if (!GAStore::executeQuerySync("SELECT session_id FROM ga_session LIMIT 0,1"))
             {
-                logging::GALogger::d("ga_session corrupt, recreating.");
+                GA_LOG_DEBUG("ga_session corrupt, recreating.");
                 GAStore::executeQuerySync("DROP TABLE ga_session");
                 if (!GAStore::executeQuerySync(sql_ga_session))
                 {
@@ -324,7 +341,7 @@ namespace gameanalytics
 
             if (!GAStore::executeQuerySync("SELECT key FROM ga_state LIMIT 0,1"))
             {
-                logging::GALogger::d("ga_state corrupt, recreating.");
+                GA_LOG_DEBUG("ga_state corrupt, recreating.");
                 GAStore::executeQuerySync("DROP TABLE ga_state");
                 if (!GAStore::executeQuerySync(sql_ga_state))
                 {
@@ -340,7 +357,7 @@ namespace gameanalytics
 
             if (!GAStore::executeQuerySync("SELECT progression FROM ga_progression LIMIT 0,1"))
             {
-                logging::GALogger::d("ga_progression corrupt, recreating.");
+                GA_LOG_DEBUG("ga_progression corrupt, recreating.");
                 GAStore::executeQuerySync("DROP TABLE ga_progression");
                 if (!GAStore::executeQuerySync(sql_ga_progression))
                 {
@@ -349,10 +366,26 @@ namespace gameanalytics
                 }
             }
 
+            if (!GAStore::executeQuerySync(sql_ga_crashes))
+            {
+                return false;
+            }
+
+            if (!GAStore::executeQuerySync("SELECT fingerprint FROM ga_crashes LIMIT 0,1"))
+            {
+                GA_LOG_DEBUG("ga_crashes corrupt, recreating.");
+                GAStore::executeQuerySync("DROP TABLE ga_crashes");
+                if (!GAStore::executeQuerySync(sql_ga_crashes))
+                {
+                    logging::GALogger::w("ga_crashes corrupt, could not recreate it.");
+                    return false;
+                }
+            }
+
             trimEventTable();
 
             i->tableReady = true;
-            logging::GALogger::d("Database tables ensured present");
+            GA_LOG_DEBUG("Database tables ensured present");
 
             return true;
         }
@@ -9,6 +9,7 @@
 #include <vector>
 #include "rapidjson/document.h"
 #include "GameAnalytics.h"
+#include "GAClient.h"
 #include <mutex>
 #include <cstdlib>
 
@@ -43,8 +44,10 @@ namespace gameanalytics
 
         private:
             GAStore();
+            ~GAStore();
             GAStore(const GAStore&) = delete;
             GAStore& operator=(const GAStore&) = delete;
+            friend class client::GAClientContext;
 
             static bool _destroyed;
             static GAStore* _instance;
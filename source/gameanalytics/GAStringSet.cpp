@@ -0,0 +1,39 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAStringSet.h"
+#include "GAUtilities.h"
+#include <cstdint>
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        size_t GAStringSet::Hash::operator()(const char* s) const
+        {
+            return static_cast<size_t>(GAUtilities::fnv1a(s));
+        }
+
+        GAStringSet::GAStringSet()
+        {
+        }
+
+        void GAStringSet::assign(const StringVector& strings)
+        {
+            _set.clear();
+            _strings = strings.getVector();
+            _set.reserve(_strings.size());
+            for(size_t i = 0; i < _strings.size(); ++i)
+            {
+                _set.insert(_strings[i].array);
+            }
+        }
+
+        bool GAStringSet::contains(const char* s) const
+        {
+            return s && !_set.empty() && _set.find(s) != _set.end();
+        }
+    }
+}
@@ -0,0 +1,52 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics.h"
+#include <unordered_set>
+#include <vector>
+#include <cstdlib>
+#include <string.h>
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        // Hash set over the strings of a StringVector, built once when the list
+        // is configured so lookups stay constant time however long it is.
+        class GAStringSet
+        {
+        public:
+            GAStringSet();
+
+            void assign(const StringVector& strings);
+            // does not allocate
+            bool contains(const char* s) const;
+            size_t size() const { return _set.size(); }
+
+        private:
+            // the set points into _strings
+            GAStringSet(const GAStringSet&) = delete;
+            GAStringSet& operator=(const GAStringSet&) = delete;
+
+            struct Hash
+            {
+                size_t operator()(const char* s) const;
+            };
+
+            struct Equal
+            {
+                bool operator()(const char* first, const char* second) const
+                {
+                    return strcmp(first, second) == 0;
+                }
+            };
+
+            std::vector<CharArray> _strings;
+            std::unordered_set<const char*, Hash, Equal> _set;
+        };
+    }
+}
@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <stdexcept>
 #include "GALogger.h"
+#include "GAClient.h"
+#include "GAMetrics.h"
 #include <thread>
 #include <exception>
 
@@ -28,6 +30,20 @@ namespace gameanalytics
             }
             std::lock_guard<std::mutex> lock(state->mutex);
 
+            // every client has its own timer, they wait with the tasks
+            if(client::GAClientContext::current())
+            {
+                state->blocks.push_back({ client::GAClientContext::bind(callback), std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<int>(1000 * interval)) });
+                std::push_heap(state->blocks.begin(), state->blocks.end());
+                metrics::GAMetrics::add(metrics::TasksEnqueued);
+                GAThreading::_threadDeadline = std::max<long long>(GAThreading::_threadDeadline, GAThreading::getTimeInNs(interval + 2.0));
+                if(state->isThreadFinished())
+                {
+                    state->setThread(GAThreading::thread_routine, GAThreading::_endThread, GAThreading::_threadDeadline);
+                }
+                return;
+            }
+
             if(state->hasScheduledBlockRun)
             {
                 state->scheduledBlock = { callback, std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<int>(1000 * interval)) };
@@ -44,12 +60,14 @@ namespace gameanalytics
         {
             if(_endThread)
             {
+                metrics::GAMetrics::add(metrics::TasksDropped);
                 return;
             }
             std::lock_guard<std::mutex> lock(state->mutex);
-            state->blocks.push_back({ taskBlock, std::chrono::steady_clock::now()} );
+            state->blocks.push_back({ client::GAClientContext::bind(taskBlock), std::chrono::steady_clock::now()} );
             std::push_heap(state->blocks.begin(), state->blocks.end());
-            GAThreading::_threadDeadline = GAThreading::getTimeInNs(10.0);
+            metrics::GAMetrics::add(metrics::TasksEnqueued);
+            GAThreading::_threadDeadline = std::max<long long>(GAThreading::_threadDeadline, GAThreading::getTimeInNs(10.0));
             if(state->isThreadFinished())
             {
                 state->setThread(GAThreading::thread_routine, GAThreading::_endThread, GAThreading::_threadDeadline);
@@ -126,6 +144,7 @@ namespace gameanalytics
                 timedBlock.block();
                 // clear the block, so that the assert works
                 timedBlock.block = {};
+                metrics::GAMetrics::add(metrics::TasksProcessed);
             }
 
             if(getScheduledBlock(timedBlock))
@@ -140,7 +159,7 @@ namespace gameanalytics
 
         void GAThreading::thread_routine(std::atomic<bool>& endThread, std::atomic_llong& threadDeadline)
         {
-            logging::GALogger::d("thread_routine start");
+            GA_LOG_DEBUG("thread_routine start");
 
             try
             {
@@ -159,7 +178,7 @@ namespace gameanalytics
 
                 if(!endThread)
                 {
-                    logging::GALogger::d("thread_routine stopped");
+                    GA_LOG_DEBUG("thread_routine stopped");
                 }
             }
             catch(const std::exception& e)
@@ -6,6 +6,8 @@
 
 #include "GAThreading.h"
 #include "GALogger.h"
+#include "GAClient.h"
+#include "GAMetrics.h"
 
 namespace gameanalytics
 {
@@ -25,13 +27,14 @@ namespace gameanalytics
         void GAThreading::scheduleTimer(double interval, const Block& callback)
         {
             initIfNeeded();
-            ecore_timer_add(interval, _scheduled_function, new BlockHolder(callback));
+            ecore_timer_add(interval, _scheduled_function, new BlockHolder(client::GAClientContext::bind(callback)));
         }
 
         void GAThreading::performTaskOnGAThread(const Block& taskBlock)
         {
             initIfNeeded();
-            ecore_thread_run(_perform_task_function, _end_function, NULL, new BlockHolder(taskBlock));
+            metrics::GAMetrics::add(metrics::TasksEnqueued);
+            ecore_thread_run(_perform_task_function, _end_function, NULL, new BlockHolder(client::GAClientContext::bind(taskBlock)));
         }
 
         void GAThreading::endThread()
@@ -81,11 +84,12 @@ namespace gameanalytics
             }
 
             delete blockHolder;
+            metrics::GAMetrics::add(metrics::TasksProcessed);
         }
 
         void GAThreading::_end_function(void* data, Ecore_Thread* thread)
         {
-            //logging::GALogger::d("GAThreading::_perform_task_function has finished");
+            //GA_LOG_DEBUG("GAThreading::_perform_task_function has finished");
         }
     }
 }
@@ -6,297 +6,562 @@
 #include "GAUncaughtExceptionHandler.h"
 #include "GAState.h"
 #include "GAEvents.h"
-#include <stacktrace/call_stack.hpp>
+#include "GAStore.h"
+#include "GADevice.h"
+#include "GAUtilities.h"
+#include "GALogger.h"
 #include <string.h>
 #include <stdio.h>
-#include <cstdarg>
+#include <time.h>
+#include <cinttypes>
 #if defined(_WIN32)
 #include <stdlib.h>
 #include <tchar.h>
+#include <windows.h>
 #else
 #include <execinfo.h>
 #include <cstring>
 #include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #endif
 
 namespace gameanalytics
 {
     namespace errorreporter
     {
+        const uint32_t GACrashRecord::Magic;
+        const uint32_t GACrashRecord::Version;
+        const int GACrashRecord::MaxFrames;
+        const int GACrashRecord::MaxModules;
+        const size_t GAUncaughtExceptionHandler::FingerprintSize = 17;
+        // frames that make up the fingerprint, deeper frames rarely tell crashes apart
+        static const uint32_t FingerprintFrames = 16;
+        static const int64_t CrashRepeatsIntervalInSeconds = 24 * 60 * 60;
+        // the record of this run, then the crash of an earlier run until it is reported
+        static const size_t CrashRecordFileSize = 2 * sizeof(GACrashRecord);
+
         std::terminate_handler GAUncaughtExceptionHandler::previousTerminateHandler = NULL;
 #if defined(_WIN32)
         void (*GAUncaughtExceptionHandler::old_state_ill) (int) = NULL;
         void (*GAUncaughtExceptionHandler::old_state_abrt) (int) = NULL;
         void (*GAUncaughtExceptionHandler::old_state_fpe) (int) = NULL;
         void (*GAUncaughtExceptionHandler::old_state_segv) (int) = NULL;
+        void* GAUncaughtExceptionHandler::crashRecordFile = NULL;
+        void* GAUncaughtExceptionHandler::crashRecordMapping = NULL;
 #else
-        struct sigaction GAUncaughtExceptionHandler::prevSigAction;
+        struct sigaction GAUncaughtExceptionHandler::prevSigActions[NSIG];
 #endif
-        int GAUncaughtExceptionHandler::errorCount = 0;
-        int GAUncaughtExceptionHandler::MAX_ERROR_TYPE_COUNT = 5;
+        bool GAUncaughtExceptionHandler::handlersInstalled = false;
+        GACrashRecord* GAUncaughtExceptionHandler::crashRecord = NULL;
+        GACrashRecord* GAUncaughtExceptionHandler::previousCrashRecord = NULL;
+        std::atomic_flag GAUncaughtExceptionHandler::crashWritten = ATOMIC_FLAG_INIT;
+        GACrashRecord GAUncaughtExceptionHandler::previousCrash;
+        bool GAUncaughtExceptionHandler::previousCrashFound = false;
 
-#if defined(_WIN32)
-        void GAUncaughtExceptionHandler::signalHandler(int sig)
+        bool GAUncaughtExceptionHandler::openCrashRecord(const char* path)
         {
-            if(state::GAState::useErrorReporting())
+            closeCrashRecord();
+
+            void* memory = NULL;
+#if defined(_WIN32)
+            HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+            if(file == INVALID_HANDLE_VALUE)
             {
-                if(errorCount <= MAX_ERROR_TYPE_COUNT)
-                {
-                    stacktrace::call_stack st;
-                    size_t totalSize = 0;
-                    totalSize += formatSize("Uncaught Signal (%d)\n", sig);
-                    totalSize += strlen("Stack trace:\n");
-                    totalSize += st.to_string_size() + strlen("\n");
-                    char* buffer = new char[totalSize + 1];
-                    buffer[0] = 0;
-
-                    formatConcat(buffer, "Uncaught Signal (%d)\n", sig);
-                    strcat(buffer, "Stack trace:\n");
-                    st.to_string(buffer);
-                    strcat(buffer, "\n");
-
-                    errorCount = errorCount + 1;
-                    events::GAEvents::addErrorEvent(EGAErrorSeverity::Critical, buffer, {});
-                    events::GAEvents::processEvents("error", false);
-                    delete[] buffer;
-                }
+                return false;
             }
-
-            if(sig == SIGILL && old_state_ill != NULL)
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, 0, CrashRecordFileSize, NULL);
+            if(!mapping)
             {
-                old_state_ill(sig);
+                CloseHandle(file);
+                return false;
             }
-            else if(sig == SIGABRT && old_state_abrt != NULL)
+            memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, CrashRecordFileSize);
+            if(!memory)
             {
-                old_state_abrt(sig);
+                CloseHandle(mapping);
+                CloseHandle(file);
+                return false;
             }
-            else if(sig == SIGFPE && old_state_fpe != NULL)
+            crashRecordFile = file;
+            crashRecordMapping = mapping;
+#else
+            int fd = open(path, O_RDWR | O_CREAT, 0644);
+            if(fd < 0)
             {
-                old_state_fpe(sig);
+                return false;
             }
-            else if(sig == SIGSEGV && old_state_segv != NULL)
+            if(ftruncate(fd, CrashRecordFileSize) != 0)
             {
-                old_state_segv(sig);
+                close(fd);
+                return false;
+            }
+            memory = mmap(NULL, CrashRecordFileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if(memory == MAP_FAILED)
+            {
+                return false;
+            }
+#endif
+            GACrashRecord* record = static_cast<GACrashRecord*>(memory);
+            GACrashRecord* previous = record + 1;
+            if(record->magic == GACrashRecord::Magic && record->version == GACrashRecord::Version)
+            {
+                // moved out of the way of this run's crash, it stays on disk until reported
+                *previous = *record;
+            }
+            if(previous->magic == GACrashRecord::Magic && previous->version == GACrashRecord::Version)
+            {
+                previousCrash = *previous;
+                previousCrash.sessionId[sizeof(previousCrash.sessionId) - 1] = '\0';
+                if(previousCrash.frameCount > static_cast<uint32_t>(GACrashRecord::MaxFrames))
+                {
+                    previousCrash.frameCount = GACrashRecord::MaxFrames;
+                }
+                if(previousCrash.moduleCount > static_cast<uint32_t>(GACrashRecord::MaxModules))
+                {
+                    previousCrash.moduleCount = GACrashRecord::MaxModules;
+                }
+                previousCrashFound = true;
             }
+
+            // value initialised, the module entries have a constructor so memset does not fit
+            *record = GACrashRecord();
+            record->version = GACrashRecord::Version;
+            crashRecord = record;
+            previousCrashRecord = previous;
+            crashWritten.clear();
+            updateModules();
+            return true;
         }
 
-        void GAUncaughtExceptionHandler::setupUncaughtSignals()
+        void GAUncaughtExceptionHandler::updateModules()
         {
-            signal(SIGILL, signalHandler);
-            signal(SIGABRT, signalHandler);
-            signal(SIGFPE, signalHandler);
-            signal(SIGSEGV, signalHandler);
+            if(!crashRecord)
+            {
+                return;
+            }
+
+            stacktrace::loaded_module modules[GACrashRecord::MaxModules];
+            size_t count = stacktrace::loaded_modules(modules, GACrashRecord::MaxModules);
+            for(size_t i = 0; i < count; ++i)
+            {
+                crashRecord->modules[i] = modules[i];
+            }
+            crashRecord->moduleCount = static_cast<uint32_t>(count);
         }
-#else
-        void GAUncaughtExceptionHandler::setupUncaughtSignals()
+
+        void GAUncaughtExceptionHandler::closeCrashRecord()
         {
-            struct sigaction mySigAction;
-            mySigAction.sa_sigaction = signalHandler;
-            mySigAction.sa_flags = SA_SIGINFO;
+            if(!crashRecord)
+            {
+                return;
+            }
 
-            sigemptyset(&mySigAction.sa_mask);
-            sigaction(SIGQUIT, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+            GACrashRecord* record = crashRecord;
+            crashRecord = NULL;
+            previousCrashRecord = NULL;
+            previousCrashFound = false;
+#if defined(_WIN32)
+            UnmapViewOfFile(record);
+            CloseHandle(crashRecordMapping);
+            CloseHandle(crashRecordFile);
+            crashRecordMapping = NULL;
+            crashRecordFile = NULL;
+#else
+            munmap(record, CrashRecordFileSize);
+#endif
+        }
+
+        void GAUncaughtExceptionHandler::setCrashSession(const char* sessionId, int sessionNum)
+        {
+            if(!crashRecord)
             {
-                sigaction(SIGQUIT, &mySigAction, NULL);
+                return;
             }
-            sigaction(SIGILL, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+
+            snprintf(crashRecord->sessionId, sizeof(crashRecord->sessionId), "%s", sessionId);
+            crashRecord->sessionNum = sessionNum;
+            // libraries loaded since the last session
+            updateModules();
+        }
+
+        bool GAUncaughtExceptionHandler::hasPreviousCrash()
+        {
+            return previousCrashFound;
+        }
+
+        void GAUncaughtExceptionHandler::reportPreviousCrash()
+        {
+            if(!state::GAState::useErrorReporting())
             {
-                sigaction(SIGILL, &mySigAction, NULL);
+                clearPreviousCrash();
+                return;
             }
-            sigaction(SIGTRAP, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+
+            // nothing could be sent, the crash and the repeats wait for a later session
+            if(!state::GAState::isEventSubmissionEnabled())
             {
-                sigaction(SIGTRAP, &mySigAction, NULL);
+                return;
             }
-            sigaction(SIGABRT, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+
+            if(previousCrashFound)
             {
-                sigaction(SIGABRT, &mySigAction, NULL);
+
+                char fingerprint[FingerprintSize];
+                crashFingerprint(previousCrash, fingerprint);
+                char now[21] = "";
+                snprintf(now, sizeof(now), "%" PRId64, utilities::GAUtilities::timeIntervalSince1970());
+
+                rapidjson::Document rows;
+                const char* selectParameters[] = { fingerprint };
+                store::GAStore::executeQuerySync("SELECT count FROM ga_crashes WHERE fingerprint = ?;", selectParameters, 1, rows);
+                if(rows.IsArray() && !rows.Empty())
+                {
+                    // already sent with its stack, only counted
+                    GA_LOG_INFO("Crash %s from previous session seen before, counting it", fingerprint);
+                    store::GAStore::executeQuerySync("UPDATE ga_crashes SET count = count + 1, pending = pending + 1 WHERE fingerprint = ?;", selectParameters, 1);
+                }
+                else
+                {
+                    std::string message;
+                    crashMessage(previousCrash, message);
+                    logging::GALogger::w("Reporting crash %s from previous session %s", fingerprint, previousCrash.sessionId);
+
+                    EventFields fields;
+                    fields.add("crash_fingerprint", fingerprint);
+                    fields.add("crash_count", 1);
+                    if(previousCrash.sessionId[0])
+                    {
+                        fields.add("crash_session_id", previousCrash.sessionId);
+                        fields.add("crash_session_num", previousCrash.sessionNum);
+                    }
+                    fields.add("crash_client_ts", static_cast<double>(previousCrash.timestamp));
+                    events::GAEvents::addErrorEvent(EGAErrorSeverity::Critical, message.c_str(), fields);
+
+                    const char* insertParameters[] = { fingerprint, now };
+                    store::GAStore::executeQuerySync("INSERT OR REPLACE INTO ga_crashes (fingerprint, count, pending, reported_ts) VALUES(?, 1, 0, ?);", insertParameters, 2);
+                }
+
+                // only now, a run that ends before this point reports it next time
+                clearPreviousCrash();
             }
-#if !USE_LINUX
-            sigaction(SIGEMT, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+
+            reportCrashRepeats();
+        }
+
+        void GAUncaughtExceptionHandler::clearPreviousCrash()
+        {
+            previousCrashFound = false;
+            if(previousCrashRecord)
             {
-                sigaction(SIGEMT, &mySigAction, NULL);
+                previousCrashRecord->magic = 0;
             }
-#endif
-            sigaction(SIGFPE, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+        }
+
+        void GAUncaughtExceptionHandler::reportCrashRepeats()
+        {
+            if(!store::GAStore::getTableReady())
             {
-                sigaction(SIGFPE, &mySigAction, NULL);
+                return;
             }
-            sigaction(SIGBUS, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+
+            int64_t now = utilities::GAUtilities::timeIntervalSince1970();
+            char since[21] = "";
+            snprintf(since, sizeof(since), "%" PRId64, now - CrashRepeatsIntervalInSeconds);
+            char nowString[21] = "";
+            snprintf(nowString, sizeof(nowString), "%" PRId64, now);
+
+            rapidjson::Document rows;
+            const char* selectParameters[] = { since };
+            store::GAStore::executeQuerySync("SELECT fingerprint, pending FROM ga_crashes WHERE pending > 0 AND reported_ts <= ?;", selectParameters, 1, rows);
+            if(!rows.IsArray())
             {
-                sigaction(SIGBUS, &mySigAction, NULL);
+                return;
             }
-            sigaction(SIGSEGV, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+
+            for(rapidjson::Value::ConstValueIterator itr = rows.Begin(); itr != rows.End(); ++itr)
             {
-                sigaction(SIGSEGV, &mySigAction, NULL);
+                if(!itr->HasMember("fingerprint") || !itr->HasMember("pending") || !(*itr)["fingerprint"].IsString() || !(*itr)["pending"].IsInt())
+                {
+                    continue;
+                }
+
+                const char* fingerprint = (*itr)["fingerprint"].GetString();
+                int pending = (*itr)["pending"].GetInt();
+                char message[64] = "";
+                snprintf(message, sizeof(message), "Crash repeated: %s", fingerprint);
+
+                EventFields fields;
+                fields.add("crash_fingerprint", fingerprint);
+                fields.add("crash_count", static_cast<double>(pending));
+                events::GAEvents::addErrorEvent(EGAErrorSeverity::Critical, message, fields);
+
+                const char* updateParameters[] = { nowString, fingerprint };
+                store::GAStore::executeQuerySync("UPDATE ga_crashes SET pending = 0, reported_ts = ? WHERE fingerprint = ?;", updateParameters, 2);
             }
-            sigaction(SIGSYS, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+        }
+
+        void GAUncaughtExceptionHandler::formatAddress(const GACrashRecord& record, uint64_t address, char* out, size_t size)
+        {
+            for(uint32_t i = 0; i < record.moduleCount && i < static_cast<uint32_t>(GACrashRecord::MaxModules); ++i)
             {
-                sigaction(SIGSYS, &mySigAction, NULL);
+                const stacktrace::loaded_module& module = record.modules[i];
+                if(address >= module.begin && address < module.end)
+                {
+                    snprintf(out, size, "%.63s+0x%" PRIx64, module.name, static_cast<uint64_t>(address - module.base));
+                    return;
+                }
             }
-            sigaction(SIGPIPE, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+            snprintf(out, size, "0x%016" PRIx64, address);
+        }
+
+        void GAUncaughtExceptionHandler::crashMessage(const GACrashRecord& record, std::string& out)
+        {
+            // nothing that changes between runs, so the same crash gives the same message
+            char fingerprint[FingerprintSize];
+            crashFingerprint(record, fingerprint);
+            char line[128] = "";
+            char address[96] = "";
+            if(record.kind == CrashKindUncaughtException)
             {
-                sigaction(SIGPIPE, &mySigAction, NULL);
+                out = "Uncaught C++ Exception\n";
             }
-            sigaction(SIGALRM, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+            else
             {
-                sigaction(SIGALRM, &mySigAction, NULL);
+                snprintf(line, sizeof(line), "Uncaught Signal (%d)\n", record.signal);
+                out = line;
             }
-            sigaction(SIGXCPU, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+            snprintf(line, sizeof(line), "fingerprint %s\n", fingerprint);
+            out += line;
+            if(record.kind == CrashKindSignal)
             {
-                sigaction(SIGXCPU, &mySigAction, NULL);
+                snprintf(line, sizeof(line), "si_code     %d\n", record.code);
+                out += line;
             }
-            sigaction(SIGXFSZ, NULL, &prevSigAction);
-            if (prevSigAction.sa_handler != SIG_IGN)
+            out += "Stack trace:\n";
+            for(uint32_t i = 0; i < record.frameCount && i < static_cast<uint32_t>(GACrashRecord::MaxFrames); ++i)
             {
-                sigaction(SIGXFSZ, &mySigAction, NULL);
+                formatAddress(record, record.frames[i], address, sizeof(address));
+                snprintf(line, sizeof(line), "%4u - %s\n", i, address);
+                out += line;
             }
         }
 
-        /*    signalHandler
-         *
-         *        Set up the uncaught signals
-         */
-        void GAUncaughtExceptionHandler::signalHandler(int sig, siginfo_t *info, void *context)
+        void GAUncaughtExceptionHandler::crashFingerprint(const GACrashRecord& record, char* out)
         {
-            if(state::GAState::useErrorReporting())
-            {
-                void *frames[128];
-                int i,len = backtrace(frames, 128);
-                char **symbols = backtrace_symbols(frames,len);
-
-                /*
-                 *    Now format into a message for sending to the user
-                 */
-                size_t totalSize = 0;
-                totalSize += strlen("Uncaught Signal\n");
-                totalSize += formatSize("si_signo    %d\n", info->si_signo);
-                totalSize += formatSize("si_code     %d\n", info->si_code);
-                totalSize += formatSize("si_value    %d\n", info->si_value);
-                totalSize += formatSize("si_errno    %d\n", info->si_errno);
-                totalSize += formatSize("si_addr     0x%08lX\n", info->si_addr);
-                totalSize += formatSize("si_status   %d\n", info->si_status);
-                totalSize += strlen("Stack trace:\n");
-                for (i = 0; i < len; ++i)
-                {
-                    totalSize += formatSize("%4d - %s\n", i, symbols[i]);
-                }
+            // FNV-1a over the crash kind, the signal and module+offset of the top
+            // frames. Frames outside any known module only count by position.
+            char part[96] = "";
+            snprintf(part, sizeof(part), "%d:%d", record.kind, record.signal);
+            uint64_t hash = utilities::GAUtilities::fnv1a(part);
 
-                char buffer[totalSize + 1];
-                buffer[0] = 0;
-                strcat(buffer, "Uncaught Signal\n");
-
-                formatConcat(buffer, "si_signo    %d\n", info->si_signo);
-                formatConcat(buffer, "si_code     %d\n", info->si_code);
-                formatConcat(buffer, "si_value    %d\n", info->si_value);
-                formatConcat(buffer, "si_errno    %d\n", info->si_errno);
-                formatConcat(buffer, "si_addr     0x%08lX\n", info->si_addr);
-                formatConcat(buffer, "si_status   %d\n", info->si_status);
-                strcat(buffer, "Stack trace:\n");
-                for (i = 0; i < len; ++i)
+            for(uint32_t i = 0; i < record.frameCount && i < FingerprintFrames && i < static_cast<uint32_t>(GACrashRecord::MaxFrames); ++i)
+            {
+                formatAddress(record, record.frames[i], part, sizeof(part));
+                if(part[0] == '0' && part[1] == 'x')
                 {
-                    formatConcat(buffer, "%4d - %s\n", i, symbols[i]);
+                    snprintf(part, sizeof(part), "?");
                 }
+                hash = utilities::GAUtilities::fnv1a(utilities::GAUtilities::fnv1a(hash, "|"), part);
+            }
 
-                if(errorCount <= MAX_ERROR_TYPE_COUNT)
-                {
-                    errorCount = errorCount + 1;
-                    events::GAEvents::addErrorEvent(EGAErrorSeverity::Critical, buffer, {});
-                    events::GAEvents::processEvents("error", false);
-                }
+            snprintf(out, FingerprintSize, "%016" PRIx64, hash);
+        }
 
-                struct sigaction newact;
-                newact.sa_flags = 0;
-                sigemptyset(&newact.sa_mask);
-                newact.sa_handler= SIG_DFL;
+        void GAUncaughtExceptionHandler::writeCrashRecord(EGACrashKind kind, int sig, int code, const void* address, int skipFrames)
+        {
+            GACrashRecord* record = crashRecord;
+            if(!record || crashWritten.test_and_set())
+            {
+                return;
             }
 
-            if(*prevSigAction.sa_handler != NULL)
+            // this function's own frame is skipped too
+            void* frames[GACrashRecord::MaxFrames];
+            int skip = skipFrames + 1;
+#if defined(_WIN32)
+            int frameCount = CaptureStackBackTrace(0, GACrashRecord::MaxFrames, frames, NULL);
+#else
+            int frameCount = backtrace(frames, GACrashRecord::MaxFrames);
+#endif
+            if(skip > frameCount)
             {
-                (*prevSigAction.sa_handler)(sig);
+                skip = frameCount;
             }
+            for(int i = skip; i < frameCount; ++i)
+            {
+                record->frames[i - skip] = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(frames[i]));
+            }
+            record->frameCount = static_cast<uint32_t>(frameCount - skip);
+            record->kind = kind;
+            record->signal = sig;
+            record->code = code;
+            record->address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(address));
+            record->timestamp = static_cast<int64_t>(time(NULL));
+
+            // the record only counts once everything else is in place
+            std::atomic_thread_fence(std::memory_order_release);
+            record->magic = GACrashRecord::Magic;
         }
-#endif
-        void GAUncaughtExceptionHandler::formatConcat(char* buffer, const char* format, ...)
+
+#if defined(_WIN32)
+        void GAUncaughtExceptionHandler::signalHandler(int sig)
+        {
+            writeCrashRecord(CrashKindSignal, sig, 0, NULL, 1);
+
+            if(sig == SIGILL && old_state_ill != NULL)
+            {
+                old_state_ill(sig);
+            }
+            else if(sig == SIGABRT && old_state_abrt != NULL)
+            {
+                old_state_abrt(sig);
+            }
+            else if(sig == SIGFPE && old_state_fpe != NULL)
+            {
+                old_state_fpe(sig);
+            }
+            else if(sig == SIGSEGV && old_state_segv != NULL)
+            {
+                old_state_segv(sig);
+            }
+        }
+
+        void GAUncaughtExceptionHandler::setupUncaughtSignals()
+        {
+            old_state_ill = signal(SIGILL, signalHandler);
+            old_state_abrt = signal(SIGABRT, signalHandler);
+            old_state_fpe = signal(SIGFPE, signalHandler);
+            old_state_segv = signal(SIGSEGV, signalHandler);
+        }
+#else
+        void GAUncaughtExceptionHandler::installSignalHandler(int sig, struct sigaction& action)
         {
-            va_list args;
-            va_start (args, format);
-            size_t len = std::vsnprintf(NULL, 0, format, args);
-            va_end (args);
-            char* formatted = new char[len + 1];
-            va_start (args, format);
-            std::vsnprintf(formatted, len + 1, format, args);
-            va_end (args);
-            strcat(buffer, formatted);
-            delete[] formatted;
+            sigaction(sig, NULL, &prevSigActions[sig]);
+            if (prevSigActions[sig].sa_handler != SIG_IGN)
+            {
+                sigaction(sig, &action, NULL);
+            }
         }
 
-        size_t GAUncaughtExceptionHandler::formatSize(const char* format, ...)
+        bool GAUncaughtExceptionHandler::isFatalSignal(int sig)
         {
-            va_list args;
-            va_start (args, format);
-            size_t len = std::vsnprintf(NULL, 0, format, args);
-            va_end (args);
-            return len;
+            switch(sig)
+            {
+                case SIGILL:
+                case SIGTRAP:
+                case SIGABRT:
+                case SIGFPE:
+                case SIGBUS:
+                case SIGSEGV:
+                case SIGSYS:
+#if !USE_LINUX
+                case SIGEMT:
+#endif
+                    return true;
+                default:
+                    return false;
+            }
         }
 
-        /*    terminateHandler
+        void GAUncaughtExceptionHandler::setupUncaughtSignals()
+        {
+            struct sigaction mySigAction;
+            memset(&mySigAction, 0, sizeof(mySigAction));
+            mySigAction.sa_sigaction = signalHandler;
+            mySigAction.sa_flags = SA_SIGINFO;
+            sigemptyset(&mySigAction.sa_mask);
+
+            // only signals that mean a crash, the others keep their own handling
+            installSignalHandler(SIGILL, mySigAction);
+            installSignalHandler(SIGTRAP, mySigAction);
+            installSignalHandler(SIGABRT, mySigAction);
+#if !USE_LINUX
+            installSignalHandler(SIGEMT, mySigAction);
+#endif
+            installSignalHandler(SIGFPE, mySigAction);
+            installSignalHandler(SIGBUS, mySigAction);
+            installSignalHandler(SIGSEGV, mySigAction);
+            installSignalHandler(SIGSYS, mySigAction);
+        }
+
+        /*    signalHandler
          *
-         *        C++ exception terminate handler
+         *        Runs in the crashing context: only records the crash, nothing
+         *        is formatted, stored or sent until the next launch
          */
-        void GAUncaughtExceptionHandler::terminateHandler()
+        void GAUncaughtExceptionHandler::signalHandler(int sig, siginfo_t *info, void *context)
         {
-            if(state::GAState::useErrorReporting())
+            // a chained handler may forward other signals, they must not use up the one crash record
+            if(isFatalSignal(sig))
             {
-                /*
-                 *    Now format into a message for sending to the user
-                 */
+                // this handler and the kernel's signal trampoline
+                writeCrashRecord(CrashKindSignal, sig, info ? info->si_code : 0, info ? info->si_addr : NULL, 2);
+            }
 
-                if(errorCount <= MAX_ERROR_TYPE_COUNT)
+            struct sigaction& previous = prevSigActions[sig];
+            if(previous.sa_flags & SA_SIGINFO)
+            {
+                if(previous.sa_sigaction)
                 {
-                    stacktrace::call_stack st;
-                    size_t totalSize = 0;
-                    totalSize += strlen("Uncaught C++ Exception\n");
-                    totalSize += strlen("Stack trace:\n");
-                    totalSize += st.to_string_size() + strlen("\n");
-                    char* buffer = new char[totalSize + 1];
-
-                    strcat(buffer, "Uncaught C++ Exception\n");
-                    strcat(buffer, "Stack trace:\n");
-                    st.to_string(buffer);
-                    strcat(buffer, "\n");
-
-                    errorCount = errorCount + 1;
-                    events::GAEvents::addErrorEvent(EGAErrorSeverity::Critical, buffer, {});
-                    events::GAEvents::processEvents("error", false);
-                    delete[] buffer;
+                    previous.sa_sigaction(sig, info, context);
                 }
             }
+            else if(previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN)
+            {
+                previous.sa_handler(sig);
+            }
+            else if(isFatalSignal(sig))
+            {
+                // let the default action end the process once the handler returns
+                sigaction(sig, &previous, NULL);
+                raise(sig);
+            }
+        }
+#endif
+
+        /*    terminateHandler
+         *
+         *        C++ exception terminate handler
+         */
+        void GAUncaughtExceptionHandler::terminateHandler()
+        {
+            writeCrashRecord(CrashKindUncaughtException, 0, 0, NULL, 1);
 
             if(previousTerminateHandler != NULL)
             {
                 previousTerminateHandler();
             }
+            std::abort();
         }
 
         void GAUncaughtExceptionHandler::setUncaughtExceptionHandlers()
         {
-            if(state::GAState::useErrorReporting())
+            if(!state::GAState::useErrorReporting() || handlersInstalled)
             {
-                setupUncaughtSignals();
-                previousTerminateHandler = std::set_terminate(terminateHandler);
+                return;
             }
+
+            if(device::GADevice::getWritablePathStatus() > 0)
+            {
+                char path[513] = "";
+                snprintf(path, sizeof(path), "%s%sga_crash.bin", device::GADevice::getWritablePath(), utilities::GAUtilities::getPathSeparator());
+                if(!openCrashRecord(path))
+                {
+                    logging::GALogger::w("Could not open crash record file: %s", path);
+                }
+            }
+
+#if !defined(_WIN32)
+            // backtrace loads its unwinder on first use, which allocates
+            void* frames[1];
+            backtrace(frames, 1);
+#endif
+            handlersInstalled = true;
+            setupUncaughtSignals();
+            previousTerminateHandler = std::set_terminate(terminateHandler);
         }
     }
 }
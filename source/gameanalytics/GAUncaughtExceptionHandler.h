@@ -8,15 +8,79 @@
 #if !USE_UWP && !USE_TIZEN
 #include <exception>
 #include <signal.h>
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <stacktrace/call_stack.hpp>
+
+#if defined(_MSC_VER)
+#define GA_NOINLINE __declspec(noinline)
+#else
+#define GA_NOINLINE __attribute__((noinline))
+#endif
 
 namespace gameanalytics
 {
     namespace errorreporter
     {
+        // What the crash handlers leave behind for the next launch. It lives in
+        // a file mapped into memory when the handlers are installed, so a crash
+        // only has to fill in a few fields.
+        struct GACrashRecord
+        {
+            static const uint32_t Magic = 0x47414352;
+            static const uint32_t Version = 2;
+            static const int MaxFrames = 64;
+            static const int MaxModules = 128;
+
+            // Magic once a crash has been written, set last
+            uint32_t magic;
+            uint32_t version;
+            int32_t kind;
+            int32_t signal;
+            int32_t code;
+            int32_t sessionNum;
+            uint64_t address;
+            int64_t timestamp;
+            uint32_t frameCount;
+            uint32_t moduleCount;
+            uint64_t frames[MaxFrames];
+            char sessionId[65];
+            // taken when the record is opened and at every session start, a crash
+            // cannot walk the loader's lists safely
+            stacktrace::loaded_module modules[MaxModules];
+        };
+
+        enum EGACrashKind
+        {
+            CrashKindSignal = 0,
+            CrashKindUncaughtException = 1
+        };
+
         class GAUncaughtExceptionHandler
         {
         public:
             static void setUncaughtExceptionHandlers();
+
+            // maps the record file, a crash left in it by an earlier run stays
+            // in the file until reportPreviousCrash has stored it
+            static bool openCrashRecord(const char* path);
+            static void closeCrashRecord();
+            // the session a crash is reported against
+            static void setCrashSession(const char* sessionId, int sessionNum);
+            static bool hasPreviousCrash();
+            // Adds the previous run's crash as a critical error event, only the
+            // first crash with a given fingerprint is sent with its stack. Repeats
+            // are counted in ga_crashes and sent as one small event a day.
+            static void reportPreviousCrash();
+            // Stack frames as module+offset, symbolise them with tools/symbolicate.py
+            static void crashMessage(const GACrashRecord& record, std::string& out);
+            // same for the same crash site in the same build, whatever the load addresses
+            static void crashFingerprint(const GACrashRecord& record, char* out);
+            static const size_t FingerprintSize;
+            // only async-signal-safe calls, writes the first crash of the run
+            // without its own and the caller's skipFrames frames
+            GA_NOINLINE static void writeCrashRecord(EGACrashKind kind, int sig, int code, const void* address, int skipFrames);
         private:
 #if defined(_WIN32)
             static void signalHandler(int sig);
@@ -26,16 +90,29 @@ namespace gameanalytics
             static void (*old_state_segv) (int);
 #else
             static void signalHandler(int sig, siginfo_t *info, void *context);
-            static struct sigaction prevSigAction;
+            static void installSignalHandler(int sig, struct sigaction& action);
+            static bool isFatalSignal(int sig);
+            static struct sigaction prevSigActions[NSIG];
 #endif
-            static void formatConcat(char* buffer, const char* format, ...);
-            static size_t formatSize(const char* format, ...);
             static void setupUncaughtSignals();
             static void terminateHandler();
+            static void updateModules();
+            static void reportCrashRepeats();
+            static void clearPreviousCrash();
+            static void formatAddress(const GACrashRecord& record, uint64_t address, char* out, size_t size);
 
             static std::terminate_handler previousTerminateHandler;
-            static int errorCount;
-            static int MAX_ERROR_TYPE_COUNT;
+            static bool handlersInstalled;
+
+            static GACrashRecord* crashRecord;
+            static GACrashRecord* previousCrashRecord;
+            static std::atomic_flag crashWritten;
+            static GACrashRecord previousCrash;
+            static bool previousCrashFound;
+#if defined(_WIN32)
+            static void* crashRecordFile;
+            static void* crashRecordMapping;
+#endif
         };
     }
 }
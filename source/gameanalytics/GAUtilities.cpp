@@ -6,10 +6,13 @@
 //#include <climits>
 #include "GAUtilities.h"
 #include "GALogger.h"
+#include "GAGzipCompressor.h"
 #include <string.h>
 #include <stdio.h>
 #include <sstream>
 #include <chrono>
+#include <mutex>
+#include <string>
 #if USE_LINUX
 #include <regex.h>
 #include <iterator>
@@ -25,10 +28,6 @@
 #endif
 #include <cctype>
 
-// From crypto
-#define MINIZ_HEADER_FILE_ONLY
-#include "miniz.c"
-
 namespace gameanalytics
 {
     namespace utilities
@@ -39,102 +38,6 @@ namespace gameanalytics
         char GAUtilities::pathSeparator[2] = "/";
 #endif
 
-        // Compress a STL string using zlib with given compression level and return the binary data.
-        // Note: the zlib header is supressed
-        static std::vector<char> deflate_string(const char* str, int compressionlevel = Z_BEST_COMPRESSION)
-        {
-            // z_stream is zlib's control structure
-            z_stream zs;
-            memset(&zs, 0, sizeof(zs));
-
-            /* windowsize is negative to suppress Zlib header */
-            if (Z_OK != deflateInit2(&zs, compressionlevel, MZ_DEFLATED, -MZ_DEFAULT_WINDOW_BITS, 9, MZ_DEFAULT_STRATEGY))
-            {
-                throw(std::runtime_error("deflateInit failed while compressing."));
-            }
-
-            zs.next_in = (Bytef*)str;
-            //zs.next_in = reinterpret_cast<Bytef*>(str.data());
-
-            // set the z_stream's input
-            zs.avail_in = static_cast<unsigned int>(strlen(str));
-            int ret;
-            static char outbuffer[32768];
-            std::vector<char> outstring;
-
-            // retrieve the compressed bytes blockwise
-            do
-            {
-                zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-                zs.avail_out = sizeof(outbuffer);
-
-                ret = deflate(&zs, Z_FINISH);
-
-                if (outstring.size() < zs.total_out)
-                {
-                    size_t s = zs.total_out - outstring.size();
-                    // append the block to the output string
-                    for(size_t i = 0; i < s; ++i)
-                    {
-                        outstring.push_back(outbuffer[i]);
-                    }
-                }
-            } while (ret == Z_OK);
-
-            deflateEnd(&zs);
-
-            if (ret != Z_STREAM_END)
-            {
-                // an error occurred that was not EOF
-                logging::GALogger::e("Exception during zlib compression: (%d) %s", ret, zs.msg);
-                outstring.clear();
-            }
-
-            return outstring;
-        }
-
-        // TODO(nikolaj): explain template?
-        template <typename T>
-        T swap_endian(T u)
-        {
-            static_assert (CHAR_BIT == 8, "CHAR_BIT != 8");
-
-            union
-            {
-                T u;
-                unsigned char u8[sizeof(T)];
-            } source, dest;
-
-            source.u = u;
-
-            for (size_t k = 0; k < sizeof(T); k++)
-                dest.u8[k] = source.u8[sizeof(T) - k - 1];
-
-            return dest.u;
-        }
-
-        uint32 htonl2(uint32 v)
-        {
-            uint32 result = 0;
-            result |= (v & 0xFF000000) >> 24;
-            result |= (v & 0x00FF0000) >> 8;
-            result |= (v & 0x0000FF00) << 8;
-            result |= (v & 0x000000FF) << 24;
-
-            return result;
-        }
-
-        uint32 to_little_endian(uint32 v)
-        {
-            // convert to big endian
-            v = htonl2(v);
-
-            // and to little endian, because gzip wants it so.
-            v = swap_endian(v);
-
-            return v;
-        }
-
 #if !USE_UWP
         static char nb_base64_chars[] =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
@@ -210,52 +113,6 @@ namespace gameanalytics
             *buf++ = '\0';
         }
 #endif
-        // gzip compresses a string
-        static std::vector<char> compress_string_gzip(const char* str, int compressionlevel = Z_BEST_COMPRESSION)
-        {
-            // https://tools.ietf.org/html/rfc1952
-            std::vector<char> deflated = deflate_string(str, compressionlevel);
-
-            static const char gzip_header[10] =
-            { '\037', '\213', Z_DEFLATED, 0,
-                0, 0, 0, 0, /* mtime */
-                0, 0x03 /* Unix OS_CODE */
-            };
-
-            // Note: apparently, the crc is never validated on ther server side. So I'm not sure, if I have to convert it to little endian.
-            uint32_t crc = to_little_endian(crc32(0, (unsigned char*)str, strlen(str)));
-            uint32 size  = to_little_endian(static_cast<unsigned int>(strlen(str)));
-
-            size_t totalSize = sizeof(gzip_header);
-            totalSize += deflated.size();
-            totalSize += 8;
-            char* resultArray = new char[totalSize];
-            size_t current = 0;
-            for(size_t i = 0; i < sizeof(gzip_header); ++i)
-            {
-                resultArray[i] = gzip_header[i];
-            }
-            current += sizeof(gzip_header);
-            for(size_t i = 0; i < deflated.size(); ++i)
-            {
-                resultArray[i + current] = deflated[i];
-            }
-            current += deflated.size();
-            strncpy(resultArray + current, (const char*)&crc, 4);
-            current += 4;
-            strncpy(resultArray + current, (const char*)&size, 4);
-
-            std::vector<char> result;
-
-            for(size_t i = 0; i < totalSize; ++i)
-            {
-                result.push_back(resultArray[i]);
-            }
-            delete[] resultArray;
-
-            return result;
-        }
-
         const char* GAUtilities::getPathSeparator()
         {
             return pathSeparator;
@@ -308,24 +165,46 @@ namespace gameanalytics
             auto hashedJsonBase64 = CryptographicBuffer::EncodeToBase64String(hashedJsonBuffer);
             snprintf(out, 129, "%s", utilities::GAUtilities::ws2s(hashedJsonBase64->Data()).c_str());
 #else
-            unsigned char mac[SHA256_DIGEST_SIZE];
-            hmac_sha256_2(
-                (unsigned char*)key,
-                strlen(key),
-                (unsigned char*)data.data(),
-                data.size(),
-                mac,
-                SHA256_DIGEST_SIZE
-            );
-            int output_size = base64_needed_encoded_length(SHA256_DIGEST_SIZE);
-            unsigned char* ret = new unsigned char[output_size];
-            GAUtilities::base64_encode(mac, SHA256_DIGEST_SIZE, ret);
-
-            snprintf(out, output_size, "%s", ret);
-            delete[] ret;
+            hmac_sha256_ctx ctx;
+            hmacContextForKey(key, ctx);
+            hmac_sha256_update(&ctx, reinterpret_cast<const unsigned char*>(data.data()), static_cast<unsigned int>(data.size()));
+            hmacFinalBase64(ctx, out);
 #endif
         }
 
+#if !USE_UWP
+        // 32 byte MAC as base64 plus NUL
+        const size_t GAUtilities::HmacBase64Size = 45;
+
+        void GAUtilities::hmacContextForKey(const char* key, hmac_sha256_ctx& out)
+        {
+            // the game secret does not change while the game runs
+            static std::mutex mtx;
+            static std::string cachedKey;
+            static hmac_sha256_ctx cachedContext;
+            static bool cached = false;
+
+            std::lock_guard<std::mutex> lock(mtx);
+            if(!cached || cachedKey != key)
+            {
+                hmac_sha256_init2(&cachedContext, reinterpret_cast<const unsigned char*>(key), static_cast<unsigned int>(strlen(key)));
+                cachedKey = key;
+                cached = true;
+            }
+            out = cachedContext;
+        }
+
+        void GAUtilities::hmacFinalBase64(hmac_sha256_ctx& ctx, char* out)
+        {
+            unsigned char mac[SHA256_DIGEST_SIZE];
+            hmac_sha256_final(&ctx, mac, SHA256_DIGEST_SIZE);
+
+            unsigned char encoded[HmacBase64Size];
+            GAUtilities::base64_encode(mac, SHA256_DIGEST_SIZE, encoded);
+            snprintf(out, HmacBase64Size, "%s", encoded);
+        }
+#endif
+
         // TODO(nikolaj): explain function
         bool GAUtilities::stringMatch(const char* string, const char* pattern)
         {
@@ -362,7 +241,10 @@ namespace gameanalytics
 
         std::vector<char> GAUtilities::gzipCompress(const char* data)
         {
-            return compress_string_gzip(data);
+            GAGzipCompressor compressor;
+            std::vector<char> result;
+            compressor.compress(data, strlen(data), result);
+            return result;
         }
 
         // TODO(nikolaj): explain function
@@ -373,7 +255,7 @@ namespace gameanalytics
                 return false;
             }
 
-            for (CharArray entry : vector.getVector())
+            for (const CharArray& entry : vector.getVector())
             {
                 if(strcmp(entry.array, search) == 0)
                 {
@@ -416,6 +298,11 @@ namespace gameanalytics
         // TODO(nikolaj): explain function
         void GAUtilities::printJoinStringArray(const StringVector& v, const char* format, const char* delimiter)
         {
+            if(!GA_LOG_INFO_ENABLED())
+            {
+                return;
+            }
+
             size_t delimiterSize = strlen(delimiter);
             size_t vectorSize = v.getVector().size();
             size_t totalSize = (vectorSize - 1) * delimiterSize + 1;
@@ -436,7 +323,7 @@ namespace gameanalytics
                 }
             }
 
-            logging::GALogger::i(format, result);
+            GA_LOG_INFO(format, result);
             delete[] result;
         }
 
@@ -8,6 +8,9 @@
 #include <vector>
 #include "rapidjson/document.h"
 #include "GameAnalytics.h"
+#if !USE_UWP
+#include <hmac_sha2.h>
+#endif
 #if USE_UWP
 #include <string>
 #include <locale>
@@ -26,6 +29,14 @@ namespace gameanalytics
             static const char* getPathSeparator();
             static void generateUUID(char* out);
             static void hmacWithKey(const char* key, const std::vector<char>& data, char* out);
+#if !USE_UWP
+            // HMAC-SHA256 context already keyed with key. The keyed state is cached
+            // per key, so signing a request does not derive the pads again.
+            static void hmacContextForKey(const char* key, hmac_sha256_ctx& out);
+            // finishes ctx and writes the base64 MAC to out (at least HmacBase64Size)
+            static void hmacFinalBase64(hmac_sha256_ctx& ctx, char* out);
+            static const size_t HmacBase64Size;
+#endif
             static bool stringMatch(const char* string, const char* pattern);
             static std::vector<char> gzipCompress(const char* data);
 
@@ -37,6 +48,30 @@ namespace gameanalytics
             static int64_t timeIntervalSince1970();
             static void printJoinStringArray(const StringVector& v, const char* format, const char* delimiter = ", ");
             static void setJsonKeyValue(rapidjson::Document& json, const char* key, const rapidjson::Value& value);
+
+            // FNV-1a, pass a previous result as hash to continue it. Only
+            // arithmetic, so it can be used from a signal handler.
+            static const uint64_t Fnv1aOffsetBasis = 14695981039346656037ULL;
+            inline static uint64_t fnv1a(const char* s)
+            {
+                return fnv1a(Fnv1aOffsetBasis, s);
+            }
+            inline static uint64_t fnv1a(uint64_t hash, const char* s)
+            {
+                for(; *s; ++s)
+                {
+                    hash = (hash ^ static_cast<unsigned char>(*s)) * 1099511628211ULL;
+                }
+                return hash;
+            }
+            inline static uint64_t fnv1a(uint64_t hash, const char* data, size_t length)
+            {
+                for(size_t i = 0; i < length; ++i)
+                {
+                    hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+                }
+                return hash;
+            }
 #if !USE_UWP
             static int base64_needed_encoded_length(int length_of_data);
             static void base64_encode(const unsigned char * src, int src_len, unsigned char *buf_);
@@ -5,6 +5,7 @@
 
 #include "GAValidator.h"
 #include "GAUtilities.h"
+#include "GACharacterClass.h"
 #include "GAEvents.h"
 #include "GAState.h"
 #include "GALogger.h"
@@ -443,9 +444,9 @@ namespace gameanalytics
         // event params
         bool GAValidator::validateKeys(const char* gameKey, const char* gameSecret)
         {
-            if (utilities::GAUtilities::stringMatch(gameKey, "^[A-z0-9]{32}$"))
+            if (utilities::GACharacterClass::matchesClass(gameKey, utilities::KeyCharacter, 32, 32))
             {
-                if (utilities::GAUtilities::stringMatch(gameSecret, "^[A-z0-9]{40}$"))
+                if (utilities::GACharacterClass::matchesClass(gameSecret, utilities::KeyCharacter, 40, 40))
                 {
                     return true;
                 }
@@ -455,11 +456,7 @@ namespace gameanalytics
 
         bool GAValidator::validateCurrency(const char* currency)
         {
-            if (strlen(currency) == 0)
-            {
-                return false;
-            }
-            if (!utilities::GAUtilities::stringMatch(currency, "^[A-Z]{3}$"))
+            if (!utilities::GACharacterClass::matchesClass(currency, utilities::UppercaseCharacter, 3, 3))
             {
                 return false;
             }
@@ -488,7 +485,7 @@ namespace gameanalytics
 
         bool GAValidator::validateEventPartCharacters(const char* eventPart)
         {
-            if (!utilities::GAUtilities::stringMatch(eventPart, "^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}$"))
+            if (!utilities::GACharacterClass::matchesClass(eventPart, utilities::EventPartCharacter, 1, 64))
             {
                 return false;
             }
@@ -497,12 +494,7 @@ namespace gameanalytics
 
         bool GAValidator::validateEventIdLength(const char* eventId)
         {
-            if (strlen(eventId) == 0)
-            {
-                return false;
-            }
-
-            if (!utilities::GAUtilities::stringMatch(eventId, "^[^:]{1,64}(?::[^:]{1,64}){0,4}$"))
+            if (!utilities::GACharacterClass::matchesSegments(eventId, 0, 64, 5))
             {
                 return false;
             }
@@ -511,12 +503,7 @@ namespace gameanalytics
 
         bool GAValidator::validateEventIdCharacters(const char* eventId)
         {
-            if (strlen(eventId) == 0)
-            {
-                return false;
-            }
-
-            if (!utilities::GAUtilities::stringMatch(eventId, "^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}(:[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}){0,4}$"))
+            if (!utilities::GACharacterClass::matchesSegments(eventId, utilities::EventPartCharacter, 64, 5))
             {
                 return false;
             }
@@ -626,7 +613,7 @@ namespace gameanalytics
             // validate each string for regex
             for (CharArray resourceCurrency : resourceCurrencies.getVector())
             {
-                if (!utilities::GAUtilities::stringMatch(resourceCurrency.array, "^[A-Za-z]+$"))
+                if (!utilities::GACharacterClass::matchesClass(resourceCurrency.array, utilities::AlphaCharacter, 1, SIZE_MAX))
                 {
                     logging::GALogger::w("resource currencies validation failed: a resource currency can only be A-Z, a-z. String was: %s", resourceCurrency.array);
                     return false;
@@ -12,8 +12,12 @@
 #include "GAHTTPApi.h"
 #include "GAValidator.h"
 #include "GAEvents.h"
+#include "GAEventIdTable.h"
+#include "GAEventAggregator.h"
+#include "GAEventSampler.h"
 #include "GAUtilities.h"
 #include "GAStore.h"
+#include "GAMetrics.h"
 #if !USE_UWP && !USE_TIZEN
 #include "GAUncaughtExceptionHandler.h"
 #endif
@@ -208,7 +212,7 @@ namespace gameanalytics
             }
             if (!validators::GAValidator::validateBuild(build.data()))
             {
-                logging::GALogger::i("Validation fail - configure build: Cannot be null, empty or above 32 length. String: %s", build.data());
+                GA_LOG_INFO("Validation fail - configure build: Cannot be null, empty or above 32 length. String: %s", build.data());
                 return;
             }
             state::GAState::setBuild(build.data());
@@ -274,7 +278,7 @@ namespace gameanalytics
             }
             if (!validators::GAValidator::validateString(deviceModel.data(), true))
             {
-                logging::GALogger::i("Validation fail - configure device model: Cannot be null, empty or above 64 length. String: %s", deviceModel.data());
+                GA_LOG_INFO("Validation fail - configure device model: Cannot be null, empty or above 64 length. String: %s", deviceModel.data());
                 return;
             }
             device::GADevice::setDeviceModel(deviceModel.data());
@@ -299,7 +303,7 @@ namespace gameanalytics
             }
             if (!validators::GAValidator::validateString(deviceManufacturer.data(), true))
             {
-                logging::GALogger::i("Validation fail - configure device manufacturer: Cannot be null, empty or above 64 length. String: %s", deviceManufacturer.data());
+                GA_LOG_INFO("Validation fail - configure device manufacturer: Cannot be null, empty or above 64 length. String: %s", deviceManufacturer.data());
                 return;
             }
             device::GADevice::setDeviceManufacturer(deviceManufacturer.data());
@@ -323,7 +327,7 @@ namespace gameanalytics
             }
             if (!validators::GAValidator::validateSdkWrapperVersion(sdkGameEngineVersion.data()))
             {
-                logging::GALogger::i("Validation fail - configure sdk version: Sdk version not supported. String: %s", sdkGameEngineVersion.data());
+                GA_LOG_INFO("Validation fail - configure sdk version: Sdk version not supported. String: %s", sdkGameEngineVersion.data());
                 return;
             }
             device::GADevice::setSdkGameEngineVersion(sdkGameEngineVersion.data());
@@ -347,7 +351,7 @@ namespace gameanalytics
             }
             if (!validators::GAValidator::validateEngineVersion(gameEngineVersion.data()))
             {
-                logging::GALogger::i("Validation fail - configure engine: Engine version not supported. String: %s", gameEngineVersion.data());
+                GA_LOG_INFO("Validation fail - configure engine: Engine version not supported. String: %s", gameEngineVersion.data());
                 return;
             }
             device::GADevice::setGameEngineVersion(gameEngineVersion.data());
@@ -372,7 +376,7 @@ namespace gameanalytics
             }
             if (!validators::GAValidator::validateUserId(uId.data()))
             {
-                logging::GALogger::i("Validation fail - configure user_id: Cannot be null, empty or above 64 length. Will use default user_id method. Used string: %s", uId.data());
+                GA_LOG_INFO("Validation fail - configure user_id: Cannot be null, empty or above 64 length. Will use default user_id method. Used string: %s", uId.data());
                 return;
             }
 
@@ -414,6 +418,12 @@ namespace gameanalytics
                 return;
             }
 
+            if (!client::GAClientContext::claimGameKey(gameKey.data()))
+            {
+                logging::GALogger::w("SDK failed initialize. Game key %s is already used by another instance in this process.", gameKey.data());
+                return;
+            }
+
             state::GAState::setKeys(gameKey.data(), gameSecret.data());
 
             if (!store::GAStore::ensureDatabase(false, gameKey.data()))
@@ -435,7 +445,7 @@ namespace gameanalytics
         const char* itemId,
         const char* cartType)
     {
-        addBusinessEvent(currency, amount, itemType, itemId, cartType, "");
+        addBusinessEvent(currency, amount, itemType, itemId, cartType, EventFields());
     }
 
     void GameAnalytics::addBusinessEvent(
@@ -444,7 +454,7 @@ namespace gameanalytics
         const char* itemType_,
         const char* itemId_,
         const char* cartType_,
-        const char* fields_)
+        const EventFields& fields)
     {
         if(_endThread)
         {
@@ -459,8 +469,6 @@ namespace gameanalytics
         snprintf(itemId.data(), itemId.size(), "%s", itemId_ ? itemId_ : "");
         std::array<char, 65> cartType = {'\0'};
         snprintf(cartType.data(), cartType.size(), "%s", cartType_ ? cartType_ : "");
-        std::array<char, 65> fields = {'\0'};
-        snprintf(fields.data(), fields.size(), "%s", fields_ ? fields_ : "");
         threading::GAThreading::performTaskOnGAThread([currency, amount, itemType, itemId, cartType, fields]()
         {
             if (!isSdkReady(true, true, "Could not add business event"))
@@ -468,19 +476,17 @@ namespace gameanalytics
                 return;
             }
             // Send to events
-            rapidjson::Document fieldsJson;
-            fieldsJson.Parse(fields.data());
-            events::GAEvents::addBusinessEvent(currency.data(), amount, itemType.data(), itemId.data(), cartType.data(), fieldsJson);
+            events::GAEvents::addBusinessEvent(currency.data(), amount, itemType.data(), itemId.data(), cartType.data(), fields);
         });
     }
 
 
     void GameAnalytics::addResourceEvent(EGAResourceFlowType flowType, const char* currency, float amount, const char* itemType, const char* itemId)
     {
-        addResourceEvent(flowType, currency, amount, itemType, itemId, "");
+        addResourceEvent(flowType, currency, amount, itemType, itemId, EventFields());
     }
 
-    void GameAnalytics::addResourceEvent(EGAResourceFlowType flowType, const char* currency_, float amount, const char* itemType_, const char* itemId_, const char* fields_)
+    void GameAnalytics::addResourceEvent(EGAResourceFlowType flowType, const char* currency_, float amount, const char* itemType_, const char* itemId_, const EventFields& fields)
     {
         if(_endThread)
         {
@@ -493,8 +499,6 @@ namespace gameanalytics
         snprintf(itemType.data(), itemType.size(), "%s", itemType_ ? itemType_ : "");
         std::array<char, 65> itemId = {'\0'};
         snprintf(itemId.data(), itemId.size(), "%s", itemId_ ? itemId_ : "");
-        std::array<char, 65> fields = {'\0'};
-        snprintf(fields.data(), fields.size(), "%s", fields_ ? fields_ : "");
         threading::GAThreading::performTaskOnGAThread([flowType, currency, amount, itemType, itemId, fields]()
         {
             if (!isSdkReady(true, true, "Could not add resource event"))
@@ -502,18 +506,16 @@ namespace gameanalytics
                 return;
             }
 
-            rapidjson::Document fieldsJson;
-            fieldsJson.Parse(fields.data());
-            events::GAEvents::addResourceEvent(flowType, currency.data(), amount, itemType.data(), itemId.data(), fieldsJson);
+            events::GAEvents::addResourceEvent(flowType, currency.data(), amount, itemType.data(), itemId.data(), fields);
         });
     }
 
     void GameAnalytics::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03)
     {
-        addProgressionEvent(progressionStatus, progression01, progression02, progression03, "");
+        addProgressionEvent(progressionStatus, progression01, progression02, progression03, EventFields());
     }
 
-    void GameAnalytics::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01_, const char* progression02_, const char* progression03_, const char* fields_)
+    void GameAnalytics::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01_, const char* progression02_, const char* progression03_, const EventFields& fields)
     {
         if(_endThread)
         {
@@ -526,8 +528,6 @@ namespace gameanalytics
         snprintf(progression02.data(), progression02.size(), "%s", progression02_ ? progression02_ : "");
         std::array<char, 65> progression03 = {'\0'};
         snprintf(progression03.data(), progression03.size(), "%s", progression03_ ? progression03_ : "");
-        std::array<char, 65> fields = {'\0'};
-        snprintf(fields.data(), fields.size(), "%s", fields_);
         threading::GAThreading::performTaskOnGAThread([progressionStatus, progression01, progression02, progression03, fields]()
         {
             if (!isSdkReady(true, true, "Could not add progression event"))
@@ -536,18 +536,16 @@ namespace gameanalytics
             }
 
             // Send to events
-            rapidjson::Document fieldsJson;
-            fieldsJson.Parse(fields.data());
-            events::GAEvents::addProgressionEvent(progressionStatus, progression01.data(), progression02.data(), progression03.data(), 0, false, fieldsJson);
+            events::GAEvents::addProgressionEvent(progressionStatus, progression01.data(), progression02.data(), progression03.data(), 0, false, fields);
         });
     }
 
     void GameAnalytics::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score)
     {
-        addProgressionEvent(progressionStatus, progression01, progression02, progression03, score, "");
+        addProgressionEvent(progressionStatus, progression01, progression02, progression03, score, EventFields());
     }
 
-    void GameAnalytics::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01_, const char* progression02_, const char* progression03_, int score, const char* fields_)
+    void GameAnalytics::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01_, const char* progression02_, const char* progression03_, int score, const EventFields& fields)
     {
         if(_endThread)
         {
@@ -560,8 +558,6 @@ namespace gameanalytics
         snprintf(progression02.data(), progression02.size(), "%s", progression02_ ? progression02_ : "");
         std::array<char, 65> progression03 = {'\0'};
         snprintf(progression03.data(), progression03.size(), "%s", progression03_ ? progression03_ : "");
-        std::array<char, 65> fields = {'\0'};
-        snprintf(fields.data(), fields.size(), "%s", fields_ ? fields_ : "");
         threading::GAThreading::performTaskOnGAThread([progressionStatus, progression01, progression02, progression03, score, fields]()
         {
             if (!isSdkReady(true, true, "Could not add progression event"))
@@ -570,18 +566,16 @@ namespace gameanalytics
             }
 
             // Send to events
-            rapidjson::Document fieldsJson;
-            fieldsJson.Parse(fields.data());
-            events::GAEvents::addProgressionEvent(progressionStatus, progression01.data(), progression02.data(), progression03.data(), score, true, fieldsJson);
+            events::GAEvents::addProgressionEvent(progressionStatus, progression01.data(), progression02.data(), progression03.data(), score, true, fields);
         });
     }
 
     void GameAnalytics::addDesignEvent(const char* eventId)
     {
-        addDesignEvent(eventId, "");
+        addDesignEvent(eventId, EventFields());
     }
 
-    void GameAnalytics::addDesignEvent(const char* eventId_, const char* fields_)
+    void GameAnalytics::addDesignEvent(const char* eventId_, const EventFields& fields)
     {
         if(_endThread)
         {
@@ -590,26 +584,22 @@ namespace gameanalytics
 
         std::array<char, 400> eventId = {'\0'};
         snprintf(eventId.data(), eventId.size(), "%s", eventId_ ? eventId_ : "");
-        std::array<char, 65> fields = {'\0'};
-        snprintf(fields.data(), fields.size(), "%s", fields_ ? fields_ : "");
         threading::GAThreading::performTaskOnGAThread([eventId, fields]()
         {
             if (!isSdkReady(true, true, "Could not add design event"))
             {
                 return;
             }
-            rapidjson::Document fieldsJson;
-            fieldsJson.Parse(fields.data());
-            events::GAEvents::addDesignEvent(eventId.data(), 0, false, fieldsJson);
+            events::GAEvents::addDesignEvent(eventId.data(), 0, false, fields);
         });
     }
 
     void GameAnalytics::addDesignEvent(const char* eventId, double value)
     {
-        addDesignEvent(eventId, value, "");
+        addDesignEvent(eventId, value, EventFields());
     }
 
-    void GameAnalytics::addDesignEvent(const char* eventId_, double value, const char* fields_)
+    void GameAnalytics::addDesignEvent(const char* eventId_, double value, const EventFields& fields)
     {
         if(_endThread)
         {
@@ -618,26 +608,176 @@ namespace gameanalytics
 
         std::array<char, 400> eventId = {'\0'};
         snprintf(eventId.data(), eventId.size(), "%s", eventId_ ? eventId_ : "");
-        std::array<char, 65> fields = {'\0'};
-        snprintf(fields.data(), fields.size(), "%s", fields_ ? fields_ : "");
         threading::GAThreading::performTaskOnGAThread([eventId, value, fields]()
         {
             if (!isSdkReady(true, true, "Could not add design event"))
             {
                 return;
             }
-            rapidjson::Document fieldsJson;
-            fieldsJson.Parse(fields.data());
-            events::GAEvents::addDesignEvent(eventId.data(), value, true, fieldsJson);
+            events::GAEvents::addDesignEvent(eventId.data(), value, true, fields);
+        });
+    }
+
+    EventIdHandle GameAnalytics::registerDesignEventId(const char* eventId)
+    {
+        EventIdHandle handle;
+        events::GAEventIdEntry entry;
+        uint32_t id = events::GAEventIdTable::internDesignEventId(eventId);
+        if(id != 0 && events::GAEventIdTable::getEntry(id, entry) && entry.valid)
+        {
+            handle.id = id;
+            return handle;
+        }
+
+        // logs why the event id was rejected
+        validators::ValidationResult validationResult;
+        validators::GAValidator::validateDesignEvent(eventId ? eventId : "", validationResult);
+        if(validationResult.result)
+        {
+            logging::GALogger::w("Could not register design event id, too many event ids registered: %s", eventId);
+        }
+        return handle;
+    }
+
+    EventIdHandle GameAnalytics::registerProgressionEventId(const char* progression01, const char* progression02, const char* progression03)
+    {
+        EventIdHandle handle;
+        events::GAEventIdEntry entry;
+        uint32_t id = events::GAEventIdTable::internProgression(progression01, progression02, progression03);
+        if(id != 0 && events::GAEventIdTable::getEntry(id, entry) && entry.valid)
+        {
+            handle.id = id;
+            return handle;
+        }
+
+        // logs why the progression was rejected
+        validators::ValidationResult validationResult;
+        validators::GAValidator::validateProgressionEvent(EGAProgressionStatus::Start, progression01 ? progression01 : "", progression02 ? progression02 : "", progression03 ? progression03 : "", validationResult);
+        if(validationResult.result)
+        {
+            logging::GALogger::w("Could not register progression, too many event ids registered: %s", progression01);
+        }
+        return handle;
+    }
+
+    void GameAnalytics::addProgressionEvent(EGAProgressionStatus progressionStatus, EventIdHandle progression)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([progressionStatus, progression]()
+        {
+            if (!isSdkReady(true, true, "Could not add progression event"))
+            {
+                return;
+            }
+
+            events::GAEvents::addProgressionEvent(progressionStatus, progression.id, 0, false, EventFields());
+        });
+    }
+
+    void GameAnalytics::addProgressionEvent(EGAProgressionStatus progressionStatus, EventIdHandle progression, int score)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([progressionStatus, progression, score]()
+        {
+            if (!isSdkReady(true, true, "Could not add progression event"))
+            {
+                return;
+            }
+
+            events::GAEvents::addProgressionEvent(progressionStatus, progression.id, score, true, EventFields());
+        });
+    }
+
+    void GameAnalytics::addDesignEvent(EventIdHandle eventId)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([eventId]()
+        {
+            if (!isSdkReady(true, true, "Could not add design event"))
+            {
+                return;
+            }
+
+            events::GAEvents::addDesignEvent(eventId.id, 0, false, EventFields());
+        });
+    }
+
+    void GameAnalytics::addDesignEvent(EventIdHandle eventId, double value)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([eventId, value]()
+        {
+            if (!isSdkReady(true, true, "Could not add design event"))
+            {
+                return;
+            }
+
+            events::GAEvents::addDesignEvent(eventId.id, value, true, EventFields());
+        });
+    }
+
+    void GameAnalytics::setDesignEventAggregation(const char* eventId_, int windowSeconds, const std::vector<double>& histogramBounds)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        std::array<char, 400> eventId = {'\0'};
+        snprintf(eventId.data(), eventId.size(), "%s", eventId_ ? eventId_ : "");
+        threading::GAThreading::performTaskOnGAThread([eventId, windowSeconds, histogramBounds]()
+        {
+            if (!validators::GAValidator::validateEventIdLength(eventId.data()) || !validators::GAValidator::validateEventIdCharacters(eventId.data()))
+            {
+                logging::GALogger::w("Could not set design event aggregation: invalid event id '%s'", eventId.data());
+                return;
+            }
+            if (!events::GAEventAggregator::configure(eventId.data(), windowSeconds, histogramBounds))
+            {
+                logging::GALogger::w("Could not set design event aggregation for '%s': window must be 1-%d seconds and at most %d ascending histogram bounds are allowed", eventId.data(), static_cast<int>(events::GAEventAggregator::MaxWindowSeconds), static_cast<int>(events::GAEventAggregator::MaxHistogramBounds));
+                return;
+            }
+            GA_LOG_INFO("Design events with id '%s' are aggregated over %d seconds", eventId.data(), windowSeconds);
+        });
+    }
+
+    void GameAnalytics::removeDesignEventAggregation(const char* eventId_)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        std::array<char, 400> eventId = {'\0'};
+        snprintf(eventId.data(), eventId.size(), "%s", eventId_ ? eventId_ : "");
+        threading::GAThreading::performTaskOnGAThread([eventId]()
+        {
+            events::GAEvents::removeDesignEventAggregation(eventId.data());
         });
     }
 
     void GameAnalytics::addErrorEvent(EGAErrorSeverity severity, const char* message)
     {
-        addErrorEvent(severity, message, "");
+        addErrorEvent(severity, message, EventFields());
     }
 
-    void GameAnalytics::addErrorEvent(EGAErrorSeverity severity, const char* message_, const char* fields_)
+    void GameAnalytics::addErrorEvent(EGAErrorSeverity severity, const char* message_, const EventFields& fields)
     {
         if(_endThread)
         {
@@ -646,20 +786,71 @@ namespace gameanalytics
 
         std::array<char, 8200> message = {'\0'};
         snprintf(message.data(), message.size(), "%s", message_ ? message_ : "");
-        std::array<char, 65> fields = {'\0'};
-        snprintf(fields.data(), fields.size(), "%s", fields_ ? fields_ : "");
         threading::GAThreading::performTaskOnGAThread([severity, message, fields]()
         {
             if (!isSdkReady(true, true, "Could not add error event"))
             {
                 return;
             }
-            rapidjson::Document fieldsJson;
-            fieldsJson.Parse(fields.data());
-            events::GAEvents::addErrorEvent(severity, message.data(), fieldsJson);
+            events::GAEvents::addErrorEvent(severity, message.data(), fields);
         });
     }
 
+    // JSON custom fields used by the wrappers, parsed on the calling thread
+    static EventFields parseCustomFields(const char* fields)
+    {
+        EventFields result;
+        if(fields && fields[0] != '\0')
+        {
+            rapidjson::Document fieldsJson;
+            fieldsJson.Parse(fields);
+            if(fieldsJson.HasParseError())
+            {
+                logging::GALogger::w("Custom fields could not be parsed as JSON and have been omitted");
+            }
+            else
+            {
+                state::GAState::validateAndCleanCustomFields(fieldsJson, result);
+            }
+        }
+        return result;
+    }
+
+    void GameAnalytics::addBusinessEvent(const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType, const char* fields)
+    {
+        addBusinessEvent(currency, amount, itemType, itemId, cartType, parseCustomFields(fields));
+    }
+
+    void GameAnalytics::addResourceEvent(EGAResourceFlowType flowType, const char* currency, float amount, const char* itemType, const char* itemId, const char* fields)
+    {
+        addResourceEvent(flowType, currency, amount, itemType, itemId, parseCustomFields(fields));
+    }
+
+    void GameAnalytics::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, const char* fields)
+    {
+        addProgressionEvent(progressionStatus, progression01, progression02, progression03, parseCustomFields(fields));
+    }
+
+    void GameAnalytics::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, const char* fields)
+    {
+        addProgressionEvent(progressionStatus, progression01, progression02, progression03, score, parseCustomFields(fields));
+    }
+
+    void GameAnalytics::addDesignEvent(const char* eventId, const char* fields)
+    {
+        addDesignEvent(eventId, parseCustomFields(fields));
+    }
+
+    void GameAnalytics::addDesignEvent(const char* eventId, double value, const char* fields)
+    {
+        addDesignEvent(eventId, value, parseCustomFields(fields));
+    }
+
+    void GameAnalytics::addErrorEvent(EGAErrorSeverity severity, const char* message, const char* fields)
+    {
+        addErrorEvent(severity, message, parseCustomFields(fields));
+    }
+
     // ------------- SET STATE CHANGES WHILE RUNNING ----------------- //
 
     void GameAnalytics::setEnabledInfoLog(bool flag)
@@ -674,11 +865,11 @@ namespace gameanalytics
             if (flag)
             {
                 logging::GALogger::setInfoLog(flag);
-                logging::GALogger::i("Info logging enabled");
+                GA_LOG_INFO("Info logging enabled");
             }
             else
             {
-                logging::GALogger::i("Info logging disabled");
+                GA_LOG_INFO("Info logging disabled");
                 logging::GALogger::setInfoLog(flag);
             }
         });
@@ -696,16 +887,80 @@ namespace gameanalytics
             if (flag)
             {
                 logging::GALogger::setVerboseInfoLog(flag);
-                logging::GALogger::i("Verbose logging enabled");
+                GA_LOG_INFO("Verbose logging enabled");
             }
             else
             {
-                logging::GALogger::i("Verbose logging disabled");
+                GA_LOG_INFO("Verbose logging disabled");
                 logging::GALogger::setVerboseInfoLog(flag);
             }
         });
     }
 
+    void GameAnalytics::configureEventBatchConcurrency(int maxInFlightBatches)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([maxInFlightBatches]()
+        {
+            events::GAEvents::setMaxInFlightBatches(maxInFlightBatches);
+        });
+    }
+
+    void GameAnalytics::configureEventCompression(int level, EGACompressionStrategy strategy)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([level, strategy]()
+        {
+#if !USE_UWP
+            http::GAHTTPApi* http = http::GAHTTPApi::getInstance();
+            if(http)
+            {
+                http->configureCompression(level, strategy);
+            }
+#endif
+        });
+    }
+
+    void GameAnalytics::configureLogRotation(long maxFileSize, int maxFiles)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([maxFileSize, maxFiles]()
+        {
+            logging::GALogger::setLogRotation(maxFileSize, maxFiles);
+        });
+    }
+
+    void GameAnalytics::configureTransport(const std::shared_ptr<ITransport>& transport)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+#if USE_UWP
+        logging::GALogger::w("configureTransport is not supported on UWP");
+#else
+        // set right away so the init request already uses it
+        http::GAHTTPApi* http = http::GAHTTPApi::getInstance();
+        if(http)
+        {
+            http->setTransport(transport);
+        }
+#endif
+    }
+
     void GameAnalytics::setEnabledManualSessionHandling(bool flag)
     {
         if(_endThread)
@@ -744,16 +999,52 @@ namespace gameanalytics
             if (flag)
             {
                 state::GAState::setEnabledEventSubmission(flag);
-                logging::GALogger::i("Event submission enabled");
+                GA_LOG_INFO("Event submission enabled");
             }
             else
             {
-                logging::GALogger::i("Event submission disabled");
+                GA_LOG_INFO("Event submission disabled");
                 state::GAState::setEnabledEventSubmission(flag);
             }
         });
     }
 
+    void GameAnalytics::setEventSampling(const char* category_, const char* eventIdPrefix_, double rate, EGASamplingKey key)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        std::array<char, 65> category = {'\0'};
+        snprintf(category.data(), category.size(), "%s", category_ ? category_ : "");
+        std::array<char, 400> eventIdPrefix = {'\0'};
+        snprintf(eventIdPrefix.data(), eventIdPrefix.size(), "%s", eventIdPrefix_ ? eventIdPrefix_ : "");
+        threading::GAThreading::performTaskOnGAThread([category, eventIdPrefix, rate, key]()
+        {
+            if (!events::GAEventSampler::setRule(category.data(), eventIdPrefix.data(), rate, key))
+            {
+                logging::GALogger::w("Could not set event sampling: category must be design, business, progression, resource or error and rate between 0 and 1");
+                return;
+            }
+            GA_LOG_INFO("Event sampling: keeping %f of %s events with prefix '%s'", rate, category.data(), eventIdPrefix.data());
+        });
+    }
+
+    void GameAnalytics::clearEventSampling()
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([]()
+        {
+            events::GAEventSampler::clearRules();
+            GA_LOG_INFO("Event sampling rules cleared");
+        });
+    }
+
     void GameAnalytics::setCustomDimension01(const char* dimension_)
     {
         if(_endThread)
@@ -824,6 +1115,58 @@ namespace gameanalytics
         return state::GAState::getRemoteConfigsStringValue(key, defaultValue);
     }
 
+    const char* GameAnalytics::getRemoteConfigsValue(const char* key, const char* defaultValue)
+    {
+        return state::GAState::getRemoteConfigsValue(key, defaultValue);
+    }
+
+    RemoteConfigKey GameAnalytics::registerRemoteConfigKey(const char* key)
+    {
+        return state::GAState::registerRemoteConfigKey(key);
+    }
+
+    const char* GameAnalytics::getRemoteConfigsValue(RemoteConfigKey key, const char* defaultValue)
+    {
+        const state::GARemoteConfigsSnapshot::Value* value = state::GAState::getRemoteConfig(key);
+        return value ? value->string : (defaultValue ? defaultValue : "");
+    }
+
+    int64_t GameAnalytics::getRemoteConfigInt(const char* key, int64_t defaultValue)
+    {
+        const state::GARemoteConfigsSnapshot::Value* value = state::GAState::getRemoteConfig(key);
+        return value && value->isInteger ? value->integer : defaultValue;
+    }
+
+    int64_t GameAnalytics::getRemoteConfigInt(RemoteConfigKey key, int64_t defaultValue)
+    {
+        const state::GARemoteConfigsSnapshot::Value* value = state::GAState::getRemoteConfig(key);
+        return value && value->isInteger ? value->integer : defaultValue;
+    }
+
+    double GameAnalytics::getRemoteConfigDouble(const char* key, double defaultValue)
+    {
+        const state::GARemoteConfigsSnapshot::Value* value = state::GAState::getRemoteConfig(key);
+        return value && value->isNumber ? value->number : defaultValue;
+    }
+
+    double GameAnalytics::getRemoteConfigDouble(RemoteConfigKey key, double defaultValue)
+    {
+        const state::GARemoteConfigsSnapshot::Value* value = state::GAState::getRemoteConfig(key);
+        return value && value->isNumber ? value->number : defaultValue;
+    }
+
+    bool GameAnalytics::getRemoteConfigBool(const char* key, bool defaultValue)
+    {
+        const state::GARemoteConfigsSnapshot::Value* value = state::GAState::getRemoteConfig(key);
+        return value && value->isBool ? value->boolean : defaultValue;
+    }
+
+    bool GameAnalytics::getRemoteConfigBool(RemoteConfigKey key, bool defaultValue)
+    {
+        const state::GARemoteConfigsSnapshot::Value* value = state::GAState::getRemoteConfig(key);
+        return value && value->isBool ? value->boolean : defaultValue;
+    }
+
     bool GameAnalytics::isRemoteConfigsReady()
     {
         return state::GAState::isRemoteConfigsReady();
@@ -844,6 +1187,21 @@ namespace gameanalytics
         return state::GAState::getRemoteConfigsContentAsString();
     }
 
+    EGACircuitState GameAnalytics::getCollectorCircuitState()
+    {
+        return events::GAEvents::getCircuitState();
+    }
+
+    GAMetricsSnapshot GameAnalytics::getMetrics()
+    {
+        return metrics::GAMetrics::snapshot();
+    }
+
+    void GameAnalytics::configureMetricsExport(double intervalSeconds, const GAMetricsCallback& callback)
+    {
+        metrics::GAMetrics::setExport(intervalSeconds, callback);
+    }
+
     std::vector<char> GameAnalytics::getABTestingId()
     {
         return state::GAState::getAbId();
@@ -888,6 +1246,333 @@ namespace gameanalytics
         }
     }
 
+    // -------------- PLAYER SESSIONS --------------- //
+
+    // the player's state on the GA thread, null after the session ended or was evicted
+    static std::shared_ptr<state::GAPlayerContext> findPlayer(const std::string& userId, const char* message)
+    {
+        std::shared_ptr<state::GAPlayerContext> player = state::GAState::getPlayer(userId.c_str());
+        if(!player)
+        {
+            logging::GALogger::w("%s: no session for player %s", message, userId.c_str());
+        }
+        return player;
+    }
+
+    void GameAnalytics::configureMaxPlayerSessions(int maxPlayers)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([maxPlayers]()
+        {
+            if(maxPlayers < 1)
+            {
+                logging::GALogger::w("Validation fail - max player sessions must be at least 1: %d", maxPlayers);
+                return;
+            }
+            state::GAState::setMaxPlayers(maxPlayers);
+        });
+    }
+
+    PlayerContext GameAnalytics::startPlayerSession(const char* userId)
+    {
+        return startPlayerSession(userId, 0, 0);
+    }
+
+    PlayerContext GameAnalytics::startPlayerSession(const char* userId_, int sessionNum, int transactionNum)
+    {
+        PlayerContext player;
+        if(_endThread)
+        {
+            return player;
+        }
+
+        std::array<char, 129> userId = {'\0'};
+        snprintf(userId.data(), userId.size(), "%s", userId_ ? userId_ : "");
+        if (!validators::GAValidator::validateUserId(userId.data()))
+        {
+            logging::GALogger::w("Could not start player session: invalid user id");
+            return player;
+        }
+
+        player._userId = userId.data();
+        threading::GAThreading::performTaskOnGAThread([userId, sessionNum, transactionNum]()
+        {
+            if (!isSdkReady(true, true, "Could not start player session"))
+            {
+                return;
+            }
+            state::GAState::startPlayerSession(userId.data(), sessionNum, transactionNum);
+        });
+        return player;
+    }
+
+    void GameAnalytics::endPlayerSession(const PlayerContext& player)
+    {
+        if(_endThread || !player.isValid())
+        {
+            return;
+        }
+
+        std::string userId = player._userId;
+        threading::GAThreading::performTaskOnGAThread([userId]()
+        {
+            if (!isSdkReady(true, true, "Could not end player session"))
+            {
+                return;
+            }
+            state::GAState::endPlayerSession(userId.c_str());
+        });
+    }
+
+    void GameAnalytics::setCustomDimension01(const PlayerContext& player, const char* dimension_)
+    {
+        if(_endThread || !player.isValid())
+        {
+            return;
+        }
+
+        std::string userId = player._userId;
+        std::array<char, 65> dimension = {'\0'};
+        snprintf(dimension.data(), dimension.size(), "%s", dimension_ ? dimension_ : "");
+        threading::GAThreading::performTaskOnGAThread([userId, dimension]()
+        {
+            if (!validators::GAValidator::validateDimension01(dimension.data()))
+            {
+                logging::GALogger::w("Could not set custom01 dimension value to '%s'. Value not found in available custom01 dimension values", dimension.data());
+                return;
+            }
+            std::shared_ptr<state::GAPlayerContext> context = findPlayer(userId, "Could not set custom01 dimension");
+            if(!context)
+            {
+                return;
+            }
+            state::GAPlayerScope scope(context.get());
+            state::GAState::setCustomDimension01(dimension.data());
+        });
+    }
+
+    void GameAnalytics::setCustomDimension02(const PlayerContext& player, const char* dimension_)
+    {
+        if(_endThread || !player.isValid())
+        {
+            return;
+        }
+
+        std::string userId = player._userId;
+        std::array<char, 65> dimension = {'\0'};
+        snprintf(dimension.data(), dimension.size(), "%s", dimension_ ? dimension_ : "");
+        threading::GAThreading::performTaskOnGAThread([userId, dimension]()
+        {
+            if (!validators::GAValidator::validateDimension02(dimension.data()))
+            {
+                logging::GALogger::w("Could not set custom02 dimension value to '%s'. Value not found in available custom02 dimension values", dimension.data());
+                return;
+            }
+            std::shared_ptr<state::GAPlayerContext> context = findPlayer(userId, "Could not set custom02 dimension");
+            if(!context)
+            {
+                return;
+            }
+            state::GAPlayerScope scope(context.get());
+            state::GAState::setCustomDimension02(dimension.data());
+        });
+    }
+
+    void GameAnalytics::setCustomDimension03(const PlayerContext& player, const char* dimension_)
+    {
+        if(_endThread || !player.isValid())
+        {
+            return;
+        }
+
+        std::string userId = player._userId;
+        std::array<char, 65> dimension = {'\0'};
+        snprintf(dimension.data(), dimension.size(), "%s", dimension_ ? dimension_ : "");
+        threading::GAThreading::performTaskOnGAThread([userId, dimension]()
+        {
+            if (!validators::GAValidator::validateDimension03(dimension.data()))
+            {
+                logging::GALogger::w("Could not set custom03 dimension value to '%s'. Value not found in available custom03 dimension values", dimension.data());
+                return;
+            }
+            std::shared_ptr<state::GAPlayerContext> context = findPlayer(userId, "Could not set custom03 dimension");
+            if(!context)
+            {
+                return;
+            }
+            state::GAPlayerScope scope(context.get());
+            state::GAState::setCustomDimension03(dimension.data());
+        });
+    }
+
+    void GameAnalytics::addBusinessEvent(const PlayerContext& player, const char* currency_, int amount, const char* itemType_, const char* itemId_, const char* cartType_, const EventFields& fields)
+    {
+        if(_endThread || !player.isValid())
+        {
+            return;
+        }
+
+        std::string userId = player._userId;
+        std::array<char, 65> currency = {'\0'};
+        snprintf(currency.data(), currency.size(), "%s", currency_ ? currency_ : "");
+        std::array<char, 65> itemType = {'\0'};
+        snprintf(itemType.data(), itemType.size(), "%s", itemType_ ? itemType_ : "");
+        std::array<char, 65> itemId = {'\0'};
+        snprintf(itemId.data(), itemId.size(), "%s", itemId_ ? itemId_ : "");
+        std::array<char, 65> cartType = {'\0'};
+        snprintf(cartType.data(), cartType.size(), "%s", cartType_ ? cartType_ : "");
+        threading::GAThreading::performTaskOnGAThread([userId, currency, amount, itemType, itemId, cartType, fields]()
+        {
+            if (!isSdkReady(true, true, "Could not add business event"))
+            {
+                return;
+            }
+            std::shared_ptr<state::GAPlayerContext> context = findPlayer(userId, "Could not add business event");
+            if(!context)
+            {
+                return;
+            }
+            state::GAPlayerScope scope(context.get());
+            events::GAEvents::addBusinessEvent(currency.data(), amount, itemType.data(), itemId.data(), cartType.data(), fields);
+        });
+    }
+
+    void GameAnalytics::addResourceEvent(const PlayerContext& player, EGAResourceFlowType flowType, const char* currency_, float amount, const char* itemType_, const char* itemId_, const EventFields& fields)
+    {
+        if(_endThread || !player.isValid())
+        {
+            return;
+        }
+
+        std::string userId = player._userId;
+        std::array<char, 65> currency = {'\0'};
+        snprintf(currency.data(), currency.size(), "%s", currency_ ? currency_ : "");
+        std::array<char, 65> itemType = {'\0'};
+        snprintf(itemType.data(), itemType.size(), "%s", itemType_ ? itemType_ : "");
+        std::array<char, 65> itemId = {'\0'};
+        snprintf(itemId.data(), itemId.size(), "%s", itemId_ ? itemId_ : "");
+        threading::GAThreading::performTaskOnGAThread([userId, flowType, currency, amount, itemType, itemId, fields]()
+        {
+            if (!isSdkReady(true, true, "Could not add resource event"))
+            {
+                return;
+            }
+            std::shared_ptr<state::GAPlayerContext> context = findPlayer(userId, "Could not add resource event");
+            if(!context)
+            {
+                return;
+            }
+            state::GAPlayerScope scope(context.get());
+            events::GAEvents::addResourceEvent(flowType, currency.data(), amount, itemType.data(), itemId.data(), fields);
+        });
+    }
+
+    void GameAnalytics::addProgressionEvent(const PlayerContext& player, EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, const EventFields& fields)
+    {
+        addPlayerProgressionEvent(player, progressionStatus, progression01, progression02, progression03, 0, false, fields);
+    }
+
+    void GameAnalytics::addProgressionEvent(const PlayerContext& player, EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, const EventFields& fields)
+    {
+        addPlayerProgressionEvent(player, progressionStatus, progression01, progression02, progression03, score, true, fields);
+    }
+
+    void GameAnalytics::addPlayerProgressionEvent(const PlayerContext& player, EGAProgressionStatus progressionStatus, const char* progression01_, const char* progression02_, const char* progression03_, int score, bool sendScore, const EventFields& fields)
+    {
+        if(_endThread || !player.isValid())
+        {
+            return;
+        }
+
+        std::string userId = player._userId;
+        std::array<char, 65> progression01 = {'\0'};
+        snprintf(progression01.data(), progression01.size(), "%s", progression01_ ? progression01_ : "");
+        std::array<char, 65> progression02 = {'\0'};
+        snprintf(progression02.data(), progression02.size(), "%s", progression02_ ? progression02_ : "");
+        std::array<char, 65> progression03 = {'\0'};
+        snprintf(progression03.data(), progression03.size(), "%s", progression03_ ? progression03_ : "");
+        threading::GAThreading::performTaskOnGAThread([userId, progressionStatus, progression01, progression02, progression03, score, sendScore, fields]()
+        {
+            if (!isSdkReady(true, true, "Could not add progression event"))
+            {
+                return;
+            }
+            std::shared_ptr<state::GAPlayerContext> context = findPlayer(userId, "Could not add progression event");
+            if(!context)
+            {
+                return;
+            }
+            state::GAPlayerScope scope(context.get());
+            events::GAEvents::addProgressionEvent(progressionStatus, progression01.data(), progression02.data(), progression03.data(), score, sendScore, fields);
+        });
+    }
+
+    void GameAnalytics::addDesignEvent(const PlayerContext& player, const char* eventId, const EventFields& fields)
+    {
+        addPlayerDesignEvent(player, eventId, 0, false, fields);
+    }
+
+    void GameAnalytics::addDesignEvent(const PlayerContext& player, const char* eventId, double value, const EventFields& fields)
+    {
+        addPlayerDesignEvent(player, eventId, value, true, fields);
+    }
+
+    void GameAnalytics::addPlayerDesignEvent(const PlayerContext& player, const char* eventId_, double value, bool sendValue, const EventFields& fields)
+    {
+        if(_endThread || !player.isValid())
+        {
+            return;
+        }
+
+        std::string userId = player._userId;
+        std::array<char, 400> eventId = {'\0'};
+        snprintf(eventId.data(), eventId.size(), "%s", eventId_ ? eventId_ : "");
+        threading::GAThreading::performTaskOnGAThread([userId, eventId, value, sendValue, fields]()
+        {
+            if (!isSdkReady(true, true, "Could not add design event"))
+            {
+                return;
+            }
+            std::shared_ptr<state::GAPlayerContext> context = findPlayer(userId, "Could not add design event");
+            if(!context)
+            {
+                return;
+            }
+            state::GAPlayerScope scope(context.get());
+            events::GAEvents::addDesignEvent(eventId.data(), value, sendValue, fields);
+        });
+    }
+
+    void GameAnalytics::addErrorEvent(const PlayerContext& player, EGAErrorSeverity severity, const char* message_, const EventFields& fields)
+    {
+        if(_endThread || !player.isValid())
+        {
+            return;
+        }
+
+        std::string userId = player._userId;
+        std::array<char, 8200> message = {'\0'};
+        snprintf(message.data(), message.size(), "%s", message_ ? message_ : "");
+        threading::GAThreading::performTaskOnGAThread([userId, severity, message, fields]()
+        {
+            if (!isSdkReady(true, true, "Could not add error event"))
+            {
+                return;
+            }
+            std::shared_ptr<state::GAPlayerContext> context = findPlayer(userId, "Could not add error event");
+            if(!context)
+            {
+                return;
+            }
+            state::GAPlayerScope scope(context.get());
+            events::GAEvents::addErrorEvent(severity, message.data(), fields);
+        });
+    }
+
 
     // -------------- SET GAME STATE CHANGES --------------- //
 
@@ -1215,7 +1900,7 @@ namespace gameanalytics
             }
             else
             {
-                logging::GALogger::i("OnSuspending: Not calling GameAnalytics.OnSuspend() as using manual session handling");
+                GA_LOG_INFO("OnSuspending: Not calling GameAnalytics.OnSuspend() as using manual session handling");
             }
             deferral->Complete();
         });
@@ -1240,7 +1925,7 @@ namespace gameanalytics
             }
             else
             {
-                logging::GALogger::i("OnResuming: Not calling GameAnalytics.OnResume() as using manual session handling");
+                GA_LOG_INFO("OnResuming: Not calling GameAnalytics.OnResume() as using manual session handling");
             }
         });
     }
@@ -13,6 +13,9 @@
 
 #include <vector>
 #include <memory>
+#include <string>
+#include <cstdint>
+#include <functional>
 #if USE_TIZEN || GA_SHARED_LIB
 #include "GameAnalyticsExtern.h"
 #endif
@@ -22,6 +25,10 @@
 
 namespace gameanalytics
 {
+    namespace client
+    {
+        class GAClientContext;
+    }
 
     /*!
      @enum
@@ -75,12 +82,168 @@ namespace gameanalytics
         Critical = 5
     };
 
+    /*!
+     @enum
+     @discussion
+     This enum is used to specify what an event sampling decision is based on
+     @constant GASamplingKeyUser
+     @constant GASamplingKeySession
+     */
+    enum EGASamplingKey
+    {
+        SampleByUser = 1,
+        SampleBySession = 2
+    };
+
+    /*!
+     @enum
+     @discussion
+     State of the circuit breaker that pauses event sending while the collector fails
+     @constant CircuitClosed events are sent
+     @constant CircuitOpen sending is paused
+     @constant CircuitHalfOpen a small probe batch is being sent
+     */
+    enum EGACircuitState
+    {
+        CircuitClosed = 0,
+        CircuitOpen = 1,
+        CircuitHalfOpen = 2
+    };
+
+    /*!
+     @enum
+     @discussion
+     Deflate strategy used to gzip event payloads, same values as zlib
+     @constant CompressionDefault
+     @constant CompressionFiltered
+     @constant CompressionHuffmanOnly
+     @constant CompressionRle
+     @constant CompressionFixed
+     */
+    enum EGACompressionStrategy
+    {
+        CompressionDefault = 0,
+        CompressionFiltered = 1,
+        CompressionHuffmanOnly = 2,
+        CompressionRle = 3,
+        CompressionFixed = 4
+    };
+
     class IRemoteConfigsListener
     {
         public:
-            virtual void onRemoteConfigsUpdated() = 0;
+            virtual ~IRemoteConfigsListener() {}
+            // every time the configs are applied, changed or not
+            virtual void onRemoteConfigsUpdated() {}
+            // keys added, changed or removed, only called when there are any
+            virtual void onRemoteConfigsChanged(const std::vector<std::string>& /*changedKeys*/) {}
+    };
+
+    /*!
+     @enum
+     @discussion
+     Kind of collector request handed to a transport
+     @constant TransportInit init call, the response holds server time and remote configs
+     @constant TransportEvents batch of events
+     @constant TransportSdkError report of an SDK error
+     */
+    enum EGATransportRequestType
+    {
+        TransportInit = 0,
+        TransportEvents = 1,
+        TransportSdkError = 2
+    };
+
+    // A JSON POST to the collector with Content-Type application/json and the
+    // authorization as Authorization header. The pointers are owned by the SDK
+    // and only valid during the send call.
+    struct GATransportRequest
+    {
+        EGATransportRequestType type;
+        const char* url;
+        const char* body;
+        size_t size;
+        const char* authorization;
+        // body is gzipped, send Content-Encoding gzip
+        bool gzip;
+    };
+
+    struct GATransportResponse
+    {
+        // HTTP status code, 0 when the collector could not be reached
+        int statusCode;
+        std::string body;
+    };
+
+    class ITransport
+    {
+        public:
+            virtual ~ITransport() {}
+            // blocks until the collector answers
+            virtual GATransportResponse send(const GATransportRequest& request) = 0;
+            // used for event batches, done must be called exactly once and may be
+            // called from any thread. Copy the request to answer it later.
+            virtual void sendAsync(const GATransportRequest& request, const std::function<void(const GATransportResponse&)>& done)
+            {
+                done(send(request));
+            }
+    };
+
+    // Fixed bucket histogram, counts[i] holds the values up to bounds[i] and
+    // the last bucket the values above the last bound.
+    struct GAMetricsHistogram
+    {
+        static const int BucketCount = 16;
+
+        double bounds[BucketCount - 1];
+        uint64_t counts[BucketCount];
+        uint64_t count;
+        double sum;
+        double max;
+    };
+
+    // Counters of the SDK pipeline since start, shared by all instances in
+    // the process. Times are in milliseconds.
+    struct GAMetricsSnapshot
+    {
+        // tasks posted to the GA thread, refused after shutdown, run and waiting
+        uint64_t tasksEnqueued;
+        uint64_t tasksDropped;
+        uint64_t tasksProcessed;
+        uint64_t taskQueueDepth;
+
+        // events written to the store, accepted by the collector and refused by it
+        uint64_t eventsStored;
+        uint64_t eventsSent;
+        uint64_t eventsRejected;
+        // batches put back because the collector could not be reached
+        uint64_t batchRetries;
+
+        // database file size and events in it, updated every event queue tick
+        // of the default instance only, a GameAnalyticsClient's store is not counted
+        uint64_t dbSizeBytes;
+        uint64_t dbEventRows;
+
+        // collector responses by status code, no response includes status 0
+        uint64_t httpNoResponse;
+        uint64_t http2xx;
+        uint64_t http4xx;
+        uint64_t http5xx;
+        uint64_t httpOther;
+
+        // events per batch and compressed / original payload size
+        GAMetricsHistogram batchSize;
+        GAMetricsHistogram gzipRatio;
+        GAMetricsHistogram gzipTime;
+        GAMetricsHistogram hmacTime;
+        // round trip of event batches
+        GAMetricsHistogram httpTime;
+        // time spent in the store's executeQuerySync
+        GAMetricsHistogram queryTime;
     };
 
+    typedef std::function<void(const GAMetricsSnapshot&)> GAMetricsCallback;
+
     struct CharArray
     {
     public:
@@ -106,6 +269,86 @@ namespace gameanalytics
         std::vector<CharArray> v;
     };
 
+    // Typed custom fields for an event. Keys and values are validated when
+    // added; invalid entries are dropped with a warning. The first few fields
+    // are stored inline so small field sets do not allocate.
+    class EventFields
+    {
+    public:
+        static const size_t MaxCount = 50;
+        static const size_t MaxKeyLength = 64;
+        static const size_t MaxStringLength = 256;
+
+        EventFields();
+
+        EventFields& add(const char* key, double value);
+        EventFields& add(const char* key, const char* value);
+        EventFields& add(const char* key, const std::string& value);
+
+        size_t size() const;
+        bool empty() const;
+        const char* keyAt(size_t index) const;
+        bool isStringAt(size_t index) const;
+        double numberAt(size_t index) const;
+        const char* stringAt(size_t index) const;
+
+    private:
+        struct Field
+        {
+            uint32_t keyOffset;
+            uint32_t stringOffset;
+            double number;
+            bool isString;
+        };
+
+        static const size_t InlineCount = 4;
+        static const size_t InlineTextSize = 192;
+
+        bool validateKey(const char* key) const;
+        void addField(const char* key, const char* value, size_t valueLength, double number, bool isString);
+        uint32_t appendText(const char* s, size_t length);
+        const Field& field(size_t index) const;
+        const char* text() const;
+
+        // strings are stored as offsets so copies and moves stay valid
+        Field _inlineFields[InlineCount];
+        std::vector<Field> _fields;
+        char _inlineText[InlineTextSize];
+        std::vector<char> _text;
+        size_t _count;
+        size_t _textSize;
+    };
+
+    // Handle to a design event id or progression registered up front with
+    // registerDesignEventId/registerProgressionEventId. Events added by handle
+    // reuse the cached validation and the interned strings. An id of 0 is invalid.
+    struct EventIdHandle
+    {
+    public:
+        uint32_t id = 0;
+    };
+
+    // Remote config key resolved once with registerRemoteConfigKey, reads by
+    // handle index the current configs directly. An id of 0 is invalid.
+    struct RemoteConfigKey
+    {
+    public:
+        uint32_t id = 0;
+    };
+
+    // A player reported on from a server in multi-user mode, returned by
+    // GameAnalytics::startPlayerSession. Only holds the user id, cheap to copy.
+    class PlayerContext
+    {
+    public:
+        const char* getUserId() const { return _userId.c_str(); }
+        bool isValid() const { return !_userId.empty(); }
+
+    private:
+        friend class GameAnalytics;
+        std::string _userId;
+    };
+
     class GameAnalytics
     {
      public:
@@ -134,6 +377,17 @@ namespace gameanalytics
         static void configureGameEngineVersion(const char* engineVersion);
 
         static void configureUserId(const char* uId);
+        // number of event batches that may be sent at the same time (1-16, default 4)
+        static void configureEventBatchConcurrency(int maxInFlightBatches);
+        // gzip level 1 (fastest) to 9 (smallest) for event payloads, 0 (default)
+        // picks the level from the measured upload speed and compression time
+        static void configureEventCompression(int level, EGACompressionStrategy strategy);
+        // send collector requests through your own network stack instead of
+        // libcurl, null restores the built-in transport
+        static void configureTransport(const std::shared_ptr<ITransport>& transport);
+        // size in bytes at which ga_log.txt is rotated and the number of log
+        // files to keep (default 1 MB and 2 files)
+        static void configureLogRotation(long maxFileSize, int maxFiles);
 
         // initialize - starting SDK (need configuration before starting)
         static void initialize(const char* gameKey, const char* gameSecret);
@@ -152,6 +406,30 @@ namespace gameanalytics
         static void addDesignEvent(const char* eventId, double value);
         static void addErrorEvent(EGAErrorSeverity severity, const char* message);
 
+        // add events with custom fields
+        static void addBusinessEvent(const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType, const EventFields& fields);
+        static void addResourceEvent(EGAResourceFlowType flowType, const char* currency, float amount, const char* itemType, const char* itemId, const EventFields& fields);
+        static void addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, const EventFields& fields);
+        static void addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, const EventFields& fields);
+        static void addDesignEvent(const char* eventId, const EventFields& fields);
+        static void addDesignEvent(const char* eventId, double value, const EventFields& fields);
+        static void addErrorEvent(EGAErrorSeverity severity, const char* message, const EventFields& fields);
+
+        // pre-register frequently sent event ids, returns an invalid handle if validation fails
+        static EventIdHandle registerDesignEventId(const char* eventId);
+        static EventIdHandle registerProgressionEventId(const char* progression01, const char* progression02, const char* progression03);
+
+        static void addProgressionEvent(EGAProgressionStatus progressionStatus, EventIdHandle progression);
+        static void addProgressionEvent(EGAProgressionStatus progressionStatus, EventIdHandle progression, int score);
+        static void addDesignEvent(EventIdHandle eventId);
+        static void addDesignEvent(EventIdHandle eventId, double value);
+
+        // opt-in: design events with a value and no custom fields are summarised
+        // per event id and custom dimensions, one design event with count, sum,
+        // min, max and a histogram is sent when the window closes
+        static void setDesignEventAggregation(const char* eventId, int windowSeconds, const std::vector<double>& histogramBounds);
+        static void removeDesignEventAggregation(const char* eventId);
+
         // set calls can be changed at any time (pre- and post-initialize)
         // some calls only work after a configure is called (setCustomDimension)
         static void setEnabledInfoLog(bool flag);
@@ -159,6 +437,11 @@ namespace gameanalytics
         static void setEnabledManualSessionHandling(bool flag);
         static void setEnabledErrorReporting(bool flag);
         static void setEnabledEventSubmission(bool flag);
+        // keep rate (0-1) of the events in a category ("design", "business", "progression",
+        // "resource" or "error") whose event id starts with eventIdPrefix, decided per user
+        // or session so the same users stay sampled. Remote configs rules take precedence.
+        static void setEventSampling(const char* category, const char* eventIdPrefix, double rate, EGASamplingKey key);
+        static void clearEventSampling();
         static void setCustomDimension01(const char* dimension01);
         static void setCustomDimension02(const char* dimension02);
         static void setCustomDimension03(const char* dimension03);
@@ -166,13 +449,58 @@ namespace gameanalytics
         static void startSession();
         static void endSession();
 
+        // multi-user (server) mode: events on behalf of many players from one process.
+        // Each player has its own user id, session, session and transaction numbers,
+        // custom dimensions and progression attempts, the events share the store and
+        // the batching of the SDK session, which must be running. sessionNum and
+        // transactionNum are the player's counts so far, kept by the server. Beyond
+        // the max players (100000 by default) the least recently active are ended.
+        static void configureMaxPlayerSessions(int maxPlayers);
+        static PlayerContext startPlayerSession(const char* userId);
+        static PlayerContext startPlayerSession(const char* userId, int sessionNum, int transactionNum);
+        static void endPlayerSession(const PlayerContext& player);
+        static void setCustomDimension01(const PlayerContext& player, const char* dimension01);
+        static void setCustomDimension02(const PlayerContext& player, const char* dimension02);
+        static void setCustomDimension03(const PlayerContext& player, const char* dimension03);
+        static void addBusinessEvent(const PlayerContext& player, const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType, const EventFields& fields);
+        static void addResourceEvent(const PlayerContext& player, EGAResourceFlowType flowType, const char* currency, float amount, const char* itemType, const char* itemId, const EventFields& fields);
+        static void addProgressionEvent(const PlayerContext& player, EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, const EventFields& fields);
+        static void addProgressionEvent(const PlayerContext& player, EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, const EventFields& fields);
+        static void addDesignEvent(const PlayerContext& player, const char* eventId, const EventFields& fields);
+        static void addDesignEvent(const PlayerContext& player, const char* eventId, double value, const EventFields& fields);
+        static void addErrorEvent(const PlayerContext& player, EGAErrorSeverity severity, const char* message, const EventFields& fields);
+
         static std::vector<char> getRemoteConfigsValueAsString(const char* key);
         static std::vector<char> getRemoteConfigsValueAsString(const char* key, const char* defaultValue);
+        // for per-frame reads from any thread: never locks or allocates, the
+        // returned string stays valid until shutdown even if the configs change
+        static const char* getRemoteConfigsValue(const char* key, const char* defaultValue);
+        static RemoteConfigKey registerRemoteConfigKey(const char* key);
+        static const char* getRemoteConfigsValue(RemoteConfigKey key, const char* defaultValue);
+        // typed values are parsed once when the configs arrive, the default is
+        // returned when the key is missing or does not hold that type. Bools are
+        // "true", "false", 0 or 1.
+        static int64_t getRemoteConfigInt(const char* key, int64_t defaultValue);
+        static int64_t getRemoteConfigInt(RemoteConfigKey key, int64_t defaultValue);
+        static double getRemoteConfigDouble(const char* key, double defaultValue);
+        static double getRemoteConfigDouble(RemoteConfigKey key, double defaultValue);
+        static bool getRemoteConfigBool(const char* key, bool defaultValue);
+        static bool getRemoteConfigBool(RemoteConfigKey key, bool defaultValue);
         static bool isRemoteConfigsReady();
         static void addRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener);
         static void removeRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener);
         static std::vector<char> getRemoteConfigsContentAsString();
 
+        static EGACircuitState getCollectorCircuitState();
+
+        // pipeline counters and histograms, cheap enough to poll, shared by the
+        // default instance and every GameAnalyticsClient except for the store
+        // size, which is the default instance's
+        static GAMetricsSnapshot getMetrics();
+        // calls callback with a snapshot every intervalSeconds (at least 1) on
+        // its own thread, a null callback stops the export
+        static void configureMetricsExport(double intervalSeconds, const GAMetricsCallback& callback);
+
         static std::vector<char> getABTestingId();
         static std::vector<char> getABTestingVariantId();
 
@@ -229,6 +557,8 @@ namespace gameanalytics
         static void addDesignEvent(const char* eventId, double value, const char* fields);
         static void addErrorEvent(EGAErrorSeverity severity, const char* message, const char* fields);
 
+        static void addPlayerProgressionEvent(const PlayerContext& player, EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, bool sendScore, const EventFields& fields);
+        static void addPlayerDesignEvent(const PlayerContext& player, const char* eventId, double value, bool sendValue, const EventFields& fields);
         static bool isSdkReady(bool needsInitialized);
         static bool isSdkReady(bool needsInitialized, bool warn);
         static bool isSdkReady(bool needsInitialized, bool warn, const char* message);
@@ -237,4 +567,68 @@ namespace gameanalytics
         static void OnAppResuming(Platform::Object ^sender, Platform::Object ^args);
 #endif
     };
+
+    // An independent SDK instance for one more game in the process, with its own
+    // state, store file, event queue and transport. The static GameAnalytics calls
+    // are the default instance. All instances share the GA thread and the curl
+    // connections. Destroying a client ends its session, its queued work still runs.
+    class GameAnalyticsClient
+    {
+     public:
+        GameAnalyticsClient();
+        ~GameAnalyticsClient();
+
+        void configureAvailableCustomDimensions01(const StringVector& customDimensions);
+        void configureAvailableCustomDimensions02(const StringVector& customDimensions);
+        void configureAvailableCustomDimensions03(const StringVector& customDimensions);
+        void configureAvailableResourceCurrencies(const StringVector& resourceCurrencies);
+        void configureAvailableResourceItemTypes(const StringVector& resourceItemTypes);
+        void configureBuild(const char* build);
+        void configureUserId(const char* uId);
+        void configureEventBatchConcurrency(int maxInFlightBatches);
+        void configureTransport(const std::shared_ptr<ITransport>& transport);
+
+        // the game key must not be in use by another instance
+        void initialize(const char* gameKey, const char* gameSecret);
+
+        void addBusinessEvent(const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType);
+        void addResourceEvent(EGAResourceFlowType flowType, const char* currency, float amount, const char* itemType, const char* itemId);
+        void addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03);
+        void addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score);
+        void addDesignEvent(const char* eventId);
+        void addDesignEvent(const char* eventId, double value);
+        void addErrorEvent(EGAErrorSeverity severity, const char* message);
+
+        void addBusinessEvent(const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType, const EventFields& fields);
+        void addResourceEvent(EGAResourceFlowType flowType, const char* currency, float amount, const char* itemType, const char* itemId, const EventFields& fields);
+        void addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, const EventFields& fields);
+        void addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, const EventFields& fields);
+        void addDesignEvent(const char* eventId, const EventFields& fields);
+        void addDesignEvent(const char* eventId, double value, const EventFields& fields);
+        void addErrorEvent(EGAErrorSeverity severity, const char* message, const EventFields& fields);
+
+        void setEnabledManualSessionHandling(bool flag);
+        void setEnabledEventSubmission(bool flag);
+        void setCustomDimension01(const char* dimension01);
+        void setCustomDimension02(const char* dimension02);
+        void setCustomDimension03(const char* dimension03);
+
+        void startSession();
+        void endSession();
+
+        std::vector<char> getRemoteConfigsValueAsString(const char* key, const char* defaultValue);
+        const char* getRemoteConfigsValue(const char* key, const char* defaultValue);
+        bool isRemoteConfigsReady();
+        void addRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener);
+        void removeRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener);
+        std::vector<char> getRemoteConfigsContentAsString();
+        std::vector<char> getABTestingId();
+        std::vector<char> getABTestingVariantId();
+
+     private:
+        GameAnalyticsClient(const GameAnalyticsClient&) = delete;
+        GameAnalyticsClient& operator=(const GameAnalyticsClient&) = delete;
+
+        std::shared_ptr<client::GAClientContext> _context;
+    };
 } // namespace gameanalytics
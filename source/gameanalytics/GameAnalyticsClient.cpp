@@ -0,0 +1,263 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GameAnalytics.h"
+#include "GAClient.h"
+#include "GAState.h"
+#include "GAThreading.h"
+
+namespace gameanalytics
+{
+    GameAnalyticsClient::GameAnalyticsClient():
+        _context(std::make_shared<client::GAClientContext>())
+    {
+    }
+
+    GameAnalyticsClient::~GameAnalyticsClient()
+    {
+        // the queued tasks keep the context alive until they have run
+        client::GAClientScope scope(_context.get());
+        threading::GAThreading::performTaskOnGAThread([]()
+        {
+            state::GAState::endSessionAndStopQueue(false);
+        });
+    }
+
+    // each call runs the default instance's code with this client's parts
+
+    void GameAnalyticsClient::configureAvailableCustomDimensions01(const StringVector& customDimensions)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::configureAvailableCustomDimensions01(customDimensions);
+    }
+
+    void GameAnalyticsClient::configureAvailableCustomDimensions02(const StringVector& customDimensions)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::configureAvailableCustomDimensions02(customDimensions);
+    }
+
+    void GameAnalyticsClient::configureAvailableCustomDimensions03(const StringVector& customDimensions)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::configureAvailableCustomDimensions03(customDimensions);
+    }
+
+    void GameAnalyticsClient::configureAvailableResourceCurrencies(const StringVector& resourceCurrencies)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::configureAvailableResourceCurrencies(resourceCurrencies);
+    }
+
+    void GameAnalyticsClient::configureAvailableResourceItemTypes(const StringVector& resourceItemTypes)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::configureAvailableResourceItemTypes(resourceItemTypes);
+    }
+
+    void GameAnalyticsClient::configureBuild(const char* build)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::configureBuild(build);
+    }
+
+    void GameAnalyticsClient::configureUserId(const char* uId)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::configureUserId(uId);
+    }
+
+    void GameAnalyticsClient::configureEventBatchConcurrency(int maxInFlightBatches)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::configureEventBatchConcurrency(maxInFlightBatches);
+    }
+
+    void GameAnalyticsClient::configureTransport(const std::shared_ptr<ITransport>& transport)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::configureTransport(transport);
+    }
+
+    void GameAnalyticsClient::initialize(const char* gameKey, const char* gameSecret)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::initialize(gameKey, gameSecret);
+    }
+
+    void GameAnalyticsClient::addBusinessEvent(const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addBusinessEvent(currency, amount, itemType, itemId, cartType);
+    }
+
+    void GameAnalyticsClient::addResourceEvent(EGAResourceFlowType flowType, const char* currency, float amount, const char* itemType, const char* itemId)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addResourceEvent(flowType, currency, amount, itemType, itemId);
+    }
+
+    void GameAnalyticsClient::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addProgressionEvent(progressionStatus, progression01, progression02, progression03);
+    }
+
+    void GameAnalyticsClient::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addProgressionEvent(progressionStatus, progression01, progression02, progression03, score);
+    }
+
+    void GameAnalyticsClient::addDesignEvent(const char* eventId)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addDesignEvent(eventId);
+    }
+
+    void GameAnalyticsClient::addDesignEvent(const char* eventId, double value)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addDesignEvent(eventId, value);
+    }
+
+    void GameAnalyticsClient::addErrorEvent(EGAErrorSeverity severity, const char* message)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addErrorEvent(severity, message);
+    }
+
+    void GameAnalyticsClient::addBusinessEvent(const char* currency, int amount, const char* itemType, const char* itemId, const char* cartType, const EventFields& fields)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addBusinessEvent(currency, amount, itemType, itemId, cartType, fields);
+    }
+
+    void GameAnalyticsClient::addResourceEvent(EGAResourceFlowType flowType, const char* currency, float amount, const char* itemType, const char* itemId, const EventFields& fields)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addResourceEvent(flowType, currency, amount, itemType, itemId, fields);
+    }
+
+    void GameAnalyticsClient::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, const EventFields& fields)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addProgressionEvent(progressionStatus, progression01, progression02, progression03, fields);
+    }
+
+    void GameAnalyticsClient::addProgressionEvent(EGAProgressionStatus progressionStatus, const char* progression01, const char* progression02, const char* progression03, int score, const EventFields& fields)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addProgressionEvent(progressionStatus, progression01, progression02, progression03, score, fields);
+    }
+
+    void GameAnalyticsClient::addDesignEvent(const char* eventId, const EventFields& fields)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addDesignEvent(eventId, fields);
+    }
+
+    void GameAnalyticsClient::addDesignEvent(const char* eventId, double value, const EventFields& fields)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addDesignEvent(eventId, value, fields);
+    }
+
+    void GameAnalyticsClient::addErrorEvent(EGAErrorSeverity severity, const char* message, const EventFields& fields)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addErrorEvent(severity, message, fields);
+    }
+
+    void GameAnalyticsClient::setEnabledManualSessionHandling(bool flag)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::setEnabledManualSessionHandling(flag);
+    }
+
+    void GameAnalyticsClient::setEnabledEventSubmission(bool flag)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::setEnabledEventSubmission(flag);
+    }
+
+    void GameAnalyticsClient::setCustomDimension01(const char* dimension01)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::setCustomDimension01(dimension01);
+    }
+
+    void GameAnalyticsClient::setCustomDimension02(const char* dimension02)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::setCustomDimension02(dimension02);
+    }
+
+    void GameAnalyticsClient::setCustomDimension03(const char* dimension03)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::setCustomDimension03(dimension03);
+    }
+
+    void GameAnalyticsClient::startSession()
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::startSession();
+    }
+
+    void GameAnalyticsClient::endSession()
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::endSession();
+    }
+
+    std::vector<char> GameAnalyticsClient::getRemoteConfigsValueAsString(const char* key, const char* defaultValue)
+    {
+        client::GAClientScope scope(_context.get());
+        return GameAnalytics::getRemoteConfigsValueAsString(key, defaultValue);
+    }
+
+    const char* GameAnalyticsClient::getRemoteConfigsValue(const char* key, const char* defaultValue)
+    {
+        client::GAClientScope scope(_context.get());
+        return GameAnalytics::getRemoteConfigsValue(key, defaultValue);
+    }
+
+    bool GameAnalyticsClient::isRemoteConfigsReady()
+    {
+        client::GAClientScope scope(_context.get());
+        return GameAnalytics::isRemoteConfigsReady();
+    }
+
+    void GameAnalyticsClient::addRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::addRemoteConfigsListener(listener);
+    }
+
+    void GameAnalyticsClient::removeRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener)
+    {
+        client::GAClientScope scope(_context.get());
+        GameAnalytics::removeRemoteConfigsListener(listener);
+    }
+
+    std::vector<char> GameAnalyticsClient::getRemoteConfigsContentAsString()
+    {
+        client::GAClientScope scope(_context.get());
+        return GameAnalytics::getRemoteConfigsContentAsString();
+    }
+
+    std::vector<char> GameAnalyticsClient::getABTestingId()
+    {
+        client::GAClientScope scope(_context.get());
+        return GameAnalytics::getABTestingId();
+    }
+
+    std::vector<char> GameAnalyticsClient::getABTestingVariantId()
+    {
+        client::GAClientScope scope(_context.get());
+        return GameAnalytics::getABTestingVariantId();
+    }
+}
@@ -0,0 +1,63 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GABatchController.h>
+
+using gameanalytics::events::GABatchController;
+
+TEST(GABatchController, testGrowsOnFastLink)
+{
+    GABatchController controller;
+    ASSERT_EQ(GABatchController::InitialBatchSize, controller.batchSize());
+
+    for(int n = 0; n < 100; ++n)
+    {
+        int size = controller.batchSize();
+        controller.onBatchSent(size, size * 50, 0.1, true);
+    }
+    ASSERT_EQ(GABatchController::MaxBatchSize, controller.batchSize());
+}
+
+TEST(GABatchController, testHalvesOnFailure)
+{
+    GABatchController controller;
+    controller.onBatchSent(0, 0, 0, false);
+    ASSERT_EQ(GABatchController::InitialBatchSize / 2, controller.batchSize());
+
+    for(int n = 0; n < 20; ++n)
+    {
+        controller.onBatchSent(0, 0, 0, false);
+    }
+    ASSERT_EQ(GABatchController::MinBatchSize, controller.batchSize());
+    ASSERT_GT(controller.failureRate(), 0.9);
+}
+
+TEST(GABatchController, testHalvesOnSlowRoundTrip)
+{
+    GABatchController controller;
+    controller.onBatchSent(GABatchController::InitialBatchSize, 1000, GABatchController::TargetRoundTripSeconds * 2, true);
+    ASSERT_EQ(GABatchController::InitialBatchSize / 2, controller.batchSize());
+}
+
+TEST(GABatchController, testPayloadByteBudget)
+{
+    GABatchController controller;
+    // 4 KB per event, only 16 fit the budget
+    controller.onBatchSent(10, 40 * 1024, 0.1, true);
+    ASSERT_EQ(static_cast<int>(GABatchController::TargetPayloadBytes / (4 * 1024)), controller.batchSize());
+}
+
+TEST(GABatchController, testSendInterval)
+{
+    GABatchController controller;
+    ASSERT_EQ(GABatchController::DefaultIntervalSeconds, controller.sendInterval(0));
+    ASSERT_EQ(GABatchController::MinIntervalSeconds, controller.sendInterval(controller.batchSize()));
+
+    controller.onBatchSent(5, 500, 0.1, true);
+    ASSERT_LT(controller.sendInterval(5), GABatchController::DefaultIntervalSeconds);
+}
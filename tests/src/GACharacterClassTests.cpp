@@ -0,0 +1,50 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <string>
+#include <regex>
+#include <random>
+#include <iostream>
+
+#include <GACharacterClass.h>
+
+TEST(GACharacterClass, testVectorScanMatchesRegexAtAllAlignments)
+{
+    const std::regex eventIdLengthRegex("^[^:]{1,64}(?::[^:]{1,64}){0,4}$");
+    const std::regex eventIdCharactersRegex("^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}(:[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}){0,4}$");
+    const std::regex eventPartRegex("^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}$");
+    const std::regex fieldKeyRegex("^[a-zA-Z0-9_]{1,64}$");
+
+    std::cout << "GACharacterClass implementation: " << gameanalytics::utilities::GACharacterClass::implementationName() << std::endl;
+
+    // mostly valid characters and separators so that long matches are common
+    const char alphabet[] = "aZ09_ -.()!?\t:::";
+    std::mt19937 gen(42);
+    std::vector<char> buffer(512);
+
+    for (int iteration = 0; iteration < 20000; ++iteration)
+    {
+        size_t offset = gen() % 32;
+        size_t length = gen() % (iteration % 3 == 0 ? 340 : 80);
+        for (size_t i = 0; i < length; ++i)
+        {
+            buffer[offset + i] = gen() % 50 == 0 ? static_cast<char>(1 + gen() % 255) : alphabet[gen() % (sizeof(alphabet) - 1)];
+        }
+        buffer[offset + length] = '\0';
+        // garbage after the terminator must not influence the result
+        for (size_t i = offset + length + 1; i < buffer.size(); ++i)
+        {
+            buffer[i] = static_cast<char>(gen() % 256);
+        }
+
+        const char* s = &buffer[offset];
+        ASSERT_EQ(std::regex_match(s, eventIdLengthRegex), gameanalytics::utilities::GACharacterClass::matchesSegments(s, 0, 64, 5)) << s;
+        ASSERT_EQ(std::regex_match(s, eventIdCharactersRegex), gameanalytics::utilities::GACharacterClass::matchesSegments(s, gameanalytics::utilities::EventPartCharacter, 64, 5)) << s;
+        ASSERT_EQ(std::regex_match(s, eventPartRegex), gameanalytics::utilities::GACharacterClass::matchesClass(s, gameanalytics::utilities::EventPartCharacter, 1, 64)) << s;
+        ASSERT_EQ(std::regex_match(s, fieldKeyRegex), gameanalytics::utilities::GACharacterClass::matchesClass(s, gameanalytics::utilities::FieldKeyCharacter, 1, 64)) << s;
+    }
+}
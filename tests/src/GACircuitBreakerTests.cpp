@@ -0,0 +1,96 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GACircuitBreaker.h>
+
+using gameanalytics::events::GACircuitBreaker;
+
+TEST(GACircuitBreaker, testBackoffBeforeOpening)
+{
+    GACircuitBreaker breaker(1);
+    ASSERT_TRUE(breaker.allowSend(0));
+    ASSERT_EQ(100, breaker.maxBatchSize(100));
+
+    breaker.onFailure(0);
+    ASSERT_EQ(gameanalytics::CircuitClosed, breaker.state());
+    ASSERT_LE(breaker.retryDelay(0), GACircuitBreaker::BaseBackoffSeconds);
+    ASSERT_TRUE(breaker.allowSend(GACircuitBreaker::BaseBackoffSeconds));
+
+    breaker.onSuccess();
+    ASSERT_EQ(0, breaker.consecutiveFailures());
+    ASSERT_EQ(0, breaker.retryDelay(0));
+}
+
+TEST(GACircuitBreaker, testOpenAndProbe)
+{
+    GACircuitBreaker breaker(2);
+    double now = 0;
+    for(int n = 0; n < GACircuitBreaker::FailureThreshold; ++n)
+    {
+        now += GACircuitBreaker::MaxBackoffSeconds;
+        ASSERT_TRUE(breaker.allowSend(now));
+        breaker.onFailure(now);
+    }
+    ASSERT_EQ(gameanalytics::CircuitOpen, breaker.state());
+    ASSERT_EQ(1u, breaker.timesOpened());
+    ASSERT_GE(breaker.retryDelay(now), GACircuitBreaker::MinOpenSeconds);
+    ASSERT_FALSE(breaker.allowSend(now));
+
+    // one small probe once the wait is over
+    now += GACircuitBreaker::MaxBackoffSeconds;
+    ASSERT_TRUE(breaker.allowSend(now));
+    ASSERT_EQ(gameanalytics::CircuitHalfOpen, breaker.state());
+    ASSERT_EQ(GACircuitBreaker::ProbeBatchSize, breaker.maxBatchSize(100));
+    ASSERT_FALSE(breaker.allowSend(now));
+
+    // failed probe opens again
+    breaker.onFailure(now);
+    ASSERT_EQ(gameanalytics::CircuitOpen, breaker.state());
+    ASSERT_EQ(1u, breaker.timesOpened());
+
+    now += GACircuitBreaker::MaxBackoffSeconds;
+    ASSERT_TRUE(breaker.allowSend(now));
+    breaker.onSuccess();
+    ASSERT_EQ(gameanalytics::CircuitClosed, breaker.state());
+    ASSERT_EQ(100, breaker.maxBatchSize(100));
+    ASSERT_TRUE(breaker.allowSend(now));
+}
+
+TEST(GACircuitBreaker, testCancelProbe)
+{
+    GACircuitBreaker breaker(3);
+    for(int n = 0; n < GACircuitBreaker::FailureThreshold; ++n)
+    {
+        breaker.onFailure(0);
+    }
+    double now = GACircuitBreaker::MaxBackoffSeconds;
+    ASSERT_TRUE(breaker.allowSend(now));
+    ASSERT_FALSE(breaker.allowSend(now));
+    breaker.cancelProbe();
+    ASSERT_TRUE(breaker.allowSend(now));
+}
+
+TEST(GACircuitBreaker, testFullJitter)
+{
+    // delays are spread over the whole range instead of clustering at the cap
+    double sum = 0;
+    double lowest = GACircuitBreaker::MaxBackoffSeconds;
+    for(uint32_t seed = 0; seed < 1000; ++seed)
+    {
+        GACircuitBreaker breaker(seed);
+        breaker.onFailure(0);
+        breaker.onFailure(0);
+        breaker.onFailure(0);
+        double delay = breaker.retryDelay(0);
+        ASSERT_LE(delay, GACircuitBreaker::BaseBackoffSeconds * 4);
+        sum += delay;
+        lowest = std::min(lowest, delay);
+    }
+    ASSERT_NEAR(GACircuitBreaker::BaseBackoffSeconds * 2, sum / 1000, 0.5);
+    ASSERT_LT(lowest, 0.5);
+}
@@ -0,0 +1,84 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GAClient.h>
+#include <GAState.h>
+
+using gameanalytics::client::GAClientContext;
+using gameanalytics::client::GAClientScope;
+using gameanalytics::state::GAState;
+
+TEST(GAClient, testScope)
+{
+    std::shared_ptr<GAClientContext> client = std::make_shared<GAClientContext>();
+    GAState* defaultState = GAState::getInstance();
+    ASSERT_EQ(NULL, GAClientContext::current());
+
+    {
+        GAClientScope scope(client.get());
+        ASSERT_EQ(client.get(), GAClientContext::current());
+        ASSERT_EQ(client->getState(), GAState::getInstance());
+        ASSERT_NE(defaultState, GAState::getInstance());
+
+        // nested scopes restore the outer client
+        {
+            GAClientScope inner(NULL);
+            ASSERT_EQ(defaultState, GAState::getInstance());
+        }
+        ASSERT_EQ(client->getState(), GAState::getInstance());
+    }
+
+    ASSERT_EQ(NULL, GAClientContext::current());
+    ASSERT_EQ(defaultState, GAState::getInstance());
+}
+
+TEST(GAClient, testBind)
+{
+    std::function<void()> block;
+    std::weak_ptr<GAClientContext> weak;
+    GAClientContext* seen = NULL;
+    {
+        std::shared_ptr<GAClientContext> client = std::make_shared<GAClientContext>();
+        weak = client;
+        GAClientScope scope(client.get());
+        block = GAClientContext::bind([&seen]() { seen = GAClientContext::current(); });
+    }
+
+    // the bound block keeps the client alive and runs with it
+    ASSERT_FALSE(weak.expired());
+    block();
+    ASSERT_EQ(weak.lock().get(), seen);
+    ASSERT_EQ(NULL, GAClientContext::current());
+    block = std::function<void()>();
+    ASSERT_TRUE(weak.expired());
+
+    // the default instance's blocks are not wrapped
+    seen = reinterpret_cast<GAClientContext*>(1);
+    GAClientContext::bind([&seen]() { seen = GAClientContext::current(); })();
+    ASSERT_EQ(NULL, seen);
+}
+
+TEST(GAClient, testGameKeys)
+{
+    const char* gameKey = "bd624ee6f8e6efb32a054f8d7ba11618";
+    {
+        std::shared_ptr<GAClientContext> first = std::make_shared<GAClientContext>();
+        std::shared_ptr<GAClientContext> second = std::make_shared<GAClientContext>();
+        {
+            GAClientScope scope(first.get());
+            ASSERT_TRUE(GAClientContext::claimGameKey(gameKey));
+        }
+        GAClientScope scope(second.get());
+        ASSERT_FALSE(GAClientContext::claimGameKey(gameKey));
+    }
+
+    // released with the client that claimed it
+    std::shared_ptr<GAClientContext> third = std::make_shared<GAClientContext>();
+    GAClientScope scope(third.get());
+    ASSERT_TRUE(GAClientContext::claimGameKey(gameKey));
+}
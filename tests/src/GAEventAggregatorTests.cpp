@@ -0,0 +1,86 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GAEventAggregator.h>
+
+TEST(GAEventAggregator, testAggregateWindow)
+{
+    std::vector<double> bounds = { 30, 60 };
+    ASSERT_TRUE(gameanalytics::events::GAEventAggregator::configure("perf:fps", 10, bounds));
+
+    ASSERT_TRUE(gameanalytics::events::GAEventAggregator::add("perf:fps", "", "", "", 25, 1000));
+    ASSERT_TRUE(gameanalytics::events::GAEventAggregator::add("perf:fps", "", "", "", 60, 1001));
+    ASSERT_TRUE(gameanalytics::events::GAEventAggregator::add("perf:fps", "", "", "", 90, 1005));
+    ASSERT_TRUE(gameanalytics::events::GAEventAggregator::add("perf:fps", "hard", "", "", 45, 1005));
+    ASSERT_FALSE(gameanalytics::events::GAEventAggregator::add("perf:other", "", "", "", 45, 1005));
+
+    std::vector<gameanalytics::events::GAAggregatedDesignEvent> aggregates;
+    gameanalytics::events::GAEventAggregator::takeClosedWindows(1009, false, aggregates);
+    ASSERT_TRUE(aggregates.empty());
+
+    gameanalytics::events::GAEventAggregator::takeClosedWindows(1010, false, aggregates);
+    ASSERT_EQ(1u, aggregates.size());
+    const gameanalytics::events::GAAggregatedDesignEvent& aggregate = aggregates[0];
+    ASSERT_EQ("perf:fps", aggregate.eventId);
+    ASSERT_EQ("", aggregate.dimension01);
+    ASSERT_EQ(3u, aggregate.count);
+    ASSERT_EQ(175, aggregate.sum);
+    ASSERT_EQ(25, aggregate.min);
+    ASSERT_EQ(90, aggregate.max);
+    ASSERT_EQ(3u, aggregate.histogram.size());
+    ASSERT_EQ(1u, aggregate.histogram[0]);
+    ASSERT_EQ(1u, aggregate.histogram[1]);
+    ASSERT_EQ(1u, aggregate.histogram[2]);
+
+    aggregates.clear();
+    gameanalytics::events::GAEventAggregator::takeClosedWindows(1010, true, aggregates);
+    ASSERT_EQ(1u, aggregates.size());
+    ASSERT_EQ("hard", aggregates[0].dimension01);
+    ASSERT_EQ(1u, aggregates[0].count);
+
+    aggregates.clear();
+    gameanalytics::events::GAEventAggregator::remove("perf:fps", aggregates);
+    ASSERT_TRUE(aggregates.empty());
+    ASSERT_FALSE(gameanalytics::events::GAEventAggregator::isAggregated("perf:fps"));
+}
+
+TEST(GAEventAggregator, testWindowClosedWhileAdding)
+{
+    std::vector<double> bounds;
+    ASSERT_TRUE(gameanalytics::events::GAEventAggregator::configure("ability:dash", 5, bounds));
+
+    ASSERT_TRUE(gameanalytics::events::GAEventAggregator::add("ability:dash", "", "", "", 1, 2000));
+    ASSERT_TRUE(gameanalytics::events::GAEventAggregator::add("ability:dash", "", "", "", 1, 2006));
+
+    std::vector<gameanalytics::events::GAAggregatedDesignEvent> aggregates;
+    gameanalytics::events::GAEventAggregator::takeClosedWindows(2007, false, aggregates);
+    ASSERT_EQ(1u, aggregates.size());
+    ASSERT_EQ(2000, aggregates[0].windowStart);
+    ASSERT_EQ(1u, aggregates[0].count);
+
+    aggregates.clear();
+    gameanalytics::events::GAEventAggregator::remove("ability:dash", aggregates);
+    ASSERT_EQ(1u, aggregates.size());
+    ASSERT_EQ(2006, aggregates[0].windowStart);
+}
+
+TEST(GAEventAggregator, testInvalidConfiguration)
+{
+    std::vector<double> bounds = { 10, 5 };
+    ASSERT_FALSE(gameanalytics::events::GAEventAggregator::configure("perf:frame", 10, bounds));
+    bounds.clear();
+    ASSERT_FALSE(gameanalytics::events::GAEventAggregator::configure("perf:frame", 0, bounds));
+    ASSERT_FALSE(gameanalytics::events::GAEventAggregator::configure("perf:frame", gameanalytics::events::GAEventAggregator::MaxWindowSeconds + 1, bounds));
+    bounds.assign(gameanalytics::events::GAEventAggregator::MaxHistogramBounds + 1, 0);
+    for(size_t i = 0; i < bounds.size(); ++i)
+    {
+        bounds[i] = static_cast<double>(i);
+    }
+    ASSERT_FALSE(gameanalytics::events::GAEventAggregator::configure("perf:frame", 10, bounds));
+    ASSERT_FALSE(gameanalytics::events::GAEventAggregator::isAggregated("perf:frame"));
+}
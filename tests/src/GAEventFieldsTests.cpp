@@ -0,0 +1,98 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GameAnalytics.h>
+#include <string>
+#include <limits>
+
+TEST(GAEventFields, testAddFields)
+{
+    gameanalytics::EventFields fields;
+    ASSERT_TRUE(fields.empty());
+
+    fields.add("level", 12).add("weapon", "sword").add("zone", std::string("forest"));
+    ASSERT_EQ(3u, fields.size());
+
+    ASSERT_STREQ("level", fields.keyAt(0));
+    ASSERT_FALSE(fields.isStringAt(0));
+    ASSERT_EQ(12, fields.numberAt(0));
+
+    ASSERT_STREQ("weapon", fields.keyAt(1));
+    ASSERT_TRUE(fields.isStringAt(1));
+    ASSERT_STREQ("sword", fields.stringAt(1));
+
+    ASSERT_STREQ("forest", fields.stringAt(2));
+}
+
+TEST(GAEventFields, testInvalidFieldsAreDropped)
+{
+    gameanalytics::EventFields fields;
+    fields.add("", 1);
+    fields.add(nullptr, 1);
+    fields.add("bad key", 1);
+    fields.add(std::string(gameanalytics::EventFields::MaxKeyLength + 1, 'k').c_str(), 1);
+    fields.add("empty", "");
+    fields.add("null", nullptr);
+    fields.add("long", std::string(gameanalytics::EventFields::MaxStringLength + 1, 'v'));
+    ASSERT_TRUE(fields.empty());
+
+    fields.add(std::string(gameanalytics::EventFields::MaxKeyLength, 'k').c_str(), std::string(gameanalytics::EventFields::MaxStringLength, 'v'));
+    ASSERT_EQ(1u, fields.size());
+}
+
+TEST(GAEventFields, testNonFiniteNumbersAreDropped)
+{
+    gameanalytics::EventFields fields;
+    fields.add("score", 1.5);
+    fields.add("nan", std::numeric_limits<double>::quiet_NaN());
+    fields.add("inf", std::numeric_limits<double>::infinity());
+    fields.add("negative_inf", -std::numeric_limits<double>::infinity());
+    ASSERT_EQ(1u, fields.size());
+    ASSERT_STREQ("score", fields.keyAt(0));
+}
+
+TEST(GAEventFields, testMaxCount)
+{
+    gameanalytics::EventFields fields;
+    for(size_t i = 0; i < gameanalytics::EventFields::MaxCount + 10; ++i)
+    {
+        fields.add(("key_" + std::to_string(i)).c_str(), "value_" + std::to_string(i));
+    }
+    ASSERT_EQ(gameanalytics::EventFields::MaxCount, fields.size());
+
+    for(size_t i = 0; i < fields.size(); ++i)
+    {
+        ASSERT_EQ("key_" + std::to_string(i), fields.keyAt(i));
+        ASSERT_EQ("value_" + std::to_string(i), fields.stringAt(i));
+    }
+}
+
+TEST(GAEventFields, testCopy)
+{
+    gameanalytics::EventFields small;
+    small.add("a", 1).add("b", "two");
+
+    gameanalytics::EventFields large;
+    for(size_t i = 0; i < 20; ++i)
+    {
+        large.add(("key_" + std::to_string(i)).c_str(), std::string(100, static_cast<char>('a' + i)));
+    }
+
+    gameanalytics::EventFields smallCopy = small;
+    gameanalytics::EventFields largeCopy = large;
+    large = small;
+
+    ASSERT_EQ(2u, smallCopy.size());
+    ASSERT_STREQ("two", smallCopy.stringAt(1));
+    ASSERT_EQ(2u, large.size());
+    ASSERT_STREQ("b", large.keyAt(1));
+
+    ASSERT_EQ(20u, largeCopy.size());
+    ASSERT_STREQ("key_19", largeCopy.keyAt(19));
+    ASSERT_EQ(std::string(100, 'a' + 19), largeCopy.stringAt(19));
+}
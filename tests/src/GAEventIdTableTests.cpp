@@ -0,0 +1,62 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GAEventIdTable.h>
+
+TEST(GAEventIdTable, testInternDesignEventId)
+{
+    uint32_t handle = gameanalytics::events::GAEventIdTable::internDesignEventId("level:boss_01:attempt");
+    ASSERT_NE(0u, handle);
+    ASSERT_EQ(handle, gameanalytics::events::GAEventIdTable::internDesignEventId("level:boss_01:attempt"));
+    ASSERT_NE(handle, gameanalytics::events::GAEventIdTable::internDesignEventId("level:boss_01:retry"));
+
+    gameanalytics::events::GAEventIdEntry entry;
+    ASSERT_TRUE(gameanalytics::events::GAEventIdTable::getEntry(handle, entry));
+    ASSERT_EQ(gameanalytics::events::DesignEventId, entry.kind);
+    ASSERT_TRUE(entry.valid);
+    ASSERT_STREQ("level:boss_01:attempt", entry.eventId);
+
+    uint32_t invalidHandle = gameanalytics::events::GAEventIdTable::internDesignEventId("level::attempt");
+    ASSERT_TRUE(gameanalytics::events::GAEventIdTable::getEntry(invalidHandle, entry));
+    ASSERT_FALSE(entry.valid);
+
+    ASSERT_FALSE(gameanalytics::events::GAEventIdTable::getEntry(0, entry));
+    ASSERT_FALSE(gameanalytics::events::GAEventIdTable::getEntry(1000000, entry));
+}
+
+TEST(GAEventIdTable, testInternProgression)
+{
+    uint32_t handle = gameanalytics::events::GAEventIdTable::internProgression("world_01", "level_02", "");
+    ASSERT_NE(0u, handle);
+    ASSERT_EQ(handle, gameanalytics::events::GAEventIdTable::internProgression("world_01", "level_02", nullptr));
+
+    gameanalytics::events::GAEventIdEntry entry;
+    ASSERT_TRUE(gameanalytics::events::GAEventIdTable::getEntry(handle, entry));
+    ASSERT_EQ(gameanalytics::events::ProgressionEventId, entry.kind);
+    ASSERT_TRUE(entry.valid);
+    ASSERT_STREQ("world_01:level_02", entry.eventId);
+    ASSERT_STREQ("world_01", entry.progression01);
+    ASSERT_STREQ("level_02", entry.progression02);
+    ASSERT_STREQ("", entry.progression03);
+    ASSERT_STREQ("Start:world_01:level_02", gameanalytics::events::GAEventIdTable::progressionEventId(entry, gameanalytics::Start));
+    ASSERT_STREQ("Complete:world_01:level_02", gameanalytics::events::GAEventIdTable::progressionEventId(entry, gameanalytics::Complete));
+    ASSERT_STREQ("Fail:world_01:level_02", gameanalytics::events::GAEventIdTable::progressionEventId(entry, gameanalytics::Fail));
+
+    // same identifier string but a different (invalid) split must not share the entry
+    uint32_t joinedHandle = gameanalytics::events::GAEventIdTable::internProgression("world_01:level_02", "", "");
+    ASSERT_NE(handle, joinedHandle);
+    ASSERT_TRUE(gameanalytics::events::GAEventIdTable::getEntry(joinedHandle, entry));
+    ASSERT_FALSE(entry.valid);
+
+    // 03 without 02
+    ASSERT_TRUE(gameanalytics::events::GAEventIdTable::getEntry(gameanalytics::events::GAEventIdTable::internProgression("world_01", "", "phase_01"), entry));
+    ASSERT_FALSE(entry.valid);
+    ASSERT_STREQ("world_01", entry.progression01);
+    ASSERT_STREQ("", entry.progression02);
+    ASSERT_STREQ("phase_01", entry.progression03);
+}
@@ -0,0 +1,68 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GAEventSampler.h>
+#include <string>
+
+TEST(GAEventSampler, testNoRulesKeepsEverything)
+{
+    gameanalytics::events::GAEventSampler::clearRules();
+    gameanalytics::events::GAEventSampler::setRemoteRules(nullptr);
+    ASSERT_FALSE(gameanalytics::events::GAEventSampler::isActive());
+    ASSERT_TRUE(gameanalytics::events::GAEventSampler::keepEvent("design", "perf:fps", "user", "session"));
+}
+
+TEST(GAEventSampler, testRateAndConsistency)
+{
+    ASSERT_TRUE(gameanalytics::events::GAEventSampler::setRule("design", "perf:", 0.05, gameanalytics::SampleByUser));
+    ASSERT_TRUE(gameanalytics::events::GAEventSampler::isActive());
+
+    int kept = 0;
+    for(int i = 0; i < 20000; ++i)
+    {
+        std::string userId = "user_" + std::to_string(i);
+        bool keep = gameanalytics::events::GAEventSampler::keepEvent("design", "perf:fps", userId.c_str(), "session");
+        ASSERT_EQ(keep, gameanalytics::events::GAEventSampler::keepEvent("design", "perf:frame_time", userId.c_str(), "other_session"));
+        kept += keep ? 1 : 0;
+
+        // other categories and prefixes are not sampled
+        ASSERT_TRUE(gameanalytics::events::GAEventSampler::keepEvent("design", "level:start", userId.c_str(), "session"));
+        ASSERT_TRUE(gameanalytics::events::GAEventSampler::keepEvent("business", "perf:fps", userId.c_str(), "session"));
+    }
+    ASSERT_GT(kept, 800);
+    ASSERT_LT(kept, 1200);
+
+    gameanalytics::events::GAEventSampler::clearRules();
+}
+
+TEST(GAEventSampler, testLongestPrefixWins)
+{
+    ASSERT_TRUE(gameanalytics::events::GAEventSampler::setRule("error", "", 0, gameanalytics::SampleBySession));
+    ASSERT_TRUE(gameanalytics::events::GAEventSampler::setRule("error", "crit", 1, gameanalytics::SampleBySession));
+
+    ASSERT_FALSE(gameanalytics::events::GAEventSampler::keepEvent("error", "warning", "user", "session"));
+    ASSERT_TRUE(gameanalytics::events::GAEventSampler::keepEvent("error", "critical", "user", "session"));
+
+    gameanalytics::events::GAEventSampler::clearRules();
+}
+
+TEST(GAEventSampler, testRemoteRules)
+{
+    ASSERT_TRUE(gameanalytics::events::GAEventSampler::setRule("design", "", 1, gameanalytics::SampleByUser));
+    ASSERT_TRUE(gameanalytics::events::GAEventSampler::setRemoteRules("[{\"category\":\"design\",\"prefix\":\"\",\"rate\":0,\"key\":\"session\"}]"));
+    ASSERT_FALSE(gameanalytics::events::GAEventSampler::keepEvent("design", "perf:fps", "user", "session"));
+
+    ASSERT_FALSE(gameanalytics::events::GAEventSampler::setRemoteRules("{\"category\":\"design\"}"));
+    ASSERT_TRUE(gameanalytics::events::GAEventSampler::keepEvent("design", "perf:fps", "user", "session"));
+
+    ASSERT_FALSE(gameanalytics::events::GAEventSampler::setRule("user", "", 0.5, gameanalytics::SampleByUser));
+    ASSERT_FALSE(gameanalytics::events::GAEventSampler::setRule("design", "", 1.5, gameanalytics::SampleByUser));
+
+    gameanalytics::events::GAEventSampler::clearRules();
+    gameanalytics::events::GAEventSampler::setRemoteRules(nullptr);
+}
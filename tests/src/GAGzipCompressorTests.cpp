@@ -0,0 +1,127 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GAGzipCompressor.h>
+#include <string>
+#include <string.h>
+
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "miniz.c"
+
+using gameanalytics::utilities::GAGzipCompressor;
+
+namespace
+{
+    std::string sampleBatch(int events)
+    {
+        std::string batch = "[";
+        for(int n = 0; n < events; ++n)
+        {
+            char event[512] = "";
+            snprintf(event, sizeof(event), "%s{\"category\":\"design\",\"event_id\":\"level:%d:score\",\"value\":%d,\"session_num\":3,\"client_ts\":%d,\"user_id\":\"5a1b6c0e-2f3d-4c5e-9a8b-7c6d5e4f3a2b\",\"platform\":\"linux\",\"sdk_version\":\"cpp 4.0.0\"}", n > 0 ? "," : "", n % 20, n * 7, 1600000000 + n);
+            batch += event;
+        }
+        batch += "]";
+        return batch;
+    }
+
+    std::string gunzip(const std::vector<char>& gzip)
+    {
+        const size_t headerSize = 10;
+        const size_t trailerSize = 8;
+        if(gzip.size() < headerSize + trailerSize)
+        {
+            return "";
+        }
+        size_t outLen = 0;
+        void* out = tinfl_decompress_mem_to_heap(gzip.data() + headerSize, gzip.size() - headerSize - trailerSize, &outLen, 0);
+        std::string result(static_cast<char*>(out), outLen);
+        mz_free(out);
+        return result;
+    }
+
+    uint32_t readLittleEndian(const std::vector<char>& data, size_t offset)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data()) + offset;
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+}
+
+TEST(GAGzipCompressor, testRoundTrip)
+{
+    GAGzipCompressor compressor;
+    std::string batch = sampleBatch(200);
+    std::vector<char> out;
+
+    for(int level = GAGzipCompressor::MinLevel; level <= GAGzipCompressor::MaxLevel; ++level)
+    {
+        ASSERT_TRUE(compressor.setLevel(level));
+        ASSERT_TRUE(compressor.compress(batch.c_str(), batch.size(), out));
+        ASSERT_LT(out.size(), batch.size() / 4);
+        ASSERT_EQ(0x1f, static_cast<unsigned char>(out[0]));
+        ASSERT_EQ(0x8b, static_cast<unsigned char>(out[1]));
+        ASSERT_EQ(batch, gunzip(out));
+        ASSERT_EQ(mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const unsigned char*>(batch.c_str()), batch.size()), readLittleEndian(out, out.size() - 8));
+        ASSERT_EQ(batch.size(), readLittleEndian(out, out.size() - 4));
+    }
+}
+
+TEST(GAGzipCompressor, testReuseAndStrategy)
+{
+    GAGzipCompressor compressor;
+    std::vector<char> out;
+    std::string small = sampleBatch(3);
+    std::string large = sampleBatch(500);
+
+    ASSERT_TRUE(compressor.compress(large.c_str(), large.size(), out));
+    ASSERT_EQ(large, gunzip(out));
+    ASSERT_TRUE(compressor.compress(small.c_str(), small.size(), out));
+    ASSERT_EQ(small, gunzip(out));
+
+    compressor.setStrategy(gameanalytics::CompressionHuffmanOnly);
+    ASSERT_TRUE(compressor.compress(small.c_str(), small.size(), out));
+    ASSERT_EQ(small, gunzip(out));
+
+    ASSERT_TRUE(compressor.compress("", 0, out));
+    ASSERT_EQ("", gunzip(out));
+
+    ASSERT_FALSE(compressor.setLevel(0));
+    ASSERT_FALSE(compressor.setLevel(10));
+}
+
+TEST(GAGzipCompressor, testOutputSink)
+{
+    GAGzipCompressor compressor;
+    std::string batch = sampleBatch(2000);
+    std::vector<char> out;
+    std::vector<char> streamed;
+    size_t pieces = 0;
+
+    ASSERT_TRUE(compressor.compress(batch.c_str(), batch.size(), out, [&streamed, &pieces](const char* data, size_t size)
+    {
+        streamed.insert(streamed.end(), data, data + size);
+        pieces++;
+    }));
+    ASSERT_EQ(out, streamed);
+    ASSERT_GT(pieces, 2u);
+    ASSERT_EQ(batch, gunzip(out));
+}
+
+TEST(GAGzipCompressor, testAdaptiveLevel)
+{
+    // moves one step at a time towards the level for the link
+    ASSERT_EQ(5, GAGzipCompressor::adaptiveLevel(6, 10 * 1024 * 1024, 0.001, 0.005));
+    ASSERT_EQ(7, GAGzipCompressor::adaptiveLevel(6, 16 * 1024, 0.001, 0.005));
+    ASSERT_EQ(GAGzipCompressor::DefaultLevel, GAGzipCompressor::adaptiveLevel(GAGzipCompressor::DefaultLevel, 0, 0.001, 0.005));
+    ASSERT_EQ(GAGzipCompressor::MaxLevel, GAGzipCompressor::adaptiveLevel(9, 16 * 1024, 0.001, 0.005));
+
+    // over the CPU budget the level goes down even on a slow link
+    ASSERT_EQ(8, GAGzipCompressor::adaptiveLevel(9, 16 * 1024, 0.01, 0.005));
+    ASSERT_EQ(GAGzipCompressor::MinLevel, GAGzipCompressor::adaptiveLevel(1, 16 * 1024, 0.01, 0.005));
+}
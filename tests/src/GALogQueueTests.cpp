@@ -0,0 +1,106 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GALogQueue.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+using gameanalytics::logging::GALogQueue;
+using gameanalytics::logging::GALogEntry;
+
+TEST(GALogQueue, testPushPop)
+{
+    GALogQueue queue(3);
+    ASSERT_EQ(4u, queue.capacity());
+
+    GALogEntry entry;
+    ASSERT_FALSE(queue.pop(entry));
+
+    std::string first("first");
+    std::string second("second");
+    ASSERT_TRUE(queue.push(gameanalytics::logging::Warning, first));
+    ASSERT_TRUE(queue.push(gameanalytics::logging::Info, second));
+    ASSERT_TRUE(first.empty());
+
+    ASSERT_TRUE(queue.pop(entry));
+    ASSERT_EQ(gameanalytics::logging::Warning, entry.type);
+    ASSERT_EQ("first", entry.message);
+    ASSERT_TRUE(queue.pop(entry));
+    ASSERT_EQ("second", entry.message);
+    ASSERT_FALSE(queue.pop(entry));
+}
+
+TEST(GALogQueue, testDropsWhenFull)
+{
+    GALogQueue queue(4);
+    for(int i = 0; i < 6; ++i)
+    {
+        std::string message("line");
+        bool pushed = queue.push(gameanalytics::logging::Info, message);
+        ASSERT_EQ(i < 4, pushed);
+    }
+    ASSERT_EQ(2u, queue.takeDropped());
+    ASSERT_EQ(0u, queue.takeDropped());
+
+    // freed cells are used again
+    GALogEntry entry;
+    ASSERT_TRUE(queue.pop(entry));
+    std::string message("again");
+    ASSERT_TRUE(queue.push(gameanalytics::logging::Info, message));
+}
+
+TEST(GALogQueue, testManyProducers)
+{
+    const int producers = 4;
+    const int perProducer = 20000;
+    GALogQueue queue(256);
+
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; ++p)
+    {
+        threads.push_back(std::thread([&queue, p, perProducer]()
+        {
+            for(int i = 0; i < perProducer; ++i)
+            {
+                char line[32] = "";
+                snprintf(line, sizeof(line), "%d:%d", p, i);
+                std::string message(line);
+                while(!queue.push(gameanalytics::logging::Info, message))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    // every line arrives once and in order per producer
+    std::vector<int> next(producers, 0);
+    GALogEntry entry;
+    int received = 0;
+    while(received < producers * perProducer)
+    {
+        if(!queue.pop(entry))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        int p = 0;
+        int i = 0;
+        ASSERT_EQ(2, sscanf(entry.message.c_str(), "%d:%d", &p, &i));
+        ASSERT_EQ(next[p], i);
+        ++next[p];
+        ++received;
+    }
+
+    for(size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    }
+    ASSERT_FALSE(queue.pop(entry));
+}
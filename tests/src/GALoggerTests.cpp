@@ -0,0 +1,43 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GALogger.h>
+
+using gameanalytics::logging::GALogger;
+
+namespace
+{
+    int evaluated = 0;
+
+    const char* countedArgument()
+    {
+        ++evaluated;
+        return "argument";
+    }
+}
+
+TEST(GALogger, testDisabledLevelSkipsArguments)
+{
+    evaluated = 0;
+    GALogger::setInfoLog(false);
+    GALogger::setVerboseInfoLog(false);
+    GA_LOG_INFO("info %s", countedArgument());
+    GA_LOG_VERBOSE("verbose %s", countedArgument());
+    ASSERT_EQ(0, evaluated);
+
+    GALogger::setInfoLog(true);
+    GA_LOG_INFO("info %s", countedArgument());
+    ASSERT_EQ(1, evaluated);
+    GALogger::setInfoLog(false);
+
+#if GA_LOG_LEVEL < GA_LOG_LEVEL_DEBUG
+    // compiled out, not even evaluated in debug sessions
+    GA_LOG_DEBUG("debug %s", countedArgument());
+    ASSERT_EQ(1, evaluated);
+#endif
+}
@@ -0,0 +1,161 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GAMetrics.h>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+using gameanalytics::GAMetricsHistogram;
+using gameanalytics::GAMetricsSnapshot;
+using gameanalytics::metrics::GAHistogram;
+using gameanalytics::metrics::GAMetrics;
+
+namespace
+{
+    const double Bounds[GAMetricsHistogram::BucketCount - 1] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+}
+
+TEST(GAMetrics, testHistogram)
+{
+    GAHistogram histogram;
+    histogram.setBounds(Bounds);
+    histogram.record(0.5);
+    // a value on a bound belongs to that bucket
+    histogram.record(1);
+    histogram.record(1.5);
+    histogram.record(100);
+
+    GAMetricsHistogram out;
+    histogram.snapshot(out);
+    ASSERT_EQ(4u, out.count);
+    ASSERT_DOUBLE_EQ(103, out.sum);
+    ASSERT_DOUBLE_EQ(100, out.max);
+    ASSERT_EQ(2u, out.counts[0]);
+    ASSERT_EQ(1u, out.counts[1]);
+    ASSERT_EQ(1u, out.counts[GAMetricsHistogram::BucketCount - 1]);
+    ASSERT_DOUBLE_EQ(15, out.bounds[GAMetricsHistogram::BucketCount - 2]);
+
+    histogram.reset();
+    histogram.snapshot(out);
+    ASSERT_EQ(0u, out.count);
+    ASSERT_EQ(0u, out.counts[0]);
+}
+
+TEST(GAMetrics, testConcurrentRecording)
+{
+    GAHistogram histogram;
+    histogram.setBounds(Bounds);
+    const int threadCount = 4;
+    const int perThread = 10000;
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < threadCount; ++t)
+    {
+        threads.push_back(std::thread([&histogram, t]()
+        {
+            for(int i = 0; i < perThread; ++i)
+            {
+                histogram.record(t + 1);
+            }
+        }));
+    }
+    for(size_t t = 0; t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+
+    GAMetricsHistogram out;
+    histogram.snapshot(out);
+    ASSERT_EQ(static_cast<uint64_t>(threadCount * perThread), out.count);
+    ASSERT_DOUBLE_EQ(perThread * (1 + 2 + 3 + 4), out.sum);
+    ASSERT_DOUBLE_EQ(threadCount, out.max);
+    for(int t = 0; t < threadCount; ++t)
+    {
+        ASSERT_EQ(static_cast<uint64_t>(perThread), out.counts[t]);
+    }
+}
+
+TEST(GAMetrics, testSnapshot)
+{
+    // a registry of its own, the SDK records into the process wide one while tests run
+    gameanalytics::metrics::GAMetricsRegistry registry;
+    registry.add(gameanalytics::metrics::EventsStored, 3);
+    registry.add(gameanalytics::metrics::EventsSent, 2);
+    registry.recordStatusCode(200);
+    registry.recordStatusCode(201);
+    registry.recordStatusCode(401);
+    registry.recordStatusCode(503);
+    registry.recordStatusCode(0);
+    registry.recordStatusCode(302);
+    registry.setStoreSize(4096, 7);
+    registry.record(gameanalytics::metrics::BatchSize, 50);
+
+    GAMetricsSnapshot snapshot = GAMetricsSnapshot();
+    registry.snapshot(snapshot);
+    ASSERT_EQ(3u, snapshot.eventsStored);
+    ASSERT_EQ(2u, snapshot.eventsSent);
+    ASSERT_EQ(2u, snapshot.http2xx);
+    ASSERT_EQ(1u, snapshot.http4xx);
+    ASSERT_EQ(1u, snapshot.http5xx);
+    ASSERT_EQ(1u, snapshot.httpNoResponse);
+    ASSERT_EQ(1u, snapshot.httpOther);
+    ASSERT_EQ(4096u, snapshot.dbSizeBytes);
+    ASSERT_EQ(7u, snapshot.dbEventRows);
+    ASSERT_EQ(1u, snapshot.batchSize.count);
+    ASSERT_DOUBLE_EQ(50, snapshot.batchSize.max);
+    ASSERT_DOUBLE_EQ(50, snapshot.batchSize.bounds[5]);
+
+    registry.reset();
+    registry.snapshot(snapshot);
+    ASSERT_EQ(0u, snapshot.eventsStored);
+    ASSERT_EQ(0u, snapshot.dbEventRows);
+    ASSERT_EQ(0u, snapshot.batchSize.count);
+}
+
+TEST(GAMetrics, testTimer)
+{
+    // only grows, other threads may record too
+    uint64_t queries = GAMetrics::snapshot().queryTime.count;
+    {
+        gameanalytics::metrics::GAMetricsTimer timer(gameanalytics::metrics::QueryTime);
+    }
+    ASSERT_LT(queries, GAMetrics::snapshot().queryTime.count);
+}
+
+TEST(GAMetrics, testExport)
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    int exports = 0;
+
+    GAMetrics::setExport(1, [&](const GAMetricsSnapshot&)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        ++exports;
+        cv.notify_one();
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&exports]() { return exports > 0; }));
+    }
+
+    GAMetrics::setExport(1, gameanalytics::GAMetricsCallback());
+    // an export that was already running may still finish
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    int stoppedAt = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stoppedAt = exports;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    std::lock_guard<std::mutex> lock(mtx);
+    ASSERT_EQ(stoppedAt, exports);
+}
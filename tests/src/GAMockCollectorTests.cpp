@@ -0,0 +1,154 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GAMockCollector.h>
+#include <GAGzipCompressor.h>
+#include "rapidjson/document.h"
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using gameanalytics::http::GAMockCollector;
+
+namespace
+{
+    gameanalytics::GATransportRequest eventsRequest(const std::vector<char>& body, bool gzip)
+    {
+        gameanalytics::GATransportRequest request = {gameanalytics::TransportEvents, "http://localhost/v2/key/events", body.data(), body.size(), "signature", gzip};
+        return request;
+    }
+
+    std::string eventArray(int count)
+    {
+        std::string json = "[";
+        for(int i = 0; i < count; ++i)
+        {
+            json += i > 0 ? ",{\"category\":\"design\"}" : "{\"category\":\"design\"}";
+        }
+        return json + "]";
+    }
+}
+
+TEST(GAMockCollector, testInitAndEvents)
+{
+    GAMockCollector collector(1);
+
+    std::vector<char> init(2, '{');
+    init[1] = '}';
+    gameanalytics::GATransportRequest initRequest = {gameanalytics::TransportInit, "http://localhost/init", init.data(), init.size(), "signature", false};
+    gameanalytics::GATransportResponse response = collector.send(initRequest);
+    ASSERT_EQ(201, response.statusCode);
+    rapidjson::Document json;
+    json.Parse(response.body.c_str());
+    ASSERT_TRUE(json.HasMember("server_ts"));
+
+    std::string events = eventArray(10);
+    std::vector<char> body(events.begin(), events.end());
+    ASSERT_EQ(200, collector.send(eventsRequest(body, false)).statusCode);
+
+    std::vector<char> gzipped;
+    gameanalytics::utilities::GAGzipCompressor compressor;
+    ASSERT_TRUE(compressor.compress(events.c_str(), events.size(), gzipped));
+    ASSERT_EQ(200, collector.send(eventsRequest(gzipped, true)).statusCode);
+
+    ASSERT_EQ(3u, collector.requests());
+    ASSERT_EQ(20u, collector.eventsAccepted());
+    ASSERT_EQ(body.size() + gzipped.size() + init.size(), collector.payloadBytes());
+}
+
+TEST(GAMockCollector, testFailures)
+{
+    GAMockCollector collector(2);
+    std::string events = eventArray(50);
+    std::vector<char> body(events.begin(), events.end());
+
+    collector.setBadEventRate(1);
+    gameanalytics::GATransportResponse response = collector.send(eventsRequest(body, false));
+    ASSERT_EQ(400, response.statusCode);
+    rapidjson::Document json;
+    json.Parse(response.body.c_str());
+    ASSERT_TRUE(json.IsArray());
+    ASSERT_EQ(50u, json.Size());
+    ASSERT_EQ(50u, collector.eventsRejected());
+    collector.setBadEventRate(0);
+
+    collector.setServerErrorRate(1);
+    ASSERT_EQ(500, collector.send(eventsRequest(body, false)).statusCode);
+    collector.setServerErrorRate(0);
+
+    collector.setDropRate(1);
+    response = collector.send(eventsRequest(body, false));
+    ASSERT_EQ(0, response.statusCode);
+    ASSERT_TRUE(response.body.empty());
+    collector.setDropRate(0);
+
+    std::vector<char> garbage(3, 'x');
+    ASSERT_EQ(400, collector.send(eventsRequest(garbage, true)).statusCode);
+    ASSERT_EQ(0u, collector.eventsAccepted());
+}
+
+TEST(GAMockCollector, testAsyncLatency)
+{
+    GAMockCollector collector(3);
+    std::string events = eventArray(5);
+    std::vector<char> body(events.begin(), events.end());
+
+    std::mutex mtx;
+    std::vector<int> answered;
+    std::vector<std::shared_ptr<std::promise<int> > > results;
+    // the slow request is sent first, a fast one must not wait behind it
+    double latencies[] = { 0.3, 0 };
+    for(int i = 0; i < 2; ++i)
+    {
+        collector.setLatency(latencies[i]);
+        std::shared_ptr<std::promise<int> > result = std::make_shared<std::promise<int> >();
+        results.push_back(result);
+        collector.sendAsync(eventsRequest(body, false), [result, i, &mtx, &answered](const gameanalytics::GATransportResponse& response)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                answered.push_back(i);
+            }
+            result->set_value(response.statusCode);
+        });
+    }
+    // the body may go away as soon as sendAsync returns
+    body.assign(body.size(), 'x');
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(collector.waitForEventsAccepted(10, 5));
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        ASSERT_EQ(200, results[i]->get_future().get());
+    }
+    ASSERT_GE(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 0.2);
+    std::lock_guard<std::mutex> lock(mtx);
+    ASSERT_EQ(2u, answered.size());
+    ASSERT_EQ(1, answered[0]);
+    ASSERT_EQ(0, answered[1]);
+}
+
+TEST(GAMockCollector, testPendingAnsweredOnDestruction)
+{
+    std::string events = eventArray(5);
+    std::vector<char> body(events.begin(), events.end());
+    int calls = 0;
+    int statusCode = -1;
+    {
+        GAMockCollector collector(4);
+        collector.setLatency(60);
+        collector.sendAsync(eventsRequest(body, false), [&calls, &statusCode](const gameanalytics::GATransportResponse& response)
+        {
+            ++calls;
+            statusCode = response.statusCode;
+        });
+    }
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(0, statusCode);
+}
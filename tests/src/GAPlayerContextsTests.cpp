@@ -0,0 +1,88 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GAPlayerContexts.h>
+#include <stdio.h>
+
+using gameanalytics::state::GAPlayerContexts;
+using gameanalytics::state::GAPlayerContext;
+using gameanalytics::state::GAPlayerContextVector;
+
+namespace
+{
+    std::string playerId(int n)
+    {
+        char id[32] = "";
+        snprintf(id, sizeof(id), "player-%d", n);
+        return id;
+    }
+}
+
+TEST(GAPlayerContexts, testAddGetRemove)
+{
+    GAPlayerContexts players;
+    std::shared_ptr<GAPlayerContext> replaced;
+    GAPlayerContextVector evicted;
+
+    ASSERT_TRUE(players.get("a") == nullptr);
+    std::shared_ptr<GAPlayerContext> a = players.add("a", replaced, evicted);
+    a->sessionNum = 3;
+    ASSERT_FALSE(replaced);
+    ASSERT_EQ("a", a->userId);
+    ASSERT_EQ(a, players.get("a"));
+    ASSERT_EQ(1u, players.size());
+
+    // a new session replaces the old context
+    std::shared_ptr<GAPlayerContext> again = players.add("a", replaced, evicted);
+    ASSERT_EQ(a, replaced);
+    ASSERT_NE(a, again);
+    ASSERT_EQ(0, again->sessionNum);
+    ASSERT_EQ(1u, players.size());
+
+    ASSERT_EQ(again, players.remove("a"));
+    ASSERT_TRUE(players.remove("a") == nullptr);
+    ASSERT_EQ(0u, players.size());
+    ASSERT_TRUE(evicted.empty());
+}
+
+TEST(GAPlayerContexts, testEviction)
+{
+    GAPlayerContexts players;
+    GAPlayerContextVector evicted;
+    players.setMaxPlayers(GAPlayerContexts::ShardCount * 4, evicted);
+
+    std::shared_ptr<GAPlayerContext> replaced;
+    const int count = 1000;
+    for(int i = 0; i < count; ++i)
+    {
+        players.add(playerId(i), replaced, evicted);
+        // keep the first player active
+        ASSERT_TRUE(players.get(playerId(0)) != nullptr);
+    }
+
+    ASSERT_LE(players.size(), GAPlayerContexts::ShardCount * 4);
+    ASSERT_EQ(static_cast<size_t>(count), players.size() + evicted.size());
+    ASSERT_TRUE(players.get(playerId(0)) != nullptr);
+    ASSERT_TRUE(players.get(playerId(count - 1)) != nullptr);
+
+    // evicted contexts are no longer found
+    for(size_t i = 0; i < evicted.size(); ++i)
+    {
+        ASSERT_TRUE(players.get(evicted[i]->userId) == nullptr);
+    }
+
+    size_t kept = players.size();
+    evicted.clear();
+    players.setMaxPlayers(1, evicted);
+    ASSERT_LE(players.size(), GAPlayerContexts::ShardCount);
+
+    GAPlayerContextVector all;
+    players.removeAll(all);
+    ASSERT_EQ(0u, players.size());
+    ASSERT_EQ(kept, all.size() + evicted.size());
+}
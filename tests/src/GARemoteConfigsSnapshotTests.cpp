@@ -0,0 +1,114 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GARemoteConfigsSnapshot.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using gameanalytics::state::GARemoteConfigsSnapshot;
+
+TEST(GARemoteConfigsSnapshot, testValues)
+{
+    rapidjson::Document configurations;
+    configurations.Parse("{\"flag\":\"on\",\"a_rather_long_feature_flag_key\":\"variant_b\",\"count\":42,\"ratio\":0.5}");
+    GARemoteConfigsSnapshot snapshot(configurations, std::vector<const char*>());
+
+    ASSERT_EQ(4u, snapshot.size());
+    ASSERT_STREQ("on", snapshot.getValue("flag"));
+    ASSERT_STREQ("variant_b", snapshot.getValue("a_rather_long_feature_flag_key"));
+    ASSERT_STREQ("42", snapshot.getValue("count"));
+    ASSERT_STREQ("0.5", snapshot.getValue("ratio"));
+    ASSERT_EQ(NULL, snapshot.getValue("missing"));
+    ASSERT_EQ(NULL, snapshot.getValue(NULL));
+
+    // lookups go by content, not by pointer
+    std::string key("flag");
+    ASSERT_EQ(snapshot.getValue("flag"), snapshot.getValue(key.c_str()));
+}
+
+TEST(GARemoteConfigsSnapshot, testContent)
+{
+    rapidjson::Document empty;
+    GARemoteConfigsSnapshot none(empty, std::vector<const char*>());
+    ASSERT_EQ(0u, none.size());
+    ASSERT_STREQ("{}", none.getContent());
+
+    rapidjson::Document first;
+    first.Parse("{\"flag\":\"on\"}");
+    rapidjson::Document second;
+    second.Parse("{\"flag\":\"off\"}");
+    GARemoteConfigsSnapshot a(first, std::vector<const char*>());
+    GARemoteConfigsSnapshot b(first, std::vector<const char*>());
+    GARemoteConfigsSnapshot c(second, std::vector<const char*>());
+    ASSERT_TRUE(a.hasSameContent(b));
+    ASSERT_FALSE(a.hasSameContent(c));
+
+    rapidjson::Document parsed;
+    parsed.Parse(a.getContent());
+    ASSERT_TRUE(parsed.IsObject());
+    ASSERT_STREQ("on", parsed["flag"].GetString());
+}
+
+TEST(GARemoteConfigsSnapshot, testTypedValues)
+{
+    rapidjson::Document configurations;
+    configurations.Parse("{\"count\":42,\"ratio\":0.25,\"text_count\":\"-7\",\"text_ratio\":\"1.5\",\"enabled\":\"true\",\"one\":1,\"name\":\"abc\",\"partial\":\"12abc\"}");
+    std::vector<const char*> registered;
+    registered.push_back("ratio");
+    registered.push_back("missing");
+    GARemoteConfigsSnapshot snapshot(configurations, registered);
+
+    const GARemoteConfigsSnapshot::Value* count = snapshot.find("count");
+    ASSERT_TRUE(count->isInteger);
+    ASSERT_EQ(42, count->integer);
+    ASSERT_TRUE(count->isNumber);
+    ASSERT_FALSE(count->isBool);
+
+    const GARemoteConfigsSnapshot::Value* ratio = snapshot.at(0);
+    ASSERT_EQ(snapshot.find("ratio"), ratio);
+    ASSERT_FALSE(ratio->isInteger);
+    ASSERT_DOUBLE_EQ(0.25, ratio->number);
+    ASSERT_TRUE(snapshot.hasSlot(1));
+    ASSERT_EQ(NULL, snapshot.at(1));
+    ASSERT_FALSE(snapshot.hasSlot(2));
+
+    ASSERT_EQ(-7, snapshot.find("text_count")->integer);
+    ASSERT_DOUBLE_EQ(1.5, snapshot.find("text_ratio")->number);
+    ASSERT_FALSE(snapshot.find("text_ratio")->isInteger);
+    ASSERT_TRUE(snapshot.find("enabled")->isBool);
+    ASSERT_TRUE(snapshot.find("enabled")->boolean);
+    ASSERT_TRUE(snapshot.find("one")->isBool);
+    ASSERT_TRUE(snapshot.find("one")->boolean);
+
+    const GARemoteConfigsSnapshot::Value* name = snapshot.find("name");
+    ASSERT_FALSE(name->isInteger || name->isNumber || name->isBool);
+    ASSERT_FALSE(snapshot.find("partial")->isInteger);
+}
+
+TEST(GARemoteConfigsSnapshot, testChangedKeys)
+{
+    rapidjson::Document first;
+    first.Parse("{\"kept\":\"1\",\"changed\":\"a\",\"removed\":\"x\"}");
+    rapidjson::Document second;
+    second.Parse("{\"kept\":\"1\",\"changed\":\"b\",\"added\":\"y\"}");
+    GARemoteConfigsSnapshot before(first, std::vector<const char*>());
+    GARemoteConfigsSnapshot after(second, std::vector<const char*>());
+
+    std::vector<std::string> changed;
+    after.getChangedKeys(&before, changed);
+    std::sort(changed.begin(), changed.end());
+    ASSERT_EQ(3u, changed.size());
+    ASSERT_EQ("added", changed[0]);
+    ASSERT_EQ("changed", changed[1]);
+    ASSERT_EQ("removed", changed[2]);
+
+    changed.clear();
+    before.getChangedKeys(NULL, changed);
+    ASSERT_EQ(3u, changed.size());
+}
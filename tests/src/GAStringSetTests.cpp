@@ -0,0 +1,54 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GAStringSet.h>
+#include <stdio.h>
+
+using gameanalytics::utilities::GAStringSet;
+
+TEST(GAStringSet, testContains)
+{
+    GAStringSet set;
+    ASSERT_FALSE(set.contains("gems"));
+    ASSERT_FALSE(set.contains(NULL));
+
+    gameanalytics::StringVector currencies;
+    currencies.add("gems").add("gold");
+    set.assign(currencies);
+    ASSERT_EQ(2u, set.size());
+    ASSERT_TRUE(set.contains("gems"));
+    ASSERT_TRUE(set.contains("gold"));
+    ASSERT_FALSE(set.contains("Gold"));
+    ASSERT_FALSE(set.contains(""));
+
+    // the set keeps its own copy of the strings
+    currencies.add("silver");
+    ASSERT_FALSE(set.contains("silver"));
+
+    gameanalytics::StringVector none;
+    set.assign(none);
+    ASSERT_FALSE(set.contains("gems"));
+}
+
+TEST(GAStringSet, testManyItemTypes)
+{
+    gameanalytics::StringVector itemTypes;
+    char itemType[32] = "";
+    for(int i = 0; i < 500; ++i)
+    {
+        snprintf(itemType, sizeof(itemType), "item_type_%d", i);
+        itemTypes.add(itemType);
+    }
+
+    GAStringSet set;
+    set.assign(itemTypes);
+    ASSERT_EQ(500u, set.size());
+    ASSERT_TRUE(set.contains("item_type_0"));
+    ASSERT_TRUE(set.contains("item_type_499"));
+    ASSERT_FALSE(set.contains("item_type_500"));
+}
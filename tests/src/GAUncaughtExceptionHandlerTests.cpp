@@ -0,0 +1,129 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <GAUncaughtExceptionHandler.h>
+#include <stdio.h>
+
+using gameanalytics::errorreporter::GAUncaughtExceptionHandler;
+using gameanalytics::errorreporter::GACrashRecord;
+
+TEST(GAUncaughtExceptionHandler, testCrashRecordSurvivesRestart)
+{
+    const char* path = "ga_crash_test.bin";
+    remove(path);
+
+    ASSERT_TRUE(GAUncaughtExceptionHandler::openCrashRecord(path));
+    ASSERT_FALSE(GAUncaughtExceptionHandler::hasPreviousCrash());
+    GAUncaughtExceptionHandler::setCrashSession("e1b8ff4b-5e2d-4b0c-8b1d-1d0d9a2b1c01", 7);
+
+    // only the first crash of a run is kept
+    GAUncaughtExceptionHandler::writeCrashRecord(gameanalytics::errorreporter::CrashKindSignal, SIGSEGV, 1, reinterpret_cast<void*>(0x10), 0);
+    GAUncaughtExceptionHandler::writeCrashRecord(gameanalytics::errorreporter::CrashKindSignal, SIGABRT, 0, NULL, 0);
+    GAUncaughtExceptionHandler::closeCrashRecord();
+
+    // next launch
+    ASSERT_TRUE(GAUncaughtExceptionHandler::openCrashRecord(path));
+    ASSERT_TRUE(GAUncaughtExceptionHandler::hasPreviousCrash());
+    GAUncaughtExceptionHandler::closeCrashRecord();
+
+    // not reported in that run, so still there on the one after
+    ASSERT_TRUE(GAUncaughtExceptionHandler::openCrashRecord(path));
+    ASSERT_TRUE(GAUncaughtExceptionHandler::hasPreviousCrash());
+    GAUncaughtExceptionHandler::reportPreviousCrash();
+    ASSERT_FALSE(GAUncaughtExceptionHandler::hasPreviousCrash());
+    GAUncaughtExceptionHandler::closeCrashRecord();
+
+    // and cleared once it has been reported
+    ASSERT_TRUE(GAUncaughtExceptionHandler::openCrashRecord(path));
+    ASSERT_FALSE(GAUncaughtExceptionHandler::hasPreviousCrash());
+    GAUncaughtExceptionHandler::closeCrashRecord();
+    remove(path);
+}
+
+namespace
+{
+    void fillRecord(GACrashRecord& record, unsigned long long loadAddress)
+    {
+        record = GACrashRecord();
+        record.signal = SIGSEGV;
+        record.moduleCount = 1;
+        snprintf(record.modules[0].name, sizeof(record.modules[0].name), "%s", "libgame.so");
+        record.modules[0].base = loadAddress;
+        record.modules[0].begin = loadAddress;
+        record.modules[0].end = loadAddress + 0x100000;
+        record.frameCount = 3;
+        record.frames[0] = loadAddress + 0x1000;
+        record.frames[1] = loadAddress + 0x2000;
+        // outside every module
+        record.frames[2] = 0x10;
+    }
+}
+
+TEST(GAUncaughtExceptionHandler, testCrashMessage)
+{
+    GACrashRecord record;
+    fillRecord(record, 0x7f0000000000ULL);
+    snprintf(record.sessionId, sizeof(record.sessionId), "%s", "e1b8ff4b-5e2d-4b0c-8b1d-1d0d9a2b1c01");
+
+    std::string message;
+    GAUncaughtExceptionHandler::crashMessage(record, message);
+    char expected[32] = "";
+    snprintf(expected, sizeof(expected), "Uncaught Signal (%d)", SIGSEGV);
+    ASSERT_NE(std::string::npos, message.find(expected));
+    ASSERT_NE(std::string::npos, message.find("   0 - libgame.so+0x1000\n"));
+    ASSERT_NE(std::string::npos, message.find("   1 - libgame.so+0x2000\n"));
+    ASSERT_NE(std::string::npos, message.find("   2 - 0x0000000000000010\n"));
+    // the message is the same for every run, the session goes into the fields
+    ASSERT_EQ(std::string::npos, message.find(record.sessionId));
+}
+
+TEST(GAUncaughtExceptionHandler, testCrashFingerprint)
+{
+    GACrashRecord first;
+    GACrashRecord relocated;
+    fillRecord(first, 0x7f0000000000ULL);
+    fillRecord(relocated, 0x5500000000ULL);
+    relocated.frames[2] = 0x20;
+
+    char a[17] = "";
+    char b[17] = "";
+    GAUncaughtExceptionHandler::crashFingerprint(first, a);
+    GAUncaughtExceptionHandler::crashFingerprint(relocated, b);
+    ASSERT_EQ(16u, strlen(a));
+    ASSERT_STREQ(a, b);
+
+    relocated.frames[1] += 4;
+    GAUncaughtExceptionHandler::crashFingerprint(relocated, b);
+    ASSERT_STRNE(a, b);
+
+    fillRecord(relocated, 0x5500000000ULL);
+    relocated.signal = SIGBUS;
+    GAUncaughtExceptionHandler::crashFingerprint(relocated, b);
+    ASSERT_STRNE(a, b);
+}
+
+TEST(GAUncaughtExceptionHandler, testLoadedModules)
+{
+    stacktrace::loaded_module modules[GACrashRecord::MaxModules];
+    size_t count = stacktrace::loaded_modules(modules, GACrashRecord::MaxModules);
+    ASSERT_GT(count, 0u);
+
+    // this test is in one of them
+    unsigned long long address = reinterpret_cast<unsigned long long>(&fillRecord);
+    bool found = false;
+    for(size_t i = 0; i < count; ++i)
+    {
+        if(address >= modules[i].begin && address < modules[i].end)
+        {
+            ASSERT_NE('\0', modules[i].name[0]);
+            ASSERT_LE(modules[i].base, address);
+            found = true;
+        }
+    }
+    ASSERT_TRUE(found);
+}
@@ -67,6 +67,24 @@ TEST(GAUtilities, testHmacWithKey)
     }
 }
 
+TEST(GAUtilities, testHmacContextCache)
+{
+    // the cached keyed state must follow key changes and give the same MAC as a fresh key
+    char mac[257] = "";
+    gameanalytics::utilities::GAUtilities::hmacWithKey("other", {'t','e','s','t','2'}, mac);
+    ASSERT_STRNE(mac, "E+sBF4BA9mLvVlfwHx53G2poUPwEUZ1f37oVrgHhOFQ=");
+
+    hmac_sha256_ctx ctx;
+    gameanalytics::utilities::GAUtilities::hmacContextForKey("test1", ctx);
+    hmac_sha256_update(&ctx, reinterpret_cast<const unsigned char*>("te"), 2);
+    hmac_sha256_update(&ctx, reinterpret_cast<const unsigned char*>("st2"), 3);
+    gameanalytics::utilities::GAUtilities::hmacFinalBase64(ctx, mac);
+    ASSERT_STREQ(mac, "E+sBF4BA9mLvVlfwHx53G2poUPwEUZ1f37oVrgHhOFQ=");
+
+    gameanalytics::utilities::GAUtilities::hmacWithKey("test1", {'t','e','s','t','2'}, mac);
+    ASSERT_STREQ(mac, "E+sBF4BA9mLvVlfwHx53G2poUPwEUZ1f37oVrgHhOFQ=");
+}
+
 TEST(GAUtilities, testGzip)
 {
     rapidjson::Document d;
@@ -106,6 +124,16 @@ TEST(GAUtilities, testGzip)
     }
 }
 
+TEST(GAUtilities, testFnv1a)
+{
+    ASSERT_EQ(14695981039346656037ULL, gameanalytics::utilities::GAUtilities::fnv1a(""));
+    ASSERT_EQ(0xaf63dc4c8601ec8cULL, gameanalytics::utilities::GAUtilities::fnv1a("a"));
+    ASSERT_EQ(0x85944171f73967e8ULL, gameanalytics::utilities::GAUtilities::fnv1a("foobar"));
+    // continuing a hash is the same as hashing the joined string
+    ASSERT_EQ(gameanalytics::utilities::GAUtilities::fnv1a("foobar"), gameanalytics::utilities::GAUtilities::fnv1a(gameanalytics::utilities::GAUtilities::fnv1a("foo"), "bar"));
+    ASSERT_EQ(gameanalytics::utilities::GAUtilities::fnv1a("foo"), gameanalytics::utilities::GAUtilities::fnv1a(gameanalytics::utilities::GAUtilities::Fnv1aOffsetBasis, "foobar", 3));
+}
+
 TEST(GAUtilities, testGenerateUUID)
 {
     char guid[65] = "";
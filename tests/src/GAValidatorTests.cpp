@@ -10,8 +10,12 @@
 #include <GAState.h>
 #include <GALogger.h>
 #include <random>
+#include <regex>
+#include <chrono>
+#include <iostream>
 #include <GameAnalytics.h>
 #include <GAUtilities.h>
+#include <GACharacterClass.h>
 
 // test helpers
 #include "helpers/GATestHelpers.h"
@@ -696,3 +700,91 @@ TEST(GAValidator, testValidateUserId)
 
     ASSERT_FALSE(gameanalytics::validators::GAValidator::validateUserId(""));
 }
+
+TEST(GAValidator, testCompiledMatchersAgainstRegex)
+{
+    const std::regex keyRegex("^[A-z0-9]{32}$");
+    const std::regex secretRegex("^[A-z0-9]{40}$");
+    const std::regex currencyRegex("^[A-Z]{3}$");
+    const std::regex eventPartRegex("^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}$");
+    const std::regex eventIdLengthRegex("^[^:]{1,64}(?::[^:]{1,64}){0,4}$");
+    const std::regex eventIdCharactersRegex("^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}(:[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}){0,4}$");
+    const std::regex fieldKeyRegex("^[a-zA-Z0-9_]{1,64}$");
+    const std::regex alphaRegex("^[A-Za-z]+$");
+
+    std::vector<std::string> inputs;
+
+    // every byte on its own, embedded in otherwise valid strings and as a segment
+    for (int c = 1; c < 256; ++c)
+    {
+        std::string ch(1, static_cast<char>(c));
+        inputs.push_back(ch);
+        inputs.push_back("AB" + ch);
+        inputs.push_back("abc" + ch + "def");
+        inputs.push_back(std::string(31, 'a') + ch);
+        inputs.push_back(std::string(39, 'a') + ch);
+        inputs.push_back("part:" + ch + ":part");
+    }
+
+    // length boundaries
+    for (size_t length = 0; length <= 70; ++length)
+    {
+        inputs.push_back(std::string(length, 'a'));
+        inputs.push_back(std::string(length, 'A'));
+        inputs.push_back(std::string(length, '_'));
+    }
+
+    // segment count and segment length boundaries
+    const size_t segmentLengths[] = { 0, 1, 63, 64, 65 };
+    for (size_t segments = 1; segments <= 6; ++segments)
+    {
+        for (size_t segmentLength : segmentLengths)
+        {
+            for (size_t position = 0; position < segments; ++position)
+            {
+                std::string eventId;
+                for (size_t j = 0; j < segments; ++j)
+                {
+                    if (j > 0)
+                    {
+                        eventId += ":";
+                    }
+                    eventId += std::string(j == position ? segmentLength : 4, 'x');
+                }
+                inputs.push_back(eventId);
+            }
+        }
+    }
+    inputs.push_back(":");
+    inputs.push_back("a::b");
+
+    for (const std::string& input : inputs)
+    {
+        const char* s = input.c_str();
+        ASSERT_EQ(std::regex_match(s, keyRegex), gameanalytics::validators::GAValidator::validateKeys(s, GATestHelpers::get40CharsString().c_str())) << input;
+        ASSERT_EQ(std::regex_match(s, secretRegex), gameanalytics::validators::GAValidator::validateKeys(GATestHelpers::get32CharsString().c_str(), s)) << input;
+        ASSERT_EQ(std::regex_match(s, currencyRegex), gameanalytics::validators::GAValidator::validateCurrency(s)) << input;
+        ASSERT_EQ(std::regex_match(s, eventPartRegex), gameanalytics::validators::GAValidator::validateEventPartCharacters(s)) << input;
+        ASSERT_EQ(std::regex_match(s, eventIdLengthRegex), gameanalytics::validators::GAValidator::validateEventIdLength(s)) << input;
+        ASSERT_EQ(std::regex_match(s, eventIdCharactersRegex), gameanalytics::validators::GAValidator::validateEventIdCharacters(s)) << input;
+        ASSERT_EQ(std::regex_match(s, fieldKeyRegex), gameanalytics::utilities::GACharacterClass::matchesClass(s, gameanalytics::utilities::FieldKeyCharacter, 1, 64)) << input;
+        ASSERT_EQ(std::regex_match(s, alphaRegex), gameanalytics::utilities::GACharacterClass::matchesClass(s, gameanalytics::utilities::AlphaCharacter, 1, SIZE_MAX)) << input;
+    }
+}
+
+TEST(GAValidator, testValidateDesignEventBenchmark)
+{
+    const char* eventIds[] = { "level:boss_01:attempt", "ui:shop:open", "gameplay:weapon_fired:rifle:(alt)!", "tutorial:step_5" };
+    const int iterations = 100000;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        gameanalytics::validators::ValidationResult validationResult;
+        gameanalytics::validators::GAValidator::validateDesignEvent(eventIds[i % 4], validationResult);
+        ASSERT_TRUE(validationResult.result);
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "validateDesignEvent: " << elapsed / iterations << " ns/event" << std::endl;
+}
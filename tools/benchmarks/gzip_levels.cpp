@@ -0,0 +1,146 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+// Size, ratio and time per event batch for every GAGzipCompressor level,
+// next to the old gzipCompress (a new level 9 deflate stream per payload).
+//
+// Build it like a test, with the SDK include paths and linked against the
+// SDK objects (GAGzipCompressor logs through GALogger), e.g. with the
+// objects of the test build in sdk/:
+//
+//   g++ -std=c++11 -O2 -DUSE_LINUX -Isource/gameanalytics -Isource/dependencies/miniz
+//       -Isource/dependencies/rapidjson -Isource/dependencies/zf_log
+//       tools/benchmarks/gzip_levels.cpp sdk/*.o -lcurl -lssl -lcrypto -lsqlite3 -luuid -lpthread
+//
+// Averages over 200 runs, batches of 50, 200 and 500 events.
+
+#include "GAGzipCompressor.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "miniz.c"
+
+using gameanalytics::utilities::GAGzipCompressor;
+
+namespace
+{
+    const int Iterations = 200;
+
+    // the compression of gzipCompress before GAGzipCompressor replaced it
+    std::vector<char> oldGzip(const std::string& input)
+    {
+        mz_stream zs;
+        memset(&zs, 0, sizeof(zs));
+        mz_deflateInit2(&zs, 9, MZ_DEFLATED, -MZ_DEFAULT_WINDOW_BITS, 9, MZ_DEFAULT_STRATEGY);
+        zs.next_in = reinterpret_cast<const unsigned char*>(input.data());
+        zs.avail_in = static_cast<unsigned int>(input.size());
+
+        static char chunk[32768];
+        std::vector<char> deflated;
+        int ret;
+        do
+        {
+            zs.next_out = reinterpret_cast<unsigned char*>(chunk);
+            zs.avail_out = sizeof(chunk);
+            ret = mz_deflate(&zs, MZ_FINISH);
+            // grown one byte at a time, as the old code did
+            size_t produced = sizeof(chunk) - zs.avail_out;
+            for(size_t i = 0; i < produced; ++i)
+            {
+                deflated.push_back(chunk[i]);
+            }
+        } while(ret == MZ_OK);
+        mz_deflateEnd(&zs);
+
+        static const char header[10] = { '\037', '\213', MZ_DEFLATED, 0, 0, 0, 0, 0, 0, 3 };
+        uint32_t crc = static_cast<uint32_t>(mz_crc32(0, reinterpret_cast<const unsigned char*>(input.data()), input.size()));
+        uint32_t size = static_cast<uint32_t>(input.size());
+
+        std::vector<char> result;
+        for(size_t i = 0; i < sizeof(header); ++i)
+        {
+            result.push_back(header[i]);
+        }
+        for(size_t i = 0; i < deflated.size(); ++i)
+        {
+            result.push_back(deflated[i]);
+        }
+        for(int i = 0; i < 4; ++i)
+        {
+            result.push_back(static_cast<char>((crc >> (8 * i)) & 0xff));
+        }
+        for(int i = 0; i < 4; ++i)
+        {
+            result.push_back(static_cast<char>((size >> (8 * i)) & 0xff));
+        }
+        return result;
+    }
+
+    // a batch of events shaped like the ones the SDK sends
+    std::string makeBatch(int events)
+    {
+        const char* ids[] = { "level:01:start", "level:01:complete", "shop:open", "perf:fps", "ui:button:play", "ad:rewarded:shown" };
+        const char* categories[] = { "design", "design", "design", "progression", "business", "resource" };
+        std::string batch = "[";
+        for(int n = 0; n < events; ++n)
+        {
+            char event[1024];
+            snprintf(event, sizeof(event),
+                "%s{\"category\":\"%s\",\"event_id\":\"%s\",\"value\":%d.%d,\"v\":2,\"user_id\":\"5a1b6c0e-2f3d-4c5e-9a8b-%012d\",\"client_ts\":%d,"
+                "\"sdk_version\":\"cpp 4.1.0\",\"os_version\":\"linux 5.15.0\",\"manufacturer\":\"unknown\",\"device\":\"unknown\",\"platform\":\"linux\","
+                "\"session_id\":\"e4d7c3b2-9a8f-4e6d-b5c4-%012d\",\"session_num\":%d,\"connection_type\":\"wifi\",\"build\":\"1.4.2\",\"custom_01\":\"ninja\","
+                "\"custom_02\":\"%s\",\"engine_version\":\"unreal 4.27.2\",\"custom_fields\":{\"difficulty\":%d,\"run\":%d}}",
+                n ? "," : "", categories[n % 6], ids[(n * 7) % 6], (n * 37) % 1000, n % 10, 42, 1700000000 + n / 3, 77, 3 + n / 200, n % 3 ? "free" : "paid", n % 5, n);
+            batch += event;
+        }
+        return batch + "]";
+    }
+
+    double millisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main()
+{
+    const int sizes[] = { 50, 200, 500 };
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+    {
+        std::string batch = makeBatch(sizes[s]);
+
+        size_t oldSize = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(int i = 0; i < Iterations; ++i)
+        {
+            oldSize = oldGzip(batch).size();
+        }
+        double oldMs = millisecondsSince(start) / Iterations;
+        printf("%d events, %zu bytes JSON\n", sizes[s], batch.size());
+        printf("  old gzipCompress (level 9):  %7zu bytes  ratio %5.2f  %7.3f ms\n", oldSize, static_cast<double>(batch.size()) / oldSize, oldMs);
+
+        GAGzipCompressor compressor;
+        std::vector<char> out;
+        for(int level = GAGzipCompressor::MinLevel; level <= GAGzipCompressor::MaxLevel; ++level)
+        {
+            compressor.setLevel(level);
+            // warm up the reused stream
+            compressor.compress(batch.c_str(), batch.size(), out);
+            start = std::chrono::steady_clock::now();
+            for(int i = 0; i < Iterations; ++i)
+            {
+                compressor.compress(batch.c_str(), batch.size(), out);
+            }
+            double ms = millisecondsSince(start) / Iterations;
+            printf("  level %d (reused stream):     %7zu bytes  ratio %5.2f  %7.3f ms\n", level, out.size(), static_cast<double>(batch.size()) / out.size(), ms);
+        }
+    }
+    return 0;
+}
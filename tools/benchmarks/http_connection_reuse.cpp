@@ -0,0 +1,138 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+// Wall and CPU time per event batch when every request creates its own curl
+// easy handle, against one persistent handle that shares DNS, TLS sessions and
+// connections the way GAHTTPApi does.
+//
+// Start the stand-in collector first, it answers every POST with 200:
+//
+//   openssl req -x509 -newkey rsa:2048 -nodes -subj /CN=127.0.0.1 -keyout key.pem -out cert.pem
+//   python3 tls_collector.py 18444 &
+//
+// then build and run:
+//
+//   g++ -std=c++11 -O2 http_connection_reuse.cpp -lcurl -o http_connection_reuse
+//   SIZE=20000 N=200 ./http_connection_reuse
+//
+// SIZE is the body size in bytes, N the number of batches, NOEXPECT=1 drops
+// the "Expect: 100-continue" round trip and VERBOSE=1 turns on curl logging.
+
+#include <curl/curl.h>
+#include <sys/resource.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    const char* Url = "https://127.0.0.1:18444/v2/key/events";
+    std::mutex shareMtx[CURL_LOCK_DATA_LAST];
+
+    size_t discardBody(void*, size_t size, size_t count, void*)
+    {
+        return size * count;
+    }
+
+    void lockShare(CURL*, curl_lock_data data, curl_lock_access, void*)
+    {
+        shareMtx[data].lock();
+    }
+
+    void unlockShare(CURL*, curl_lock_data data, void*)
+    {
+        shareMtx[data].unlock();
+    }
+
+    double cpuSeconds()
+    {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+
+    int envInt(const char* name, int fallback)
+    {
+        const char* value = getenv(name);
+        return value ? atoi(value) : fallback;
+    }
+
+    void setupRequest(CURL* curl, const std::vector<char>& body, curl_slist* headers)
+    {
+        curl_easy_setopt(curl, CURLOPT_URL, Url);
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        // the stand-in collector uses a self signed certificate
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.data());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.size()));
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, discardBody);
+        if(getenv("VERBOSE"))
+        {
+            curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
+        }
+    }
+}
+
+int main()
+{
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    std::vector<char> body(envInt("SIZE", 20000), 'a');
+    const int batches = envInt("N", 200);
+    curl_slist* headers = curl_slist_append(NULL, "Content-Type: application/json");
+    if(getenv("NOEXPECT"))
+    {
+        headers = curl_slist_append(headers, "Expect:");
+    }
+
+    for(int reuse = 0; reuse < 2; ++reuse)
+    {
+        CURLSH* share = curl_share_init();
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockShare);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+        CURL* persistent = curl_easy_init();
+
+        double cpuStart = cpuSeconds();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(int i = 0; i < batches; ++i)
+        {
+            CURL* curl = reuse ? persistent : curl_easy_init();
+            if(reuse)
+            {
+                curl_easy_reset(curl);
+                curl_easy_setopt(curl, CURLOPT_SHARE, share);
+                curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+            }
+            setupRequest(curl, body, headers);
+            CURLcode result = curl_easy_perform(curl);
+            if(result != CURLE_OK)
+            {
+                fprintf(stderr, "request failed: %s\n", curl_easy_strerror(result));
+                return 1;
+            }
+            if(!reuse)
+            {
+                curl_easy_cleanup(curl);
+            }
+        }
+        double wallUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / batches;
+        double cpuUs = (cpuSeconds() - cpuStart) * 1e6 / batches;
+        printf("%-26s %8.0f us/batch %8.0f us cpu/batch\n", reuse ? "persistent handle + share" : "handle per request", wallUs, cpuUs);
+
+        curl_easy_cleanup(persistent);
+        curl_share_cleanup(share);
+    }
+
+    curl_slist_free_all(headers);
+    curl_global_cleanup();
+    return 0;
+}
@@ -0,0 +1,68 @@
+#!/usr/bin/python3
+#
+# Stand-in collector for the benchmarks: a keep-alive HTTPS server on
+# 127.0.0.1 that reads each request and answers 200 {"status":"ok"}.
+#
+# usage: tls_collector.py PORT [cert.pem key.pem]
+
+import socket
+import ssl
+import sys
+import threading
+
+RESPONSE_BODY = b'{"status":"ok"}'
+
+
+def read_until(connection, buf, done):
+    while not done(buf):
+        data = connection.recv(65536)
+        if not data:
+            return None
+        buf += data
+    return buf
+
+
+def serve(client, context):
+    client.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    try:
+        connection = context.wrap_socket(client, server_side=True)
+        buf = b''
+        while True:
+            buf = read_until(connection, buf, lambda b: b'\r\n\r\n' in b)
+            if buf is None:
+                return
+            head, buf = buf.split(b'\r\n\r\n', 1)
+            length = 0
+            for line in head.split(b'\r\n'):
+                lower = line.lower()
+                if lower.startswith(b'content-length:'):
+                    length = int(line.split(b':')[1])
+                elif lower.startswith(b'expect:') and b'100' in line:
+                    connection.sendall(b'HTTP/1.1 100 Continue\r\n\r\n')
+            buf = read_until(connection, buf, lambda b: len(b) >= length)
+            if buf is None:
+                return
+            buf = buf[length:]
+            connection.sendall(b'HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: %d\r\n\r\n%s' % (len(RESPONSE_BODY), RESPONSE_BODY))
+    except (OSError, ssl.SSLError):
+        pass
+
+
+def main():
+    port = int(sys.argv[1])
+    cert = sys.argv[2] if len(sys.argv) > 2 else 'cert.pem'
+    key = sys.argv[3] if len(sys.argv) > 3 else 'key.pem'
+
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    context.load_cert_chain(cert, key)
+    listener = socket.socket()
+    listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    listener.bind(('127.0.0.1', port))
+    listener.listen(64)
+    while True:
+        client, _ = listener.accept()
+        threading.Thread(target=serve, args=(client, context), daemon=True).start()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,130 @@
+#!/usr/bin/python
+#
+# Turns the "module+0xoffset" frames of a crash reported by the SDK into
+# function names and source lines, using the symbols of the build that crashed.
+#
+# usage: symbolicate.py [--symbols DIR]... [--tool addr2line|atos|llvm-symbolizer] [crash.txt]
+#
+# The crash message is read from the file or from stdin. Frames without a
+# module are printed as they are.
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+FRAME_PATTERN = re.compile(r'^(\s*\d+) - (\S+)\+0x([0-9a-fA-F]+)\s*$')
+DEFAULT_MACHO_LOAD_ADDRESS = 0x100000000
+
+
+def find_symbols(name, symbol_dirs):
+    base = os.path.basename(name)
+    stem = os.path.splitext(base)[0]
+    for directory in symbol_dirs:
+        candidates = [
+            os.path.join(directory, base + '.dSYM', 'Contents', 'Resources', 'DWARF', base),
+            os.path.join(directory, base + '.debug'),
+            os.path.join(directory, stem + '.pdb'),
+            os.path.join(directory, base),
+        ]
+        for candidate in candidates:
+            if os.path.isfile(candidate):
+                return candidate
+    return None
+
+
+def default_tool():
+    if sys.platform == 'darwin':
+        return 'atos'
+    if sys.platform.startswith('win'):
+        return 'llvm-symbolizer'
+    return 'addr2line'
+
+
+def pairs(parts):
+    return ' / '.join('%s (%s)' % (parts[i], parts[i + 1]) for i in range(0, len(parts) - 1, 2))
+
+
+def symbolize(tool, module, symbols, offsets, load_address):
+    result = {}
+    if tool == 'addr2line':
+        # prints "function\nfile:line" per offset and more pairs when inlined,
+        # so one offset at a time to keep them apart
+        for offset in offsets:
+            try:
+                output = subprocess.check_output(['addr2line', '-f', '-C', '-i', '-e', symbols, '0x%x' % offset], universal_newlines=True)
+            except (OSError, subprocess.CalledProcessError) as e:
+                sys.stderr.write('addr2line failed for %s: %s\n' % (module, e))
+                return result
+            result[offset] = pairs([p.strip() for p in output.splitlines()])
+        return result
+
+    if tool == 'atos':
+        if load_address is None:
+            load_address = 0 if module.endswith('.dylib') else DEFAULT_MACHO_LOAD_ADDRESS
+        command = ['atos', '-o', symbols, '-l', '0x%x' % load_address] + ['0x%x' % (load_address + o) for o in offsets]
+    else:
+        command = ['llvm-symbolizer', '--obj=' + symbols, '--demangle']
+        if module.lower().endswith(('.exe', '.dll')):
+            # offsets are from the image base, not the preferred load address
+            command.append('--relative-address')
+        command += ['0x%x' % o for o in offsets]
+
+    try:
+        output = subprocess.check_output(command, universal_newlines=True)
+    except (OSError, subprocess.CalledProcessError) as e:
+        sys.stderr.write('%s failed for %s: %s\n' % (tool, module, e))
+        return {}
+
+    if tool == 'atos':
+        for offset, line in zip(offsets, output.splitlines()):
+            result[offset] = line.strip()
+    else:
+        # one block of "function\nfile:line" pairs per offset, separated by empty lines
+        for offset, block in zip(offsets, output.strip().split('\n\n')):
+            result[offset] = pairs([p.strip() for p in block.splitlines()])
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Symbolicate a GameAnalytics crash report.')
+    parser.add_argument('--symbols', action='append', default=[], help='directory with the binaries or debug files of the build, can be repeated')
+    parser.add_argument('--tool', choices=['addr2line', 'atos', 'llvm-symbolizer'], default=default_tool())
+    parser.add_argument('--load-address', type=lambda v: int(v, 0), default=None, help='atos only, load address the offsets are relative to')
+    parser.add_argument('report', nargs='?', help='file with the crash message, stdin if left out')
+    args = parser.parse_args()
+
+    symbol_dirs = args.symbols or ['.']
+    if args.report:
+        with open(args.report) as f:
+            lines = f.read().splitlines()
+    else:
+        lines = sys.stdin.read().splitlines()
+
+    frames = {}
+    for line in lines:
+        match = FRAME_PATTERN.match(line)
+        if match:
+            frames.setdefault(match.group(2), set()).add(int(match.group(3), 16))
+
+    resolved = {}
+    for module, offsets in frames.items():
+        symbols = find_symbols(module, symbol_dirs)
+        if not symbols:
+            sys.stderr.write('no symbols found for %s\n' % module)
+            continue
+        for offset, name in symbolize(args.tool, module, symbols, sorted(offsets), args.load_address).items():
+            resolved[(module, offset)] = name
+
+    for line in lines:
+        match = FRAME_PATTERN.match(line)
+        name = resolved.get((match.group(2), int(match.group(3), 16))) if match else None
+        if name:
+            print('%s - %s+0x%s  %s' % (match.group(1), match.group(2), match.group(3), name))
+        else:
+            print(line)
+
+
+if __name__ == '__main__':
+    main()